@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+
+namespace MM {
+namespace Reflection {
+namespace Benchmark {
+/**
+ * \brief Prevent the compiler from optimizing away \ref value.
+ */
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/**
+ * \brief Run \ref function \ref iterations times.
+ * \return Returns the average nanoseconds of one iteration.
+ */
+template <typename Function>
+double MeasureNanoseconds(std::size_t iterations, Function&& function) {
+  const auto begin = std::chrono::steady_clock::now();
+  for (std::size_t index = 0; index != iterations; ++index) {
+    function();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - begin).count() /
+         static_cast<double>(iterations);
+}
+
+/**
+ * \brief The number of global operator new calls.
+ * \remark It only counts when the benchmark defines
+ * MM_REFLECTION_BENCHMARK_COUNT_ALLOCATIONS before including this file.
+ */
+inline std::atomic<std::size_t>& GetAllocationCount() {
+  static std::atomic<std::size_t> allocation_count{0};
+  return allocation_count;
+}
+
+/**
+ * \brief Run \ref function \ref iterations times.
+ * \return Returns the average global operator new calls of one iteration.
+ */
+template <typename Function>
+double MeasureAllocations(std::size_t iterations, Function&& function) {
+  const std::size_t begin = GetAllocationCount().load();
+  for (std::size_t index = 0; index != iterations; ++index) {
+    function();
+  }
+  const std::size_t end = GetAllocationCount().load();
+
+  return static_cast<double>(end - begin) / static_cast<double>(iterations);
+}
+
+inline void PrintResult(const std::string& name, double nanoseconds,
+                        const std::string& extra = std::string{}) {
+  std::cout << std::left << std::setw(48) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(2)
+            << nanoseconds << " ns/op";
+  if (!extra.empty()) {
+    std::cout << "  " << extra;
+  }
+  std::cout << std::endl;
+}
+
+inline void PrintAllocations(const std::string& name, double allocations) {
+  std::cout << std::left << std::setw(48) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(2)
+            << allocations << " allocations/op" << std::endl;
+}
+}  // namespace Benchmark
+}  // namespace Reflection
+}  // namespace MM
+
+#ifdef MM_REFLECTION_BENCHMARK_COUNT_ALLOCATIONS
+void* operator new(std::size_t size) {
+  ++MM::Reflection::Benchmark::GetAllocationCount();
+  if (void* result = std::malloc(size == 0 ? 1 : size)) {
+    return result;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* address) noexcept { std::free(address); }
+
+void operator delete(void* address, std::size_t) noexcept {
+  std::free(address);
+}
+#endif
@@ -0,0 +1,105 @@
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "reflection.h"
+
+using namespace MM::Reflection;
+
+struct MethodBenchmarkClass {
+  int Add0() { return 0; }
+  int Add3(int arg1, int arg2, int arg3) { return arg1 + arg2 + arg3; }
+  int Add8(int arg1, int arg2, int arg3, int arg4, int arg5, int arg6, int arg7,
+           int arg8) {
+    return arg1 + arg2 + arg3 + arg4 + arg5 + arg6 + arg7 + arg8;
+  }
+  int Add12(int arg1, int arg2, int arg3, int arg4, int arg5, int arg6,
+            int arg7, int arg8, int arg9, int arg10, int arg11, int arg12) {
+    return arg1 + arg2 + arg3 + arg4 + arg5 + arg6 + arg7 + arg8 + arg9 +
+           arg10 + arg11 + arg12;
+  }
+  std::string GetName() const { return name_; }
+
+  std::string name_{"benchmark"};
+};
+
+MM_REGISTER {
+  Class<MethodBenchmarkClass>{"MethodBenchmarkClass"}
+    .Method("Add0", &MethodBenchmarkClass::Add0)
+    .Method("Add3", &MethodBenchmarkClass::Add3)
+    .Method("Add8", &MethodBenchmarkClass::Add8)
+    .Method("Add12", &MethodBenchmarkClass::Add12)
+    .Method("GetName", &MethodBenchmarkClass::GetName);
+}
+
+int main() {
+  constexpr std::size_t iterations = 1000000;
+  Variable instance = Variable::CreateVariable(MethodBenchmarkClass{});
+  Variable a1 = Variable::CreateVariable<int>(1), a2 = Variable::CreateVariable<int>(2),
+           a3 = Variable::CreateVariable<int>(3), a4 = Variable::CreateVariable<int>(4),
+           a5 = Variable::CreateVariable<int>(5), a6 = Variable::CreateVariable<int>(6),
+           a7 = Variable::CreateVariable<int>(7), a8 = Variable::CreateVariable<int>(8),
+           a9 = Variable::CreateVariable<int>(9), a10 = Variable::CreateVariable<int>(10),
+           a11 = Variable::CreateVariable<int>(11), a12 = Variable::CreateVariable<int>(12);
+  Variable* args[] = {&a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8, &a9, &a10, &a11, &a12};
+  const Meta* meta = Type::CreateType<MethodBenchmarkClass>().GetMeta();
+  const Method* add0 = meta->GetMethod("Add0");
+  const Method* add3 = meta->GetMethod("Add3");
+  const Method* add8 = meta->GetMethod("Add8");
+  const Method* add12 = meta->GetMethod("Add12");
+  const Method* get_name = meta->GetMethod("GetName");
+  const MethodHandle add3_handle = add3->Bind();
+  Variable name_result = Variable::CreateVariable(std::string{});
+  alignas(std::max_align_t) char name_storage[64];
+
+  Benchmark::PrintResult("Method::Invoke/0 args/fixed", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add0->Invoke(instance));
+  }));
+  Benchmark::PrintResult("Method::Invoke/0 args/span", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add0->Invoke(instance, args, 0));
+  }));
+  Benchmark::PrintResult("Method::Invoke/3 args/fixed", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add3->Invoke(instance, a1, a2, a3));
+  }));
+  Benchmark::PrintResult("Method::Invoke/3 args/vector", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add3->Invoke(instance, std::vector<Variable*>{&a1, &a2, &a3}));
+  }));
+  Benchmark::PrintResult("Method::Invoke/3 args/span", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add3->Invoke(instance, args, 3));
+  }));
+  Benchmark::PrintResult("MethodHandle::Invoke/3 args", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add3_handle.Invoke(instance, args, 3));
+  }));
+  Benchmark::PrintResult("MethodHandle::InvokeUnchecked/3 args", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add3_handle.InvokeUnchecked(instance, args));
+  }));
+  Benchmark::PrintResult("Method::Invoke/8 args/vector", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add8->Invoke(instance, std::vector<Variable*>{args, args + 8}));
+  }));
+  Benchmark::PrintResult("Method::Invoke/8 args/variadic", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add8->Invoke(instance, a1, a2, a3, a4, a5, a6, a7, a8));
+  }));
+  Benchmark::PrintResult("Method::Invoke/8 args/span", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add8->Invoke(instance, args, 8));
+  }));
+  Benchmark::PrintResult("Method::Invoke/12 args/vector", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add12->Invoke(instance, std::vector<Variable*>{args, args + 12}));
+  }));
+  Benchmark::PrintResult("Method::Invoke/12 args/variadic", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add12->Invoke(instance, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12));
+  }));
+  Benchmark::PrintResult("Method::Invoke/12 args/span", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(add12->Invoke(instance, args, 12));
+  }));
+  Benchmark::PrintResult("Method::Invoke/std::string result", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(get_name->Invoke(instance));
+  }));
+  Benchmark::PrintResult("Method::InvokeInto/std::string result/variable", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(get_name->InvokeInto(name_result, instance));
+  }));
+  Benchmark::PrintResult("Method::InvokeInto/std::string result/storage", Benchmark::MeasureNanoseconds(iterations, [&]() {
+    Benchmark::DoNotOptimize(get_name->InvokeInto(static_cast<void*>(name_storage), instance));
+  }));
+
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include <string>
+
+#include "benchmark_utils.h"
+#include "reflection.h"
+
+using namespace MM::Reflection;
+
+struct PropertyAccessorBenchmarkClass {
+  int property1_{10};
+  std::string property2_{"string"};
+};
+
+MM_REGISTER {
+  Class<PropertyAccessorBenchmarkClass>{"PropertyAccessorBenchmarkClass"}
+    .Property("property1_", &PropertyAccessorBenchmarkClass::property1_)
+    .Property("property2_", &PropertyAccessorBenchmarkClass::property2_);
+}
+
+int main() {
+  constexpr std::size_t iterations = 10000000;
+  Variable object_variable = Variable::CreateVariable(PropertyAccessorBenchmarkClass{});
+  PropertyAccessorBenchmarkClass object{};
+  const Meta* meta = Type::CreateType<PropertyAccessorBenchmarkClass>().GetMeta();
+  const Property* property1 = meta->GetProperty("property1_");
+  const PropertyAccessor<int> property1_accessor = property1->MakeAccessor<int>();
+
+  Benchmark::PrintResult("Variable::GetPropertyVariable/get", Benchmark::MeasureNanoseconds(iterations, [&object_variable]() {
+    Benchmark::DoNotOptimize(object_variable.GetPropertyVariable("property1_").GetValueCast<int>());
+  }));
+  Benchmark::PrintResult("Variable::GetPropertyVariable/set", Benchmark::MeasureNanoseconds(iterations, [&object_variable]() {
+    object_variable.GetPropertyVariable("property1_").GetValueCast<int>() = 20;
+  }));
+  Benchmark::PrintResult("PropertyAccessor::Get/variable", Benchmark::MeasureNanoseconds(iterations, [&object_variable, &property1_accessor]() {
+    Benchmark::DoNotOptimize(property1_accessor.Get(object_variable));
+  }));
+  Benchmark::PrintResult("PropertyAccessor::Get/pointer", Benchmark::MeasureNanoseconds(iterations, [&object, &property1_accessor]() {
+    Benchmark::DoNotOptimize(property1_accessor.Get(&object));
+  }));
+  Benchmark::PrintResult("PropertyAccessor::Set/pointer", Benchmark::MeasureNanoseconds(iterations, [&object, &property1_accessor]() {
+    property1_accessor.Set(&object, 20);
+  }));
+  Benchmark::PrintResult("Property::MakeAccessor", Benchmark::MeasureNanoseconds(iterations / 10, [property1]() {
+    Benchmark::DoNotOptimize(property1->MakeAccessor<int>());
+  }));
+
+  return 0;
+}
@@ -0,0 +1,475 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "reflection.h"
+
+using namespace MM::Reflection;
+
+template <typename T>
+T GetEmptyObject() {
+  return T{};
+}
+
+struct SerializerBenchmarkPoint {
+  float x_{1.0f};
+  float y_{2.0f};
+  float z_{3.0f};
+};
+
+struct SerializerBenchmarkTransform {
+  SerializerBenchmarkPoint position_{};
+  SerializerBenchmarkPoint rotation_{};
+  SerializerBenchmarkPoint scale_{};
+  int parent_{0};
+};
+
+struct SerializerBenchmarkClass {
+  SerializerBenchmarkTransform transform1_{};
+  SerializerBenchmarkTransform transform2_{};
+  double weight_{0.5};
+  std::uint64_t id_{42};
+};
+
+// Each level points 4 times to one object of the level below, so a tree walk
+// reaches the same SerializerBenchmarkClass 64 times.
+struct SerializerBenchmarkSharedNode1 {
+  SerializerBenchmarkClass* children_[4]{};
+};
+
+struct SerializerBenchmarkSharedNode2 {
+  SerializerBenchmarkSharedNode1* children_[4]{};
+};
+
+struct SerializerBenchmarkSharedNode3 {
+  SerializerBenchmarkSharedNode2* children_[4]{};
+};
+
+MM_REGISTER {
+  Class<SerializerBenchmarkPoint>{"SerializerBenchmarkPoint"}
+      .Property("x_", &SerializerBenchmarkPoint::x_)
+      .Property("y_", &SerializerBenchmarkPoint::y_)
+      .Property("z_", &SerializerBenchmarkPoint::z_)
+      .Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<SerializerBenchmarkPoint>)
+      .SetSerializerName(UnsefeRecursionSerializer::GetSerializerNameStatic());
+  Class<SerializerBenchmarkTransform>{"SerializerBenchmarkTransform"}
+      .Property("position_", &SerializerBenchmarkTransform::position_)
+      .Property("rotation_", &SerializerBenchmarkTransform::rotation_)
+      .Property("scale_", &SerializerBenchmarkTransform::scale_)
+      .Property("parent_", &SerializerBenchmarkTransform::parent_)
+      .Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<SerializerBenchmarkTransform>)
+      .SetSerializerName(UnsefeRecursionSerializer::GetSerializerNameStatic());
+  Class<SerializerBenchmarkClass>{"SerializerBenchmarkClass"}
+      .Property("transform1_", &SerializerBenchmarkClass::transform1_)
+      .Property("transform2_", &SerializerBenchmarkClass::transform2_)
+      .Property("weight_", &SerializerBenchmarkClass::weight_)
+      .Property("id_", &SerializerBenchmarkClass::id_)
+      .Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<SerializerBenchmarkClass>)
+      .SetSerializerName(UnsefeRecursionSerializer::GetSerializerNameStatic());
+  Class<SerializerBenchmarkSharedNode1>{"SerializerBenchmarkSharedNode1"}
+      .Property("child0_", RefrencePropertyDescriptor<SerializerBenchmarkClass>{0 * sizeof(void*)})
+      .Property("child1_", RefrencePropertyDescriptor<SerializerBenchmarkClass>{1 * sizeof(void*)})
+      .Property("child2_", RefrencePropertyDescriptor<SerializerBenchmarkClass>{2 * sizeof(void*)})
+      .Property("child3_", RefrencePropertyDescriptor<SerializerBenchmarkClass>{3 * sizeof(void*)})
+      .Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<SerializerBenchmarkSharedNode1>)
+      .SetSerializerName(UnsefeRecursionSerializer::GetSerializerNameStatic());
+  Class<SerializerBenchmarkSharedNode2>{"SerializerBenchmarkSharedNode2"}
+      .Property("child0_", RefrencePropertyDescriptor<SerializerBenchmarkSharedNode1>{0 * sizeof(void*)})
+      .Property("child1_", RefrencePropertyDescriptor<SerializerBenchmarkSharedNode1>{1 * sizeof(void*)})
+      .Property("child2_", RefrencePropertyDescriptor<SerializerBenchmarkSharedNode1>{2 * sizeof(void*)})
+      .Property("child3_", RefrencePropertyDescriptor<SerializerBenchmarkSharedNode1>{3 * sizeof(void*)})
+      .Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<SerializerBenchmarkSharedNode2>)
+      .SetSerializerName(UnsefeRecursionSerializer::GetSerializerNameStatic());
+  Class<SerializerBenchmarkSharedNode3>{"SerializerBenchmarkSharedNode3"}
+      .Property("child0_", RefrencePropertyDescriptor<SerializerBenchmarkSharedNode2>{0 * sizeof(void*)})
+      .Property("child1_", RefrencePropertyDescriptor<SerializerBenchmarkSharedNode2>{1 * sizeof(void*)})
+      .Property("child2_", RefrencePropertyDescriptor<SerializerBenchmarkSharedNode2>{2 * sizeof(void*)})
+      .Property("child3_", RefrencePropertyDescriptor<SerializerBenchmarkSharedNode2>{3 * sizeof(void*)})
+      .Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<SerializerBenchmarkSharedNode3>)
+      .SetSerializerName(UnsefeRecursionSerializer::GetSerializerNameStatic());
+}
+
+int main() {
+  constexpr std::size_t iterations = 1000000;
+  SerializerBenchmarkClass object{};
+  Variable object_variable = Variable::CreateVariable(object, true);
+  DataBuffer data_buffer{};
+  Serialize(data_buffer, object_variable);
+
+  Benchmark::PrintResult("Serialize/nested structs", Benchmark::MeasureNanoseconds(iterations, [&data_buffer, &object_variable]() {
+    data_buffer.Clear();
+    Serialize(data_buffer, object_variable);
+    Benchmark::DoNotOptimize(data_buffer.GetAddDataOffset());
+  }));
+  data_buffer.Clear();
+  Serialize(data_buffer, object_variable);
+  DataBuffer read_buffer{data_buffer.GetAddDataOffset()};
+  // Reading consumes the buffer, so the data is copied back before each read.
+  Benchmark::PrintResult("Deserialize/nested structs", Benchmark::MeasureNanoseconds(iterations, [&data_buffer, &read_buffer]() {
+    read_buffer.Clear();
+    read_buffer.AddData(data_buffer.GetData(), data_buffer.GetAddDataOffset());
+    Variable result = Deserialize(read_buffer);
+    Benchmark::DoNotOptimize(result.GetValue());
+  }));
+
+  DataBuffer schema_buffer{};
+  SerializeWithSchema(schema_buffer, object_variable);
+  Benchmark::PrintResult("SerializeWithSchema/nested structs", Benchmark::MeasureNanoseconds(iterations, [&schema_buffer, &object_variable]() {
+    schema_buffer.Clear();
+    SerializeWithSchema(schema_buffer, object_variable);
+    Benchmark::DoNotOptimize(schema_buffer.GetAddDataOffset());
+  }));
+  Benchmark::PrintResult("Deserialize/schema nested structs", Benchmark::MeasureNanoseconds(iterations, [&schema_buffer, &read_buffer]() {
+    read_buffer.Clear();
+    read_buffer.AddData(schema_buffer.GetData(), schema_buffer.GetAddDataOffset());
+    Variable result = Deserialize(read_buffer);
+    Benchmark::DoNotOptimize(result.GetValue());
+  }));
+
+  // A mostly-default object: only one property differs from the empty object.
+  SerializerBenchmarkClass sparse_object{};
+  sparse_object.id_ = 7;
+  Variable sparse_variable = Variable::CreateVariable(sparse_object, true);
+  DataBuffer delta_buffer{};
+  SerializeDelta(delta_buffer, sparse_variable);
+  Benchmark::PrintResult("SerializeDelta/sparse nested structs", Benchmark::MeasureNanoseconds(iterations, [&delta_buffer, &sparse_variable]() {
+    delta_buffer.Clear();
+    SerializeDelta(delta_buffer, sparse_variable);
+    Benchmark::DoNotOptimize(delta_buffer.GetAddDataOffset());
+  }));
+  Benchmark::PrintResult("Deserialize/delta sparse nested structs", Benchmark::MeasureNanoseconds(iterations, [&delta_buffer, &read_buffer]() {
+    read_buffer.Clear();
+    read_buffer.AddData(delta_buffer.GetData(), delta_buffer.GetAddDataOffset());
+    Variable result = Deserialize(read_buffer);
+    Benchmark::DoNotOptimize(result.GetValue());
+  }));
+  std::cout << "Bytes of a sparse object: " << data_buffer.GetAddDataOffset() << " with descriptors, "
+            << delta_buffer.GetAddDataOffset() << " as a delta" << std::endl;
+
+  // The size of one object in a stream of many objects.
+  constexpr std::uint32_t object_number = 1000;
+  DataBuffer descriptor_objects{};
+  SchemaWriter schema_writer{};
+  for (std::uint32_t index = 0; index != object_number; ++index) {
+    Serialize(descriptor_objects, object_variable);
+    schema_writer.AddObject(object_variable);
+  }
+  DataBuffer schema_objects{};
+  schema_writer.Finish(schema_objects);
+  Benchmark::PrintResult("SchemaWriter/1000 nested structs, per object", Benchmark::MeasureNanoseconds(iterations / object_number, [&schema_writer, &schema_objects, &object_variable]() {
+    for (std::uint32_t index = 0; index != object_number; ++index) {
+      schema_writer.AddObject(object_variable);
+    }
+    schema_objects.Clear();
+    schema_writer.Finish(schema_objects);
+  }) / object_number);
+  DataBuffer schema_read_buffer{schema_objects.GetAddDataOffset()};
+  Benchmark::PrintResult("SchemaReader/1000 nested structs, per object", Benchmark::MeasureNanoseconds(iterations / object_number, [&schema_objects, &schema_read_buffer]() {
+    schema_read_buffer.Clear();
+    schema_read_buffer.AddData(schema_objects.GetData(), schema_objects.GetAddDataOffset());
+    SchemaReader schema_reader{schema_read_buffer};
+    while (schema_reader.HaveObject()) {
+      Variable result = schema_reader.ReadObject();
+      Benchmark::DoNotOptimize(result.GetValue());
+    }
+  }) / object_number);
+  std::cout << "Bytes per object: " << sizeof(SerializerBenchmarkClass) << " in memory, "
+            << descriptor_objects.GetAddDataOffset() / object_number << " with descriptors, "
+            << schema_objects.GetAddDataOffset() / object_number << " with a schema" << std::endl;
+
+  // Many small records of one type: one call per record against one batch.
+  constexpr std::uint64_t point_number = 1000000;
+  std::vector<SerializerBenchmarkPoint> points(point_number);
+  for (std::uint64_t index = 0; index != point_number; ++index) {
+    points[index].x_ = static_cast<float>(index);
+  }
+  const Meta& point_meta = *FindMeta(MM::Utils::GetTypeHashCode<SerializerBenchmarkPoint>());
+  DataBuffer point_buffer{};
+  Benchmark::PrintResult("Serialize/1M points, per point", Benchmark::MeasureNanoseconds(1, [&point_buffer, &points]() {
+    point_buffer.Clear();
+    for (SerializerBenchmarkPoint& point : points) {
+      Variable point_variable = Variable::CreateVariable(point, true);
+      Serialize(point_buffer, point_variable);
+    }
+  }) / point_number);
+  const std::uint64_t point_records_size = point_buffer.GetAddDataOffset();
+  Benchmark::PrintResult("SerializeBatch/1M points, per point", Benchmark::MeasureNanoseconds(10, [&point_buffer, &point_meta, &points]() {
+    point_buffer.Clear();
+    SerializeBatch(point_buffer, point_meta, points.data(), points.size());
+  }) / point_number);
+  std::vector<SerializerBenchmarkPoint> read_points(point_number);
+  Benchmark::PrintResult("DeserializeBatch/1M points, per point", Benchmark::MeasureNanoseconds(10, [&point_buffer, &point_meta, &read_points]() {
+    point_buffer.Clear();
+    point_buffer.AddEmptyData(sizeof(BatchHeader) + point_number * sizeof(SerializerBenchmarkPoint));
+    DeserializeBatch(point_buffer, point_meta, read_points.data(), read_points.size());
+  }) / point_number);
+  std::cout << "Bytes of 1M points: " << point_records_size << " with one record each, "
+            << point_buffer.GetAddDataOffset() << " as a batch" << std::endl;
+
+  // A graph with heavy sharing: every pointer is written inline by Serialize,
+  // but once by SerializeGraph.
+  SerializerBenchmarkSharedNode1 shared_node1{};
+  SerializerBenchmarkSharedNode2 shared_node2{};
+  SerializerBenchmarkSharedNode3 shared_node3{};
+  for (std::size_t index = 0; index != 4; ++index) {
+    shared_node1.children_[index] = &object;
+    shared_node2.children_[index] = &shared_node1;
+    shared_node3.children_[index] = &shared_node2;
+  }
+  Variable shared_variable = Variable::CreateVariable(shared_node3, true);
+  {
+    constexpr std::size_t graph_iterations = 100000;
+    // The deserialized objects are allocated from the arena and released after
+    // each read.
+    VariableArena graph_arena{};
+    VariableArenaScope graph_arena_scope{graph_arena};
+    DataBuffer tree_buffer{};
+    Benchmark::PrintResult("Serialize/shared graph", Benchmark::MeasureNanoseconds(graph_iterations, [&tree_buffer, &shared_variable]() {
+      tree_buffer.Clear();
+      Serialize(tree_buffer, shared_variable);
+      Benchmark::DoNotOptimize(tree_buffer.GetAddDataOffset());
+    }));
+    DataBuffer graph_read_buffer{tree_buffer.GetAddDataOffset()};
+    Benchmark::PrintResult("Deserialize/shared graph", Benchmark::MeasureNanoseconds(graph_iterations, [&tree_buffer, &graph_read_buffer, &graph_arena]() {
+      graph_read_buffer.Clear();
+      graph_read_buffer.AddData(tree_buffer.GetData(), tree_buffer.GetAddDataOffset());
+      Variable result = Deserialize(graph_read_buffer);
+      Benchmark::DoNotOptimize(result.GetValue());
+      graph_arena.Reset();
+    }));
+    DataBuffer graph_buffer{};
+    Benchmark::PrintResult("SerializeGraph/shared graph", Benchmark::MeasureNanoseconds(graph_iterations, [&graph_buffer, &shared_variable]() {
+      graph_buffer.Clear();
+      SerializeGraph(graph_buffer, shared_variable);
+      Benchmark::DoNotOptimize(graph_buffer.GetAddDataOffset());
+    }));
+    Benchmark::PrintResult("Deserialize/graph shared graph", Benchmark::MeasureNanoseconds(graph_iterations, [&graph_buffer, &graph_read_buffer, &graph_arena]() {
+      graph_read_buffer.Clear();
+      graph_read_buffer.AddData(graph_buffer.GetData(), graph_buffer.GetAddDataOffset());
+      Variable result = Deserialize(graph_read_buffer);
+      Benchmark::DoNotOptimize(result.GetValue());
+      graph_arena.Reset();
+    }));
+    std::cout << "Bytes of a shared graph: " << tree_buffer.GetAddDataOffset() << " as a tree, "
+              << graph_buffer.GetAddDataOffset() << " as a graph" << std::endl;
+  }
+
+  // Many independent objects, on one thread and on one thread per core.
+  {
+    constexpr std::uint64_t parallel_object_number = 200000;
+    const std::uint32_t core_number = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<Variable> parallel_variables{};
+    parallel_variables.reserve(parallel_object_number);
+    for (std::uint64_t index = 0; index != parallel_object_number; ++index) {
+      parallel_variables.push_back(Variable::CreateVariable(object, true));
+    }
+    std::vector<Variable> parallel_variables_deserialize(parallel_object_number);
+    DataBuffer parallel_buffer{};
+    for (const std::uint32_t thread_number : {1u, core_number}) {
+      const std::string thread_name = std::to_string(thread_number) + " threads";
+      Benchmark::PrintResult("SerializeParallel/" + thread_name + ", per object", Benchmark::MeasureNanoseconds(5, [&parallel_buffer, &parallel_variables, thread_number]() {
+        parallel_buffer.Clear();
+        SerializeParallel(parallel_buffer, parallel_variables.data(), parallel_variables.size(), thread_number);
+      }) / parallel_object_number);
+      Benchmark::PrintResult("DeserializeParallel/" + thread_name + ", per object", Benchmark::MeasureNanoseconds(5, [&parallel_buffer, &parallel_variables_deserialize, thread_number]() {
+        parallel_buffer.SetReadDataOffset(0);
+        DeserializeParallel(parallel_buffer, parallel_variables_deserialize.data(), parallel_variables_deserialize.size(), thread_number);
+        for (Variable& variable : parallel_variables_deserialize) {
+          if (variable.IsRefrenceVariable()) {
+            free(variable.GetValue());
+          }
+          variable.Destroy();
+        }
+      }) / parallel_object_number);
+    }
+  }
+
+  // Scanning archived records for two fields.
+  constexpr std::uint32_t scan_object_number = 100000;
+  DataBuffer scan_buffer{};
+  for (std::uint32_t index = 0; index != scan_object_number; ++index) {
+    Serialize(scan_buffer, object_variable);
+  }
+  // Clear keeps the data, so adding the same size back restores it.
+  const std::uint64_t scan_size = scan_buffer.GetAddDataOffset();
+  Benchmark::PrintResult("Deserialize/scan 2 fields, per record", Benchmark::MeasureNanoseconds(1, [&scan_buffer, scan_size]() {
+    scan_buffer.Clear();
+    scan_buffer.AddEmptyData(scan_size);
+    std::uint64_t id_sum = 0;
+    double weight_sum = 0.0;
+    for (std::uint32_t index = 0; index != scan_object_number; ++index) {
+      Variable result = Deserialize(scan_buffer);
+      const auto* object = static_cast<const SerializerBenchmarkClass*>(result.GetValue());
+      id_sum += object->id_;
+      weight_sum += object->weight_;
+    }
+    Benchmark::DoNotOptimize(id_sum);
+    Benchmark::DoNotOptimize(weight_sum);
+  }) / scan_object_number);
+  Benchmark::PrintResult("SerializedView/scan 2 fields, per record", Benchmark::MeasureNanoseconds(1, [&scan_buffer, scan_size]() {
+    scan_buffer.Clear();
+    scan_buffer.AddEmptyData(scan_size);
+    std::uint64_t id_sum = 0;
+    double weight_sum = 0.0;
+    for (std::uint32_t index = 0; index != scan_object_number; ++index) {
+      SerializedView view{scan_buffer};
+      std::uint64_t id{0};
+      double weight{0.0};
+      view.GetPropertyValue("id_", id);
+      view.GetPropertyValue("weight_", weight);
+      id_sum += id;
+      weight_sum += weight;
+    }
+    Benchmark::DoNotOptimize(id_sum);
+    Benchmark::DoNotOptimize(weight_sum);
+  }) / scan_object_number);
+
+  // The same scan through readers, which need no reset of the buffer, and
+  // with a reader per core over one buffer.
+  Benchmark::PrintResult("Deserialize/scan 2 fields with a DataBufferReader, per record", Benchmark::MeasureNanoseconds(1, [&scan_buffer]() {
+    DataBufferReader reader{scan_buffer.GetData(), scan_buffer.GetAddDataOffset()};
+    std::uint64_t id_sum = 0;
+    double weight_sum = 0.0;
+    for (std::uint32_t index = 0; index != scan_object_number; ++index) {
+      Variable result = Deserialize(reader);
+      const auto* object = static_cast<const SerializerBenchmarkClass*>(result.GetValue());
+      id_sum += object->id_;
+      weight_sum += object->weight_;
+    }
+    Benchmark::DoNotOptimize(id_sum);
+    Benchmark::DoNotOptimize(weight_sum);
+  }) / scan_object_number);
+  {
+    const std::uint32_t core_number = std::max(1u, std::thread::hardware_concurrency());
+    Benchmark::PrintResult("Deserialize/" + std::to_string(core_number) + " readers over one buffer, per record", Benchmark::MeasureNanoseconds(1, [&scan_buffer, core_number]() {
+      std::vector<std::thread> threads{};
+      for (std::uint32_t thread_index = 0; thread_index != core_number; ++thread_index) {
+        threads.emplace_back([&scan_buffer, thread_index, core_number]() {
+          const std::uint64_t record_size = scan_buffer.GetAddDataOffset() / scan_object_number;
+          const std::uint64_t begin = scan_object_number * thread_index / core_number;
+          const std::uint64_t end = scan_object_number * (thread_index + 1) / core_number;
+          DataBufferReader reader{static_cast<const std::uint8_t*>(scan_buffer.GetData()) + begin * record_size, (end - begin) * record_size};
+          for (std::uint64_t index = begin; index != end; ++index) {
+            Variable result = Deserialize(reader);
+            Benchmark::DoNotOptimize(result.GetValue());
+          }
+        });
+      }
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+    }) / scan_object_number);
+  }
+
+  // Loading an archive: copying it in against mapping it.
+  constexpr std::uint64_t archive_size = 256 * 1024 * 1024;
+  {
+    DataBuffer archive{archive_size};
+    archive.AddEmptyData(archive_size);
+    memset(archive.GetData(), 1, archive_size);
+    archive.WriteToFile("./serializer_benchmark_archive.bin");
+  }
+  Benchmark::PrintResult("DataBuffer::LoadFromFile/256 MB", Benchmark::MeasureNanoseconds(5, []() {
+    DataBuffer archive{};
+    archive.LoadFromFile("./serializer_benchmark_archive.bin");
+    Benchmark::DoNotOptimize(archive.GetData());
+  }));
+  Benchmark::PrintResult("DataBuffer::MapFile/256 MB", Benchmark::MeasureNanoseconds(5, []() {
+    DataBuffer archive{};
+    archive.MapFile("./serializer_benchmark_archive.bin");
+    Benchmark::DoNotOptimize(archive.GetData());
+  }));
+  std::remove("./serializer_benchmark_archive.bin");
+
+  // Fetching one record of a 1M records archive: walking from the start
+  // against looking it up in the index of a record store.
+  constexpr std::uint64_t record_number = 1000000;
+  {
+    DataBuffer records = DataBuffer::CreateSegmented();
+    DataBuffer record_store = DataBuffer::CreateSegmented();
+    RecordWriter record_writer{record_store};
+    for (std::uint64_t index = 0; index != record_number; ++index) {
+      Serialize(records, object_variable);
+      record_writer.AddRecord(object_variable);
+    }
+    record_writer.Finish();
+    records.WriteToFile("./serializer_benchmark_archive.bin");
+    record_store.WriteToFile("./serializer_benchmark_records.bin");
+  }
+  Benchmark::PrintResult("Deserialize/walk to record 500000 of 1M", Benchmark::MeasureNanoseconds(1, []() {
+    DataBuffer archive{};
+    archive.MapFile("./serializer_benchmark_archive.bin");
+    for (std::uint64_t index = 0; index != record_number / 2; ++index) {
+      Variable result = Deserialize(archive);
+      Benchmark::DoNotOptimize(result.GetValue());
+    }
+  }));
+  RecordReader record_reader{};
+  Benchmark::PrintResult("RecordReader::Open/1M records", Benchmark::MeasureNanoseconds(1, [&record_reader]() {
+    record_reader.Open("./serializer_benchmark_records.bin");
+  }));
+  std::uint64_t record_index = 0;
+  Benchmark::PrintResult("RecordReader::ReadRecord/random of 1M", Benchmark::MeasureNanoseconds(100000, [&record_reader, &record_index]() {
+    record_index = (record_index + 7919 * 127) % record_number;
+    Variable result = record_reader.ReadRecord(record_index);
+    Benchmark::DoNotOptimize(result.GetValue());
+  }));
+  record_reader = RecordReader{};
+  std::remove("./serializer_benchmark_archive.bin");
+  std::remove("./serializer_benchmark_records.bin");
+
+  // Writing 1 GB of objects: a buffer that moves its data to a larger
+  // allocation when it grows against one that adds segments.
+  constexpr std::uint64_t large_archive_size = 1024 * 1024 * 1024;
+  const std::uint64_t large_object_number =
+      large_archive_size / descriptor_objects.GetAddDataOffset() * object_number;
+  std::uint64_t contiguous_capacity = 0;
+  Benchmark::PrintResult("Serialize and WriteToFile/1 GB contiguous", Benchmark::MeasureNanoseconds(1, [&object_variable, &contiguous_capacity, large_object_number]() {
+    DataBuffer archive{};
+    for (std::uint64_t index = 0; index != large_object_number; ++index) {
+      Serialize(archive, object_variable);
+    }
+    archive.WriteToFile("./serializer_benchmark_archive.bin");
+    contiguous_capacity = archive.GetCapacity();
+  }));
+  std::uint64_t segmented_capacity = 0;
+  Benchmark::PrintResult("Serialize and WriteToFile/1 GB segmented", Benchmark::MeasureNanoseconds(1, [&object_variable, &segmented_capacity, large_object_number]() {
+    DataBuffer archive = DataBuffer::CreateSegmented();
+    for (std::uint64_t index = 0; index != large_object_number; ++index) {
+      Serialize(archive, object_variable);
+    }
+    archive.WriteToFile("./serializer_benchmark_archive.bin");
+    segmented_capacity = archive.GetCapacity();
+  }));
+  std::uint64_t stream_capacity = 0;
+  Benchmark::PrintResult("Serialize to a stream/1 GB", Benchmark::MeasureNanoseconds(1, [&object_variable, &stream_capacity, large_object_number]() {
+    std::ofstream file{"./serializer_benchmark_archive.bin", std::ios::binary | std::ios::trunc};
+    DataBuffer archive = DataBuffer::CreateWriteStream(std::make_unique<OStreamSink>(file));
+    for (std::uint64_t index = 0; index != large_object_number; ++index) {
+      Serialize(archive, object_variable);
+    }
+    archive.Flush();
+    stream_capacity = archive.GetCapacity();
+  }));
+  Benchmark::PrintResult("Deserialize from a stream/1 GB", Benchmark::MeasureNanoseconds(1, [large_object_number]() {
+    std::ifstream file{"./serializer_benchmark_archive.bin", std::ios::binary};
+    DataBuffer archive = DataBuffer::CreateReadStream(std::make_unique<IStreamSource>(file));
+    for (std::uint64_t index = 0; index != large_object_number; ++index) {
+      Variable result = Deserialize(archive);
+      Benchmark::DoNotOptimize(result.GetValue());
+    }
+  }));
+  std::remove("./serializer_benchmark_archive.bin");
+  // The contiguous buffer also holds the old and the new allocation at once
+  // while it grows.
+  std::cout << "Capacity for 1 GB: " << contiguous_capacity / (1024 * 1024) << " MB contiguous, "
+            << segmented_capacity / (1024 * 1024) << " MB segmented, "
+            << stream_capacity / 1024 << " KB stream" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+#include <string>
+#include <typeinfo>
+
+#include "benchmark_utils.h"
+#include "reflection.h"
+
+using namespace MM::Reflection;
+
+struct TypeBenchmarkClass {
+  int property1_{10};
+  std::string property2_{"string"};
+};
+
+TypeDatabase& GetBaselineTypeDatabase() {
+  static TypeDatabase baseline_type_database{};
+
+  return baseline_type_database;
+}
+
+// Type::CreateType before its result was cached: the ID is built from typeid
+// and looked up in a type database on every call, and a miss creates the type.
+// It has a database of its own, since the IDs of the type database are no
+// longer typeid hash codes.
+template <typename TypeName>
+const Type& CreateTypeBaseline() {
+  constexpr bool is_top_const = std::is_const_v<TypeName>;
+  constexpr bool is_low_const = (std::is_pointer_v<TypeName> ? std::is_const_v<std::remove_pointer_t<TypeName>> : false) ||
+                                (std::is_reference_v<TypeName> ? std::is_const_v<std::remove_reference_t<TypeName>> : false);
+  constexpr bool is_l_reference = std::is_lvalue_reference_v<TypeName>;
+  constexpr bool is_r_reference = std::is_rvalue_reference_v<TypeName>;
+  TypeID type_id{typeid(TypeName).hash_code(), is_top_const, is_low_const, is_l_reference, is_r_reference};
+  const Type* type = GetBaselineTypeDatabase().Find(type_id);
+  if (type != nullptr) {
+    return *type;
+  }
+  return *GetBaselineTypeDatabase().Insert(type_id, new Type{new TypeWrapper<TypeName>{}});
+}
+
+int main() {
+  constexpr std::size_t iterations = 10000000;
+  Variable int_variable = Variable::CreateVariable<int>(10);
+  Variable class_variable = Variable::CreateVariable(TypeBenchmarkClass{});
+
+  Benchmark::PrintResult("Type::CreateType<int>", Benchmark::MeasureNanoseconds(iterations, []() {
+    Benchmark::DoNotOptimize(&Type::CreateType<int>());
+  }));
+  Benchmark::PrintResult("Type::CreateType<const TypeBenchmarkClass&>", Benchmark::MeasureNanoseconds(iterations, []() {
+    Benchmark::DoNotOptimize(&Type::CreateType<const TypeBenchmarkClass&>());
+  }));
+  Benchmark::PrintResult("Type::CreateType<int>/uncached baseline", Benchmark::MeasureNanoseconds(iterations, []() {
+    Benchmark::DoNotOptimize(&CreateTypeBaseline<int>());
+  }));
+  Benchmark::PrintResult("Type::CreateType<const TypeBenchmarkClass&>/uncached baseline", Benchmark::MeasureNanoseconds(iterations, []() {
+    Benchmark::DoNotOptimize(&CreateTypeBaseline<const TypeBenchmarkClass&>());
+  }));
+  Benchmark::PrintResult("Variable::GetType/small object", Benchmark::MeasureNanoseconds(iterations, [&int_variable]() {
+    Benchmark::DoNotOptimize(int_variable.GetType());
+  }));
+  Benchmark::PrintResult("Variable::GetType/common object", Benchmark::MeasureNanoseconds(iterations, [&class_variable]() {
+    Benchmark::DoNotOptimize(class_variable.GetType());
+  }));
+
+  // What the serializers check per field.
+  const Type* field_type = &Type::CreateType<const TypeBenchmarkClass&>();
+  Benchmark::PrintResult("Type/field trait queries", Benchmark::MeasureNanoseconds(iterations, [&field_type]() {
+    Benchmark::DoNotOptimize(field_type);
+    const bool result = field_type->IsReference() || field_type->IsPointer();
+    Benchmark::DoNotOptimize(result);
+    Benchmark::DoNotOptimize(field_type->IsTrivial());
+    Benchmark::DoNotOptimize(field_type->GetSize());
+    Benchmark::DoNotOptimize(field_type->GetOriginalTypeHashCode());
+    Benchmark::DoNotOptimize(&field_type->GetOrignalType());
+  }));
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "reflection.h"
+
+using namespace MM::Reflection;
+
+template <std::size_t Index>
+struct TypeDatabaseBenchmarkClass {
+  int property1_{static_cast<int>(Index)};
+};
+
+template <std::size_t... Indexes>
+std::vector<TypeID> CreateBenchmarkTypes(std::index_sequence<Indexes...>) {
+  return std::vector<TypeID>{Type::CreateType<TypeDatabaseBenchmarkClass<Indexes>>().GetTypeID()...};
+}
+
+template <std::size_t... Indexes>
+std::size_t GetBenchmarkTypeSizes(std::index_sequence<Indexes...>) {
+  std::size_t result = 0;
+  ((result += Type::CreateType<TypeDatabaseBenchmarkClass<Indexes>>().GetSize()), ...);
+  return result;
+}
+
+/**
+ * \brief Run \ref function \ref iterations times on each of \ref thread_number
+ * threads at the same time, and print the average time of one lookup.
+ */
+template <typename Function>
+void MeasureOnThreads(const std::string& name, std::size_t thread_number,
+                      std::size_t iterations, std::size_t lookup_number,
+                      const Function& function) {
+  std::vector<double> thread_nanoseconds(thread_number);
+  std::vector<std::thread> threads{};
+  const auto begin = std::chrono::steady_clock::now();
+  for (std::size_t thread_index = 0; thread_index != thread_number; ++thread_index) {
+    threads.emplace_back([&thread_nanoseconds, &function, iterations, lookup_number, thread_index]() {
+      thread_nanoseconds[thread_index] = Benchmark::MeasureNanoseconds(iterations, function) /
+                                         static_cast<double>(lookup_number);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  double nanoseconds = 0.0;
+  for (double thread_nanosecond : thread_nanoseconds) {
+    nanoseconds += thread_nanosecond;
+  }
+  nanoseconds /= static_cast<double>(thread_number);
+  const double seconds = std::chrono::duration<double>(end - begin).count();
+  const double lookups_per_second = static_cast<double>(thread_number * iterations * lookup_number) / seconds;
+  Benchmark::PrintResult(name + "/threads:" + std::to_string(thread_number), nanoseconds,
+                         std::to_string(static_cast<std::size_t>(lookups_per_second / 1e6)) + " M lookups/s");
+}
+
+int main() {
+  constexpr std::size_t type_number = 64;
+  constexpr std::size_t iterations = 200000;
+  // Create all types once, the benchmark measures the read path.
+  const std::vector<TypeID> type_ids = CreateBenchmarkTypes(std::make_index_sequence<type_number>{});
+
+  // 1, 2, 4, ... threads, and then the number of cores.
+  const std::size_t max_thread_number = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  std::vector<std::size_t> thread_numbers{};
+  for (std::size_t thread_number = 1; thread_number < max_thread_number; thread_number *= 2) {
+    thread_numbers.push_back(thread_number);
+  }
+  thread_numbers.push_back(max_thread_number);
+
+  // FindType reads the type database itself, CreateType is usually answered
+  // by its per-instantiation cache and does not reach the database.
+  std::cout << "Lookups of " << type_number << " types per iteration." << std::endl;
+  for (const std::size_t thread_number : thread_numbers) {
+    MeasureOnThreads("FindType", thread_number, iterations, type_number, [&type_ids]() {
+      for (const TypeID& type_id : type_ids) {
+        Benchmark::DoNotOptimize(FindType(type_id));
+      }
+    });
+  }
+  for (const std::size_t thread_number : thread_numbers) {
+    MeasureOnThreads("CreateType", thread_number, iterations, type_number, []() {
+      Benchmark::DoNotOptimize(GetBenchmarkTypeSizes(std::make_index_sequence<type_number>{}));
+    });
+  }
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+#define MM_REFLECTION_BENCHMARK_COUNT_ALLOCATIONS
+
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "reflection.h"
+
+using namespace MM::Reflection;
+
+struct Vector3 {
+  float x_{1.0f};
+  float y_{2.0f};
+  float z_{3.0f};
+};
+
+struct Transform {
+  double position_[3]{1.0, 2.0, 3.0};
+};
+
+// A mix of the property types a typical component holds.
+void CreateVariables() {
+  Variable int_variable = Variable::CreateVariable(10);
+  Variable double_variable = Variable::CreateVariable(20.0);
+  Variable vector3_variable = Variable::CreateVariable(Vector3{});
+  Variable pair_variable = Variable::CreateVariable(std::pair<double, double>{1.0, 2.0});
+  Variable vector_variable = Variable::EmplaceVariable<std::vector<int>>();
+  Variable string_variable = Variable::EmplaceVariable<std::string>("name");
+  Variable transform_variable = Variable::CreateVariable(Transform{});
+  Variable moved_string_variable{std::move(string_variable)};
+  Benchmark::DoNotOptimize(int_variable);
+  Benchmark::DoNotOptimize(double_variable);
+  Benchmark::DoNotOptimize(vector3_variable);
+  Benchmark::DoNotOptimize(pair_variable);
+  Benchmark::DoNotOptimize(vector_variable);
+  Benchmark::DoNotOptimize(moved_string_variable);
+  Benchmark::DoNotOptimize(transform_variable);
+}
+
+int main() {
+  constexpr std::size_t iterations = 1000000;
+  const std::string inline_size = "inline size: " + std::to_string(MM_REFLECTION_VARIABLE_INLINE_SIZE) + " bytes";
+  std::cout << inline_size << std::endl;
+  std::cout << "sizeof(Variable): " << sizeof(Variable) << std::endl;
+  std::cout << "inline: Vector3 " << Variable::IsSmallObject<Vector3>()
+            << ", std::pair<double, double> " << Variable::IsSmallObject<std::pair<double, double>>()
+            << ", std::vector<int> " << Variable::IsSmallObject<std::vector<int>>()
+            << ", std::string " << Variable::IsSmallObject<std::string>()
+            << ", Transform " << Variable::IsSmallObject<Transform>() << std::endl;
+
+  Benchmark::PrintResult("Variable/create property mix", Benchmark::MeasureNanoseconds(iterations, CreateVariables));
+  Benchmark::PrintAllocations("Variable/create property mix", Benchmark::MeasureAllocations(iterations / 10, CreateVariables));
+
+  // One arena per request, reset after every request of 100 property mixes.
+  VariableArena arena{};
+  std::size_t request_index = 0;
+  auto create_variables_in_arena = [&arena, &request_index]() {
+    {
+      VariableArenaScope arena_scope{arena};
+      CreateVariables();
+    }
+    if (++request_index % 100 == 0) {
+      arena.Reset();
+    }
+  };
+  Benchmark::PrintResult("Variable/create property mix (arena)", Benchmark::MeasureNanoseconds(iterations, create_variables_in_arena));
+  Benchmark::PrintAllocations("Variable/create property mix (arena)", Benchmark::MeasureAllocations(iterations / 10, create_variables_in_arena));
+
+  Variable string_variable = Variable::EmplaceVariable<std::string>("name");
+  Benchmark::PrintResult("Variable/copy std::string", Benchmark::MeasureNanoseconds(iterations, [&string_variable]() {
+    Variable copy{string_variable};
+    Benchmark::DoNotOptimize(copy);
+  }));
+
+  Variable vector_variable = Variable::EmplaceVariable<std::vector<int>>(16);
+  auto move_vector = [&vector_variable]() {
+    Variable moved{std::move(vector_variable)};
+    Benchmark::DoNotOptimize(moved);
+    vector_variable = std::move(moved);
+  };
+  Benchmark::PrintResult("Variable/move std::vector<int> and back", Benchmark::MeasureNanoseconds(iterations, move_vector));
+  Benchmark::PrintAllocations("Variable/move std::vector<int> and back", Benchmark::MeasureAllocations(iterations / 10, move_vector));
+
+  return 0;
+}
@@ -0,0 +1,227 @@
+#include "batch_serializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "serialization_plan.h"
+
+namespace {
+constexpr std::uint64_t COLUMN_PART_SIZE = 64 * 1024;
+
+// Values of 1, 2, 4 and 8 bytes are copied with fixed size copies, which the
+// compiler turns into single loads and stores.
+template <std::uint64_t ValueSize>
+void GatherColumn(std::uint8_t* column, const std::uint8_t* value,
+                  std::uint64_t stride, std::uint64_t object_number) {
+  for (std::uint64_t index = 0; index != object_number; ++index) {
+    std::memcpy(column, value, ValueSize);
+    column += ValueSize;
+    value += stride;
+  }
+}
+
+template <std::uint64_t ValueSize>
+void ScatterColumn(const std::uint8_t* column, std::uint8_t* value,
+                   std::uint64_t stride, std::uint64_t object_number) {
+  for (std::uint64_t index = 0; index != object_number; ++index) {
+    std::memcpy(value, column, ValueSize);
+    column += ValueSize;
+    value += stride;
+  }
+}
+
+void GatherColumn(std::uint8_t* column, const std::uint8_t* value,
+                  std::uint64_t value_size, std::uint64_t stride,
+                  std::uint64_t object_number) {
+  switch (value_size) {
+    case 1:
+      GatherColumn<1>(column, value, stride, object_number);
+      return;
+    case 2:
+      GatherColumn<2>(column, value, stride, object_number);
+      return;
+    case 4:
+      GatherColumn<4>(column, value, stride, object_number);
+      return;
+    case 8:
+      GatherColumn<8>(column, value, stride, object_number);
+      return;
+    default:
+      for (std::uint64_t index = 0; index != object_number; ++index) {
+        std::memcpy(column, value, value_size);
+        column += value_size;
+        value += stride;
+      }
+  }
+}
+
+void ScatterColumn(const std::uint8_t* column, std::uint8_t* value,
+                   std::uint64_t value_size, std::uint64_t stride,
+                   std::uint64_t object_number) {
+  switch (value_size) {
+    case 1:
+      ScatterColumn<1>(column, value, stride, object_number);
+      return;
+    case 2:
+      ScatterColumn<2>(column, value, stride, object_number);
+      return;
+    case 4:
+      ScatterColumn<4>(column, value, stride, object_number);
+      return;
+    case 8:
+      ScatterColumn<8>(column, value, stride, object_number);
+      return;
+    default:
+      for (std::uint64_t index = 0; index != object_number; ++index) {
+        std::memcpy(value, column, value_size);
+        column += value_size;
+        value += stride;
+      }
+  }
+}
+}  // namespace
+
+bool MM::Reflection::SerializeBatch(DataBuffer& data_buffer, const Meta& meta,
+                                    const void* objects,
+                                    std::uint64_t object_number) {
+  assert(objects != nullptr || object_number == 0);
+
+  const std::shared_ptr<const SerializationPlan> plan =
+      meta.GetSchemaSerializationPlan();
+  const std::vector<SerializationPlan::Column>& columns = plan->GetColumns();
+  if (columns.empty()) {
+    std::cerr << "[Error] [MMReflection] The type named " << meta.GetTypeName()
+              << " does not use the "
+              << TrivialSerializer::GetSerializerNameStatic() << " or "
+              << UnsefeRecursionSerializer::GetSerializerNameStatic()
+              << " serializer for all nested types, or has pointer or "
+                 "refrence properties, so it cannot be written as columns.\n";
+    return false;
+  }
+
+  BatchHeader header{};
+  header.column_number_ = static_cast<std::uint32_t>(columns.size());
+  header.type_name_hash_ = plan->GetTypeNameHash();
+  header.object_number_ = object_number;
+  header.serialized_size_ =
+      static_cast<std::uint32_t>(plan->GetSerializedSize());
+  data_buffer.AddData(&header, sizeof(BatchHeader));
+
+  const std::uint64_t stride = meta.GetType().GetSize();
+  const auto* object_bytes = static_cast<const std::uint8_t*>(objects);
+  for (const SerializationPlan::Column& column : columns) {
+    if (column.size_ == 0 || object_number == 0) {
+      continue;
+    }
+    auto* column_data = static_cast<std::uint8_t*>(
+        data_buffer.AddEmptyData(column.size_ * object_number));
+    GatherColumn(column_data, object_bytes + column.object_offset_,
+                 column.size_, stride, object_number);
+  }
+
+  return true;
+}
+
+std::uint64_t MM::Reflection::GetBatchObjectNumber(
+    const DataBuffer& data_buffer) {
+  if (!data_buffer.CanReadData(sizeof(BatchHeader))) {
+    return 0;
+  }
+  BatchHeader header{};
+  data_buffer.PeekData(&header, sizeof(BatchHeader));
+
+  return header.version_ == BATCH_SERIALIZER_VERSION ? header.object_number_
+                                                     : 0;
+}
+
+std::uint64_t MM::Reflection::DeserializeBatch(
+    const DataBuffer& data_buffer, const Meta& meta, void* objects,
+    std::uint64_t max_object_number) {
+  if (!data_buffer.CanReadData(sizeof(BatchHeader))) {
+    std::cerr << "[Error] [MMReflection] The data is too small to hold a batch "
+                 "header.\n";
+    return 0;
+  }
+  BatchHeader header{};
+  data_buffer.PeekData(&header, sizeof(BatchHeader));
+
+  const std::shared_ptr<const SerializationPlan> plan =
+      meta.GetSchemaSerializationPlan();
+  const std::vector<SerializationPlan::Column>& columns = plan->GetColumns();
+  if (header.version_ != BATCH_SERIALIZER_VERSION ||
+      header.type_name_hash_ != plan->GetTypeNameHash() ||
+      header.column_number_ != columns.size() ||
+      header.serialized_size_ != plan->GetSerializedSize()) {
+    std::cerr << "[Error] [MMReflection] The data is not a batch of the type "
+                 "named "
+              << meta.GetTypeName() << ", or the properties of the type "
+              << "changed.\n";
+    return 0;
+  }
+  if (header.object_number_ > max_object_number) {
+    std::cerr << "[Error] [MMReflection] The batch holds "
+              << header.object_number_ << " objects, but the array only holds "
+              << max_object_number << ".\n";
+    return 0;
+  }
+  data_buffer.ReadData(&header, sizeof(BatchHeader));
+
+  const std::uint64_t object_number = header.object_number_;
+  const std::uint64_t stride = meta.GetType().GetSize();
+  auto* object_bytes = static_cast<std::uint8_t*>(objects);
+  std::vector<std::uint8_t> column_part{};
+  for (const SerializationPlan::Column& column : columns) {
+    if (column.size_ == 0 || object_number == 0) {
+      continue;
+    }
+    const std::uint64_t column_size = column.size_ * object_number;
+    // Streams are not asked for the whole column in place, so their buffer
+    // does not grow to its size.
+    const auto* column_data =
+        data_buffer.IsStream() ? nullptr
+                               : static_cast<const std::uint8_t*>(
+                                     data_buffer.PeekDataInPlace(column_size));
+    if (column_data != nullptr) {
+      data_buffer.ReadDataInPlace(column_size);
+      ScatterColumn(column_data, object_bytes + column.object_offset_,
+                    column.size_, stride, object_number);
+      continue;
+    }
+
+    // Columns split between segments or read from a stream are copied out in
+    // parts.
+    const std::uint64_t part_object_number =
+        std::max<std::uint64_t>(1, COLUMN_PART_SIZE / column.size_);
+    for (std::uint64_t first_object = 0; first_object < object_number;
+         first_object += part_object_number) {
+      const std::uint64_t read_object_number =
+          std::min(part_object_number, object_number - first_object);
+      column_part.resize(read_object_number * column.size_);
+      data_buffer.ReadData(column_part.data(), column_part.size());
+      ScatterColumn(column_part.data(),
+                    object_bytes + first_object * stride + column.object_offset_,
+                    column.size_, stride, read_object_number);
+    }
+  }
+
+  return object_number;
+}
+
+std::uint64_t MM::Reflection::GetBatchObjectNumber(
+    const DataBufferReader& reader) {
+  DataBufferReader peek_reader{reader};
+  return peek_reader.ReadWithDataBuffer([](const DataBuffer& data_buffer) {
+    return GetBatchObjectNumber(data_buffer);
+  });
+}
+
+std::uint64_t MM::Reflection::DeserializeBatch(
+    DataBufferReader& reader, const Meta& meta, void* objects,
+    std::uint64_t max_object_number) {
+  return reader.ReadWithDataBuffer(
+      [&meta, objects, max_object_number](const DataBuffer& data_buffer) {
+        return DeserializeBatch(data_buffer, meta, objects, max_object_number);
+      });
+}
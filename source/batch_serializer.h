@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+#include "serializer.h"
+
+namespace MM {
+namespace Reflection {
+/**
+ * \brief The version of the streams written by \ref SerializeBatch.
+ * \remark It is in the place of \ref SerializerDescriptor::version_, so
+ * \ref Deserialize can tell these streams apart and refuse them.
+ */
+constexpr std::uint32_t BATCH_SERIALIZER_VERSION = STREAM_FORMAT_VERSION_FLAG | 4;
+
+struct BatchHeader {
+  // Same place as SerializerDescriptor::version_.
+  std::uint32_t version_{BATCH_SERIALIZER_VERSION};
+  std::uint32_t column_number_{0};
+  TypeHashCode type_name_hash_{0};
+  std::uint64_t object_number_{0};
+  // The size of the data of one object, to check that the layout of the type
+  // did not change.
+  std::uint32_t serialized_size_{0};
+  std::uint32_t reserved_{0};
+};
+
+/**
+ * \brief Write \ref object_number objects of the type of \ref meta as columns.
+ * \param objects The address of an array of \ref object_number objects.
+ * \return Returns false if the type cannot be written as columns. Then nothing
+ * is written.
+ * \remark The stream is a \ref BatchHeader and then one column per value of
+ * the type (see \ref SerializationPlan::GetColumns), holding that value of
+ * every object one after another.
+ * \remark Only types that use the \ref TrivialSerializer or the
+ * \ref UnsefeRecursionSerializer (for all nested types), and have no pointer
+ * or refrence properties, can be written.
+ */
+bool SerializeBatch(DataBuffer& data_buffer, const Meta& meta,
+                    const void* objects, std::uint64_t object_number);
+
+/**
+ * \brief Get the number of objects of the batch at the read position of
+ * \ref data_buffer, without reading it.
+ * \return Returns 0 if there is no batch.
+ */
+std::uint64_t GetBatchObjectNumber(const DataBuffer& data_buffer);
+
+std::uint64_t GetBatchObjectNumber(const DataBufferReader& reader);
+
+/**
+ * \brief Read a batch written by \ref SerializeBatch into an array.
+ * \param objects The address of an array of at least \ref max_object_number
+ * objects of the type of \ref meta. The values are written to the objects, so
+ * they must already be constructed.
+ * \return Returns the number of objects read. Returns 0 without reading
+ * anything if the batch does not match \ref meta or has more objects than
+ * \ref max_object_number.
+ */
+std::uint64_t DeserializeBatch(const DataBuffer& data_buffer, const Meta& meta,
+                               void* objects, std::uint64_t max_object_number);
+
+std::uint64_t DeserializeBatch(DataBufferReader& reader, const Meta& meta,
+                               void* objects, std::uint64_t max_object_number);
+}  // namespace Reflection
+}  // namespace MM
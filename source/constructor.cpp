@@ -4,6 +4,8 @@
 
 #include "constructor.h"
 
+#include <algorithm>
+
 MM::Reflection::Variable MM::Reflection::Constructor::empty_variable{};
 
 const std::string& MM::Reflection::Constructor::GetConstructorName() const {
@@ -260,6 +262,48 @@ MM::Reflection::Variable MM::Reflection::Constructor::Invoke(
   return Invoke(placement_address, args);
 }
 
+MM::Reflection::Variable MM::Reflection::Constructor::Invoke(
+    Variable* const* args, std::size_t argument_number) const {
+  if (!IsValid()) {
+    return Variable{};
+  }
+
+  return common_constructor_wrapper_->Invoke(empty_variable, args,
+                                             argument_number);
+}
+
+MM::Reflection::Variable MM::Reflection::Constructor::Invoke(
+    void* placement_address, Variable* const* args,
+    std::size_t argument_number) const {
+  if (!IsValid()) {
+    return Variable{};
+  }
+
+  Variable address_variable = Variable::CreateVariable(placement_address);
+  if (argument_number < PLACEMENT_INLINE_ARGUMENT_NUMBER) {
+    std::array<Variable*, PLACEMENT_INLINE_ARGUMENT_NUMBER> placement_args{&address_variable};
+    std::copy(args, args + argument_number, placement_args.begin() + 1);
+    return InvokePlacement(placement_address, placement_args.data(),
+                           argument_number + 1);
+  }
+  std::vector<Variable*> placement_args(1 + argument_number);
+  placement_args[0] = &address_variable;
+  std::copy(args, args + argument_number, placement_args.begin() + 1);
+  return InvokePlacement(placement_address, placement_args.data(),
+                         placement_args.size());
+}
+
+MM::Reflection::Variable MM::Reflection::Constructor::InvokePlacement(
+    void* placement_address, Variable* const* placement_args,
+    std::size_t placement_argument_number) const {
+  if (!placement_constructor_wrapper_
+           ->Invoke(empty_variable, placement_args, placement_argument_number)
+           .IsValid()) {
+    return Variable{};
+  }
+  return Variable{static_cast<VariableWrapperBase*>(placement_address), true};
+}
+
 MM::Reflection::Constructor::Constructor(
     std::unique_ptr<MethodWrapperBase>&& common_constructor_wrapper,
     std::unique_ptr<MethodWrapperBase>&& placement_constructor_wrapper)
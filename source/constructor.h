@@ -320,12 +320,79 @@ class Constructor {
    */
   Variable Invoke(void* placement_address, std::vector<Variable*>&& args) const;
 
+  /**
+   * \brief Call the function with any number of parameters.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return \ref MM::Reflection::Variable containing the return value of this
+   * function.
+   * \remark If this object is invalid ,empty \ref MM::Reflection::Variable will
+   * be return. \remark If the number or type of incoming argument is different
+   * from the argument required by the function held by this object, the
+   * function held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(Variable* const* args, std::size_t argument_number) const;
+
+  /**
+   * \brief Invoke the placement constructor with any number of parameters.
+   * \param placement_address The location of the newly constructed
+   * VariableWrapper<OriginalType>.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \remark The constructed object is MM::
+   * Reflection::VariableWrapper<OriginalType>, not the original type, so the
+   * reserved space size is not the same as the original type. It is recommended
+   * to use MM::Reflection::GetVariableWrapperSize(std::uint64_t) to
+   * calculate the required reserved space size.
+   * \remark The placement address is prepended to the arguments in a stack
+   * buffer, only constructors with more than \ref PLACEMENT_INLINE_ARGUMENT_NUMBER
+   * arguments allocate memory.
+   */
+  Variable Invoke(void* placement_address, Variable* const* args,
+                  std::size_t argument_number) const;
+
+  /**
+   * \brief Call the function with any number of parameters.
+   * \param args Arguments.
+   * \return \ref MM::Reflection::Variable containing the return value of this
+   * function.
+   * \remark The arguments are passed on the stack, no memory is allocated.
+   */
+  template <typename... Args, typename = std::enable_if_t<(std::is_same_v<Args, Variable> && ...)>>
+  Variable Invoke(Args&... args) const {
+    std::array<Variable*, sizeof...(Args)> arg_array{&args...};
+    return Invoke(arg_array.data(), sizeof...(Args));
+  }
+
+  /**
+   * \brief Invoke the placement constructor with any number of parameters.
+   * \param placement_address The location of the newly constructed
+   * VariableWrapper<OriginalType>.
+   * \param args Arguments.
+   * \remark The arguments are passed on the stack, no memory is allocated.
+   */
+  template <typename... Args, typename = std::enable_if_t<(std::is_same_v<Args, Variable> && ...)>>
+  Variable Invoke(void* placement_address, Args&... args) const {
+    if (!IsValid()) {
+      return Variable{};
+    }
+
+    Variable address_variable = Variable::CreateVariable(placement_address);
+    std::array<Variable*, sizeof...(Args) + 1> placement_args{&address_variable, &args...};
+    return InvokePlacement(placement_address, placement_args.data(), placement_args.size());
+  }
+
  private:
   Constructor(std::unique_ptr<MethodWrapperBase>&& common_constructor_wrapper, std::unique_ptr<MethodWrapperBase>&& placement_constructor_wrapper);
 
+  Variable InvokePlacement(void* placement_address, Variable* const* placement_args, std::size_t placement_argument_number) const;
+
  private:
   static Variable empty_variable;
 
+  static constexpr std::size_t PLACEMENT_INLINE_ARGUMENT_NUMBER = 16;
+
   private:
     std::unique_ptr<MethodWrapperBase> common_constructor_wrapper_{};
     std::unique_ptr<MethodWrapperBase> placement_constructor_wrapper_{};
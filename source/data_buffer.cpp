@@ -1,9 +1,92 @@
 #include "data_buffer.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <cstring>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#endif
+
+namespace {
+std::uint64_t GetMappingGranularity() {
+#ifdef _WIN32
+  SYSTEM_INFO system_info{};
+  GetSystemInfo(&system_info);
+  return system_info.dwAllocationGranularity;
+#else
+  return static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+/**
+ * \brief Map \ref size bytes of the file from \ref offset copy-on-write.
+ * \param offset It must be a multiple of \ref GetMappingGranularity.
+ * \return The address of the mapping, or nullptr if it failed.
+ */
+void* MapFileView(const std::string& file_name, std::uint64_t offset,
+                  std::uint64_t size) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  // The view keeps the mapping alive.
+  void* view = MapViewOfFile(mapping, FILE_MAP_COPY,
+                             static_cast<DWORD>(offset >> 32),
+                             static_cast<DWORD>(offset & 0xFFFFFFFF),
+                             static_cast<SIZE_T>(size));
+  CloseHandle(mapping);
+  return view;
+#else
+  const int file = open(file_name.c_str(), O_RDONLY);
+  if (file == -1) {
+    return nullptr;
+  }
+  void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file,
+                    static_cast<off_t>(offset));
+  // The mapping keeps the file alive.
+  close(file);
+  if (view == MAP_FAILED) {
+    return nullptr;
+  }
+#ifdef MADV_SEQUENTIAL
+  madvise(view, size, MADV_SEQUENTIAL);
+#endif
+  return view;
+#endif
+}
+
+void UnmapFileView(void* view, std::uint64_t size) {
+#ifdef _WIN32
+  (void)size;
+  UnmapViewOfFile(view);
+#else
+  munmap(view, size);
+#endif
+}
+}  // namespace
+
 MM::Reflection::DataBuffer::~DataBuffer() { Release(); }
 
 MM::Reflection::DataBuffer::DataBuffer(const std::uint64_t init_size)
@@ -14,10 +97,32 @@ MM::Reflection::DataBuffer::DataBuffer(const std::uint64_t init_size)
 MM::Reflection::DataBuffer::DataBuffer(DataBuffer&& other) noexcept
     : data_(other.data_),
       capacity_(other.capacity_),
+      is_segmented_(other.is_segmented_),
+      segment_size_(other.segment_size_),
+      segments_(std::move(other.segments_)),
+      add_segment_index_(other.add_segment_index_),
+      read_segment_index_(other.read_segment_index_),
+      read_segment_offset_(other.read_segment_offset_),
+      mapping_(other.mapping_),
+      mapping_size_(other.mapping_size_),
+      is_view_(other.is_view_),
+      sink_(std::move(other.sink_)),
+      source_(std::move(other.source_)),
+      stream_offset_(other.stream_offset_),
+      is_stream_failed_(other.is_stream_failed_),
       read_data_offset_(other.read_data_offset_),
       add_data_offset_(other.add_data_offset_) {
   other.data_ = nullptr;
   other.capacity_ = 0;
+  other.segments_.clear();
+  other.add_segment_index_ = 0;
+  other.read_segment_index_ = 0;
+  other.read_segment_offset_ = 0;
+  other.mapping_ = nullptr;
+  other.mapping_size_ = 0;
+  other.is_view_ = false;
+  other.stream_offset_ = 0;
+  other.is_stream_failed_ = false;
   other.read_data_offset_ = 0;
   other.add_data_offset_ = 0;
 }
@@ -32,26 +137,104 @@ MM::Reflection::DataBuffer& MM::Reflection::DataBuffer::operator=(
 
   data_ = other.data_;
   capacity_ = other.capacity_;
+  is_segmented_ = other.is_segmented_;
+  segment_size_ = other.segment_size_;
+  segments_ = std::move(other.segments_);
+  add_segment_index_ = other.add_segment_index_;
+  read_segment_index_ = other.read_segment_index_;
+  read_segment_offset_ = other.read_segment_offset_;
+  mapping_ = other.mapping_;
+  mapping_size_ = other.mapping_size_;
+  is_view_ = other.is_view_;
+  sink_ = std::move(other.sink_);
+  source_ = std::move(other.source_);
+  stream_offset_ = other.stream_offset_;
+  is_stream_failed_ = other.is_stream_failed_;
   read_data_offset_ = other.read_data_offset_;
   add_data_offset_ = other.add_data_offset_;
 
   other.data_ = nullptr;
   other.capacity_ = 0;
+  other.segments_.clear();
+  other.add_segment_index_ = 0;
+  other.read_segment_index_ = 0;
+  other.read_segment_offset_ = 0;
+  other.mapping_ = nullptr;
+  other.mapping_size_ = 0;
+  other.is_view_ = false;
+  other.stream_offset_ = 0;
+  other.is_stream_failed_ = false;
   other.read_data_offset_ = 0;
   other.add_data_offset_ = 0;
 
   return *this;
 }
 
+MM::Reflection::DataBuffer MM::Reflection::DataBuffer::CreateSegmented(
+    std::uint64_t segment_size) {
+  DataBuffer result{};
+  result.is_segmented_ = true;
+  result.segment_size_ = segment_size == 0 ? DEFAULT_SEGMENT_SIZE : segment_size;
+
+  return result;
+}
+
+MM::Reflection::DataBuffer MM::Reflection::DataBuffer::CreateWriteStream(
+    std::unique_ptr<DataSink>&& sink, std::uint64_t staging_size) {
+  assert(sink != nullptr);
+
+  DataBuffer result{staging_size == 0 ? DEFAULT_STAGING_SIZE : staging_size};
+  result.sink_ = std::move(sink);
+
+  return result;
+}
+
+MM::Reflection::DataBuffer MM::Reflection::DataBuffer::CreateReadStream(
+    std::unique_ptr<DataSource>&& source, std::uint64_t staging_size) {
+  assert(source != nullptr);
+
+  DataBuffer result{staging_size == 0 ? DEFAULT_STAGING_SIZE : staging_size};
+  result.source_ = std::move(source);
+
+  return result;
+}
+
 void MM::Reflection::DataBuffer::AddData(const void* data_from,
                                          const std::uint64_t size) {
   assert(data_from != nullptr && size != 0);
 
-  if (size + add_data_offset_ > capacity_) {
-    if (capacity_ == 0) {
-      capacity_ = 1024;
+  if (sink_ != nullptr && size + add_data_offset_ > capacity_) {
+    Flush();
+    // Data larger than the buffer is sent without copying it.
+    if (size >= capacity_) {
+      if (!sink_->Write(data_from, size)) {
+        is_stream_failed_ = true;
+      }
+      stream_offset_ += size;
+      return;
     }
-    Reserver(capacity_ * 2);
+  }
+
+  if (is_segmented_) {
+    const auto* from = static_cast<const RowDataType*>(data_from);
+    std::uint64_t remaining_size = size;
+    while (remaining_size != 0) {
+      Segment& segment = GetAddSegment(remaining_size, false);
+      const std::uint64_t copy_size =
+          std::min(remaining_size, segment.capacity_ - segment.size_);
+      memcpy(segment.data_.get() + segment.size_, from, copy_size);
+      segment.size_ += copy_size;
+      from += copy_size;
+      remaining_size -= copy_size;
+    }
+    add_data_offset_ += size;
+    return;
+  }
+
+  // The memory of a view is not written, so it is copied first.
+  if (size + add_data_offset_ > capacity_ || is_view_) {
+    Reserver(std::max(capacity_ == 0 ? 2048 : capacity_ * 2,
+                      size + add_data_offset_));
   }
 
   memcpy(data_ + add_data_offset_, data_from, size);
@@ -59,18 +242,178 @@ void MM::Reflection::DataBuffer::AddData(const void* data_from,
   add_data_offset_ += size;
 }
 
+void* MM::Reflection::DataBuffer::AddEmptyData(const std::uint64_t size) {
+  assert(size != 0);
+
+  if (is_segmented_) {
+    Segment& segment = GetAddSegment(size, true);
+    void* result = segment.data_.get() + segment.size_;
+    segment.size_ += size;
+    add_data_offset_ += size;
+    return result;
+  }
+
+  if (sink_ != nullptr && size + add_data_offset_ > capacity_) {
+    Flush();
+  }
+
+  if (size + add_data_offset_ > capacity_ || is_view_) {
+    Reserver(std::max(capacity_ == 0 ? 2048 : capacity_ * 2,
+                      size + add_data_offset_));
+  }
+
+  void* result = data_ + add_data_offset_;
+  add_data_offset_ += size;
+
+  return result;
+}
+
 void MM::Reflection::DataBuffer::ReadData(void* data_to,
                                           const std::uint64_t size) const {
   assert(data_to != nullptr && size != 0);
+
+  if (source_ != nullptr) {
+    auto* to = static_cast<RowDataType*>(data_to);
+    std::uint64_t remaining_size = size;
+    while (remaining_size != 0) {
+      if (read_data_offset_ == add_data_offset_ && !FillStreamData(1)) {
+        std::cerr << "[Error] [MMReflection] The data source ended "
+                  << remaining_size << " bytes before the end of the read.\n";
+        is_stream_failed_ = true;
+        memset(to, 0, remaining_size);
+        return;
+      }
+      const std::uint64_t copy_size =
+          std::min(remaining_size, add_data_offset_ - read_data_offset_);
+      memcpy(to, data_ + read_data_offset_, copy_size);
+      read_data_offset_ += copy_size;
+      to += copy_size;
+      remaining_size -= copy_size;
+    }
+    return;
+  }
+
   assert(read_data_offset_ + size <= add_data_offset_);
 
+  if (is_segmented_) {
+    ReadSegmentData(data_to, size);
+    return;
+  }
+
   memcpy(data_to, data_ + read_data_offset_, size);
 
   read_data_offset_ += size;
 }
 
+const void* MM::Reflection::DataBuffer::ReadDataInPlace(
+    const std::uint64_t size) const {
+  if (source_ != nullptr && !FillStreamData(size)) {
+    std::cerr << "[Error] [MMReflection] The data source ended before the end "
+                 "of the read.\n";
+    is_stream_failed_ = true;
+    read_data_offset_ = add_data_offset_;
+    return nullptr;
+  }
+
+  assert(read_data_offset_ + size <= add_data_offset_);
+
+  if (is_segmented_) {
+    const void* result = PeekDataInPlace(size);
+    ReadSegmentData(nullptr, size);
+    return result;
+  }
+
+  const void* result = data_ + read_data_offset_;
+  read_data_offset_ += size;
+
+  return result;
+}
+
+void MM::Reflection::DataBuffer::PeekData(void* data_to,
+                                          const std::uint64_t size) const {
+  assert(data_to != nullptr && size != 0);
+
+  if (source_ != nullptr && !FillStreamData(size)) {
+    std::cerr << "[Error] [MMReflection] The data source ended before the end "
+                 "of the read.\n";
+    is_stream_failed_ = true;
+    memset(data_to, 0, size);
+    return;
+  }
+
+  assert(read_data_offset_ + size <= add_data_offset_);
+
+  if (is_segmented_) {
+    const std::size_t read_segment_index = read_segment_index_;
+    const std::uint64_t read_segment_offset = read_segment_offset_;
+    ReadSegmentData(data_to, size);
+    read_segment_index_ = read_segment_index;
+    read_segment_offset_ = read_segment_offset;
+    read_data_offset_ -= size;
+    return;
+  }
+
+  memcpy(data_to, data_ + read_data_offset_, size);
+}
+
+const void* MM::Reflection::DataBuffer::PeekDataInPlace(
+    const std::uint64_t size) const {
+  if (source_ != nullptr) {
+    FillStreamData(size);
+  }
+  if (add_data_offset_ - read_data_offset_ < size) {
+    return nullptr;
+  }
+
+  if (is_segmented_) {
+    // Skip the segments that are read to the end.
+    while (read_segment_index_ < segments_.size() &&
+           read_segment_offset_ == segments_[read_segment_index_].size_) {
+      ++read_segment_index_;
+      read_segment_offset_ = 0;
+    }
+    if (read_segment_index_ == segments_.size()) {
+      return size == 0 ? data_ : nullptr;
+    }
+    const Segment& segment = segments_[read_segment_index_];
+    if (segment.size_ - read_segment_offset_ < size) {
+      return nullptr;
+    }
+    return segment.data_.get() + read_segment_offset_;
+  }
+
+  return data_ + read_data_offset_;
+}
+
+bool MM::Reflection::DataBuffer::CanReadData(const std::uint64_t size) const {
+  if (source_ != nullptr) {
+    return FillStreamData(size);
+  }
+
+  return add_data_offset_ - read_data_offset_ >= size;
+}
+
+bool MM::Reflection::DataBuffer::Flush() {
+  if (sink_ != nullptr && add_data_offset_ != 0) {
+    if (!sink_->Write(data_, add_data_offset_)) {
+      std::cerr << "[Error] [MMReflection] Falid to write "
+                << add_data_offset_ << " bytes to the data sink.\n";
+      is_stream_failed_ = true;
+    }
+    stream_offset_ += add_data_offset_;
+    read_data_offset_ = 0;
+    add_data_offset_ = 0;
+  }
+
+  return !is_stream_failed_;
+}
+
+bool MM::Reflection::DataBuffer::IsStream() const {
+  return sink_ != nullptr || source_ != nullptr;
+}
+
 void MM::Reflection::DataBuffer::Reserver(std::uint64_t new_size) {
-  if (new_size <= capacity_) {
+  if (is_segmented_ || new_size <= capacity_) {
     return;
   }
 
@@ -79,56 +422,174 @@ void MM::Reflection::DataBuffer::Reserver(std::uint64_t new_size) {
     memcpy(new_data, data_, add_data_offset_);
   }
 
-  delete data_;
+  ReleaseData();
 
   data_ = new_data;
   capacity_ = new_size;
 }
 
 void MM::Reflection::DataBuffer::Release() {
-  delete[] data_;
+  Flush();
+  ReleaseData();
 
   data_ = nullptr;
   capacity_ = 0;
+  segments_.clear();
+  add_segment_index_ = 0;
+  read_segment_index_ = 0;
+  read_segment_offset_ = 0;
   read_data_offset_ = 0;
   add_data_offset_ = 0;
 }
 
 void MM::Reflection::DataBuffer::Clear() {
+  for (Segment& segment : segments_) {
+    segment.size_ = 0;
+  }
+  add_segment_index_ = 0;
+  read_segment_index_ = 0;
+  read_segment_offset_ = 0;
   read_data_offset_ = 0;
   add_data_offset_ = 0;
 }
 
-void* MM::Reflection::DataBuffer::GetData() { return data_; }
+void* MM::Reflection::DataBuffer::GetData() {
+  if (is_segmented_) {
+    return segments_.empty() ? nullptr : segments_.front().data_.get();
+  }
+
+  return data_;
+}
 
-const void* MM::Reflection::DataBuffer::GetData() const { return data_; }
+const void* MM::Reflection::DataBuffer::GetData() const {
+  if (is_segmented_) {
+    return segments_.empty() ? nullptr : segments_.front().data_.get();
+  }
+
+  return data_;
+}
 
 std::uint64_t MM::Reflection::DataBuffer::GetCapacity() const {
   return capacity_;
 }
 
 std::uint64_t MM::Reflection::DataBuffer::GetReadDataOffset() const {
-  return read_data_offset_;
+  return stream_offset_ + read_data_offset_;
+}
+
+bool MM::Reflection::DataBuffer::SetReadDataOffset(
+    std::uint64_t offset) const {
+  if (IsStream() || offset > add_data_offset_) {
+    return false;
+  }
+
+  read_data_offset_ = offset;
+  if (is_segmented_) {
+    read_segment_index_ = 0;
+    while (read_segment_index_ + 1 < segments_.size() &&
+           offset > segments_[read_segment_index_].size_) {
+      offset -= segments_[read_segment_index_].size_;
+      ++read_segment_index_;
+    }
+    read_segment_offset_ = offset;
+  }
+
+  return true;
 }
 
 std::uint64_t MM::Reflection::DataBuffer::GetAddDataOffset() const {
-  return add_data_offset_;
+  return stream_offset_ + add_data_offset_;
+}
+
+bool MM::Reflection::DataBuffer::IsSegmented() const { return is_segmented_; }
+
+std::vector<MM::Reflection::DataSegment>
+MM::Reflection::DataBuffer::GetSegments() const {
+  std::vector<DataSegment> result{};
+  if (!is_segmented_) {
+    if (add_data_offset_ != 0) {
+      result.push_back(DataSegment{data_, add_data_offset_});
+    }
+    return result;
+  }
+
+  result.reserve(add_segment_index_ + 1);
+  for (const Segment& segment : segments_) {
+    if (segment.size_ != 0) {
+      result.push_back(DataSegment{segment.data_.get(), segment.size_});
+    }
+  }
+
+  return result;
 }
 
 bool MM::Reflection::DataBuffer::WriteToFile(
     const std::string& file_name) const {
-  std::ofstream file{file_name, std::ios::trunc};
+  const std::vector<DataSegment> segments = GetSegments();
+
+#ifdef _WIN32
+  std::ofstream file{file_name, std::ios::binary | std::ios::trunc};
   if (!file.is_open()) {
     std::cerr << "[Error] [MMReflection] Falid to open file " << file_name
               << ".\n";
     return false;
   }
 
-  file.write(reinterpret_cast<char*>(data_), add_data_offset_);
+  for (const DataSegment& segment : segments) {
+    file.write(static_cast<const char*>(segment.data_), segment.size_);
+  }
 
   file.close();
 
-  return true;
+  return static_cast<bool>(file);
+#else
+  const int file = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (file == -1) {
+    std::cerr << "[Error] [MMReflection] Falid to open file " << file_name
+              << ".\n";
+    return false;
+  }
+
+  std::vector<iovec> io_vectors{};
+  io_vectors.reserve(segments.size());
+  for (const DataSegment& segment : segments) {
+    io_vectors.push_back(
+        iovec{const_cast<void*>(segment.data_), segment.size_});
+  }
+
+  // One writev writes at most IOV_MAX segments and may write only part of
+  // them.
+  std::size_t first_io_vector = 0;
+  while (first_io_vector != io_vectors.size()) {
+    const int io_vector_number = static_cast<int>(std::min<std::size_t>(
+        io_vectors.size() - first_io_vector, IOV_MAX));
+    const ssize_t written_size =
+        writev(file, io_vectors.data() + first_io_vector, io_vector_number);
+    if (written_size == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      std::cerr << "[Error] [MMReflection] Falid to write file " << file_name
+                << ".\n";
+      close(file);
+      return false;
+    }
+
+    std::uint64_t remaining_size = static_cast<std::uint64_t>(written_size);
+    while (first_io_vector != io_vectors.size() &&
+           remaining_size >= io_vectors[first_io_vector].iov_len) {
+      remaining_size -= io_vectors[first_io_vector].iov_len;
+      ++first_io_vector;
+    }
+    if (remaining_size != 0) {
+      iovec& io_vector = io_vectors[first_io_vector];
+      io_vector.iov_base = static_cast<char*>(io_vector.iov_base) + remaining_size;
+      io_vector.iov_len -= remaining_size;
+    }
+  }
+
+  return close(file) == 0;
+#endif
 }
 
 bool MM::Reflection::DataBuffer::LoadFromFile(const std::string& file_name,
@@ -173,20 +634,265 @@ bool MM::Reflection::DataBuffer::LoadFromFile(const std::string& file_name,
   }
   file.seekg(offset, std::ios::beg);
 
-  if (file_size + add_data_offset_ > capacity_) {
-    Reserver(file_size + add_data_offset_);
+  if (file_size == 0) {
+    return true;
   }
 
-  if (!file.read(reinterpret_cast<char*>(data_) + add_data_offset_,
-                 file_size)) {
+  void* data_to = AddEmptyData(file_size);
+  if (!file.read(static_cast<char*>(data_to), file_size)) {
     std::cerr << "[Error] [MMReflection] Falid to read file " << file_name
               << ".\n";
+    RemoveEmptyData(file_size);
     return false;
   }
 
-  add_data_offset_ += file_size;
+  file.close();
+
+  return true;
+}
 
+bool MM::Reflection::DataBuffer::MapFile(const std::string& file_name,
+                                         std::uint64_t offset,
+                                         std::uint64_t size) {
+  std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+  if (!file) {
+    std::cerr << "[Error] [MMReflection] Falid to open file " << file_name
+              << ".\n";
+    return false;
+  }
+  const std::uint64_t file_size = file.tellg();
   file.close();
 
+  if (size == ~static_cast<std::uint64_t>(0x0LL)) {
+    if (offset >= file_size) {
+      std::cerr
+          << "[Error] [MMReflection] Failed to map file " << file_name
+          << " offset " << offset << ".The size of file " << file_name
+          << " is " << file_size
+          << " bytes, and the specified location exceeds the file size.\n";
+      return false;
+    }
+    size = file_size - offset;
+  } else if (offset + size > file_size || size == 0) {
+    std::cerr
+        << "[Error] [MMReflection] Failed to map " << size
+        << " bytes of file " << file_name << " offset " << offset
+        << ".The size of file " << file_name << " is " << file_size
+        << " bytes, and the specified location exceeds the file size.\n";
+    return false;
+  }
+
+  const std::uint64_t mapping_offset =
+      offset - offset % GetMappingGranularity();
+  const std::uint64_t mapping_size = size + (offset - mapping_offset);
+  void* mapping = MapFileView(file_name, mapping_offset, mapping_size);
+  if (mapping == nullptr) {
+    std::cerr << "[Error] [MMReflection] Falid to map file " << file_name
+              << ".\n";
+    return false;
+  }
+
+  Release();
+
+  is_segmented_ = false;
+  mapping_ = mapping;
+  mapping_size_ = mapping_size;
+  data_ = static_cast<RowDataType*>(mapping) + (offset - mapping_offset);
+  capacity_ = size;
+  add_data_offset_ = size;
+
   return true;
-}
\ No newline at end of file
+}
+
+bool MM::Reflection::DataBuffer::IsMapped() const {
+  return mapping_ != nullptr;
+}
+
+MM::Reflection::DataBuffer MM::Reflection::DataBuffer::CreateView(
+    const void* data, std::uint64_t size, std::uint64_t read_offset) {
+  DataBuffer result{};
+  result.data_ = static_cast<RowDataType*>(const_cast<void*>(data));
+  result.capacity_ = size;
+  result.add_data_offset_ = size;
+  result.read_data_offset_ = read_offset;
+  result.is_view_ = true;
+
+  return result;
+}
+
+void MM::Reflection::DataBuffer::ReleaseData() {
+  if (is_view_) {
+    is_view_ = false;
+    return;
+  }
+  if (mapping_ != nullptr) {
+    UnmapFileView(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    return;
+  }
+
+  delete[] data_;
+}
+
+MM::Reflection::DataBuffer::Segment& MM::Reflection::DataBuffer::GetAddSegment(
+    std::uint64_t size, bool need_contiguous) {
+  // The segments emptied by Clear are reused. The ones that are too small are
+  // left empty, reading and GetSegments skip them.
+  for (; add_segment_index_ < segments_.size(); ++add_segment_index_) {
+    Segment& segment = segments_[add_segment_index_];
+    const std::uint64_t free_size = segment.capacity_ - segment.size_;
+    if (free_size >= size || (!need_contiguous && free_size != 0)) {
+      return segment;
+    }
+  }
+
+  const std::uint64_t new_capacity = std::max(segment_size_, size);
+  Segment new_segment{};
+  new_segment.data_.reset(new RowDataType[new_capacity]);
+  new_segment.capacity_ = new_capacity;
+  capacity_ += new_capacity;
+  segments_.push_back(std::move(new_segment));
+
+  return segments_.back();
+}
+
+void MM::Reflection::DataBuffer::ReadSegmentData(void* data_to,
+                                                 std::uint64_t size) const {
+  auto* to = static_cast<RowDataType*>(data_to);
+  read_data_offset_ += size;
+  while (size != 0) {
+    assert(read_segment_index_ < segments_.size());
+    const Segment& segment = segments_[read_segment_index_];
+    const std::uint64_t copy_size =
+        std::min(size, segment.size_ - read_segment_offset_);
+    if (to != nullptr && copy_size != 0) {
+      memcpy(to, segment.data_.get() + read_segment_offset_, copy_size);
+      to += copy_size;
+    }
+    read_segment_offset_ += copy_size;
+    size -= copy_size;
+    if (read_segment_offset_ == segment.size_ && size != 0) {
+      ++read_segment_index_;
+      read_segment_offset_ = 0;
+    }
+  }
+}
+
+void MM::Reflection::DataBuffer::RemoveEmptyData(std::uint64_t size) {
+  assert(size <= add_data_offset_);
+
+  add_data_offset_ -= size;
+  if (is_segmented_) {
+    // AddEmptyData puts all bytes in one segment.
+    assert(segments_[add_segment_index_].size_ >= size);
+    segments_[add_segment_index_].size_ -= size;
+  }
+}
+
+bool MM::Reflection::DataBuffer::FillStreamData(std::uint64_t size) const {
+  if (add_data_offset_ - read_data_offset_ >= size) {
+    return true;
+  }
+
+  // Drop the bytes already read to make room.
+  const std::uint64_t remaining_size = add_data_offset_ - read_data_offset_;
+  if (read_data_offset_ != 0) {
+    memmove(data_, data_ + read_data_offset_, remaining_size);
+    stream_offset_ += read_data_offset_;
+    read_data_offset_ = 0;
+    add_data_offset_ = remaining_size;
+  }
+  if (size > capacity_) {
+    auto* new_data = new RowDataType[size];
+    if (remaining_size != 0) {
+      memcpy(new_data, data_, remaining_size);
+    }
+    delete[] data_;
+    data_ = new_data;
+    capacity_ = size;
+  }
+
+  while (add_data_offset_ < size) {
+    const std::uint64_t read_size = source_->Read(
+        data_ + add_data_offset_, capacity_ - add_data_offset_);
+    if (read_size == 0) {
+      return false;
+    }
+    add_data_offset_ += read_size;
+  }
+
+  return true;
+}
+
+MM::Reflection::DataBufferReader::DataBufferReader(const void* data,
+                                                   std::uint64_t size)
+    : data_(static_cast<const std::uint8_t*>(data)),
+      end_(static_cast<const std::uint8_t*>(data) + size) {}
+
+MM::Reflection::DataBufferReader::DataBufferReader(
+    const DataBuffer& data_buffer) {
+  if (data_buffer.IsSegmented() || data_buffer.IsStream()) {
+    std::cerr << "[Error] [MMReflection] The data of a segmented or stream "
+                 "buffer is not contiguous, so it cannot be read by a "
+                 "DataBufferReader.\n";
+    return;
+  }
+
+  data_ = static_cast<const std::uint8_t*>(data_buffer.GetData());
+  end_ = data_ + data_buffer.GetAddDataOffset();
+  read_data_offset_ = data_buffer.GetReadDataOffset();
+}
+
+void MM::Reflection::DataBufferReader::ReadData(void* data_to,
+                                                std::uint64_t size) {
+  PeekData(data_to, size);
+  read_data_offset_ += size;
+}
+
+const void* MM::Reflection::DataBufferReader::ReadDataInPlace(
+    std::uint64_t size) {
+  assert(CanReadData(size));
+
+  const void* result = data_ + read_data_offset_;
+  read_data_offset_ += size;
+
+  return result;
+}
+
+void MM::Reflection::DataBufferReader::PeekData(void* data_to,
+                                                std::uint64_t size) const {
+  assert(CanReadData(size));
+
+  if (size != 0) {
+    memcpy(data_to, data_ + read_data_offset_, size);
+  }
+}
+
+const void* MM::Reflection::DataBufferReader::PeekDataInPlace(
+    std::uint64_t size) const {
+  return CanReadData(size) ? data_ + read_data_offset_ : nullptr;
+}
+
+bool MM::Reflection::DataBufferReader::CanReadData(std::uint64_t size) const {
+  return GetSize() - read_data_offset_ >= size;
+}
+
+std::uint64_t MM::Reflection::DataBufferReader::GetReadDataOffset() const {
+  return read_data_offset_;
+}
+
+bool MM::Reflection::DataBufferReader::SetReadDataOffset(std::uint64_t offset) {
+  if (offset > GetSize()) {
+    return false;
+  }
+
+  read_data_offset_ = offset;
+  return true;
+}
+
+std::uint64_t MM::Reflection::DataBufferReader::GetSize() const {
+  return static_cast<std::uint64_t>(end_ - data_);
+}
+
+const void* MM::Reflection::DataBufferReader::GetData() const { return data_; }
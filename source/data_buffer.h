@@ -2,14 +2,31 @@
 
 #include <cassert>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
+
+#include "data_stream.h"
 
 namespace MM {
 namespace Reflection {
+/**
+ * \brief A contiguous part of the data of a \ref DataBuffer.
+ * \remark It has the layout of a POSIX iovec on 64 bits platforms.
+ */
+struct DataSegment {
+  const void* data_{nullptr};
+  std::uint64_t size_{0};
+};
+
 class DataBuffer {
 public:
   using RowDataType = std::uint8_t;
 
+  static constexpr std::uint64_t DEFAULT_SEGMENT_SIZE = 1024 * 1024;
+
+  static constexpr std::uint64_t DEFAULT_STAGING_SIZE = 64 * 1024;
+
 public:
   DataBuffer() = default;
   ~DataBuffer();
@@ -20,10 +37,101 @@ public:
   DataBuffer& operator=(DataBuffer&& other) noexcept;
 
  public:
+  /**
+   * \brief Create a buffer that grows by adding segments, instead of moving
+   * all data to a larger allocation.
+   * \param segment_size The size of each segment. Larger appends get a segment
+   * of their own.
+   * \remark Data already written is never copied again, so the memory peak is
+   * the size of the data plus at most one segment. \ref WriteToFile writes all
+   * segments with one system call.
+   * \remark \ref GetData only returns the first segment, use
+   * \ref GetSegments. \ref Reserver does nothing.
+   */
+  static DataBuffer CreateSegmented(
+      std::uint64_t segment_size = DEFAULT_SEGMENT_SIZE);
+
+  /**
+   * \brief Create a buffer that sends its data to \ref sink when it is full,
+   * instead of growing.
+   * \param staging_size The size of the buffer. It only grows if a single
+   * \ref AddEmptyData needs more.
+   * \remark Memory does not depend on how much data is written.
+   * \ref GetAddDataOffset counts all bytes, \ref GetData only has the bytes
+   * not sent yet. Call \ref Flush to send them, the destructor sends them too.
+   * \remark \ref Clear drops the bytes not sent yet.
+   */
+  static DataBuffer CreateWriteStream(
+      std::unique_ptr<DataSink>&& sink,
+      std::uint64_t staging_size = DEFAULT_STAGING_SIZE);
+
+  /**
+   * \brief Create a buffer that reads its data from \ref source when the read
+   * needs more, instead of holding all data.
+   * \param staging_size The size of the buffer. It only grows if a single
+   * in-place read needs more.
+   * \remark Use \ref CanReadData to check if more data can be read,
+   * \ref GetAddDataOffset only counts the bytes read from the source so far.
+   */
+  static DataBuffer CreateReadStream(
+      std::unique_ptr<DataSource>&& source,
+      std::uint64_t staging_size = DEFAULT_STAGING_SIZE);
+
+  /**
+   * \brief Create a buffer that reads \ref size bytes of memory it does not
+   * own, such as the data of a \ref DataBufferReader.
+   * \remark The memory is never freed by the buffer and must outlive it. Do
+   * not write to it through \ref GetData. Adding data first copies the data
+   * into memory owned by the buffer.
+   */
+  static DataBuffer CreateView(const void* data, std::uint64_t size,
+                               std::uint64_t read_offset = 0);
+
   void AddData(const void* data_from, const std::uint64_t size);
 
+  /**
+   * \brief Append \ref size uninitialized bytes.
+   * \return The address of the appended bytes. It is valid until the next
+   * call that adds data.
+   */
+  void* AddEmptyData(const std::uint64_t size);
+
   void ReadData(void* data_to, const std::uint64_t size) const;
 
+  /**
+   * \brief Skip \ref size bytes without copying them.
+   * \return The address of the skipped bytes in the buffer, or nullptr if
+   * they are split between segments.
+   */
+  const void* ReadDataInPlace(const std::uint64_t size) const;
+
+  /**
+   * \brief Copy the next \ref size bytes without reading them.
+   */
+  void PeekData(void* data_to, const std::uint64_t size) const;
+
+  /**
+   * \brief Get the address of the next \ref size bytes without reading them.
+   * \return Returns nullptr if fewer bytes are left or they are split between
+   * segments.
+   */
+  const void* PeekDataInPlace(const std::uint64_t size) const;
+
+  /**
+   * \brief Check if \ref size more bytes can be read.
+   * \remark A read stream reads from its source until \ref size bytes are in
+   * the buffer or the source ends.
+   */
+  [[nodiscard]] bool CanReadData(const std::uint64_t size) const;
+
+  /**
+   * \brief Send the data of a write stream to its sink.
+   * \return Returns false if any data of the stream could not be sent or read.
+   */
+  bool Flush();
+
+  [[nodiscard]] bool IsStream() const;
+
   void Reserver(std::uint64_t new_size);
 
   void Release();
@@ -38,19 +146,194 @@ public:
 
   [[nodiscard]] std::uint64_t GetReadDataOffset() const;
 
+  /**
+   * \brief Move the read position to \ref offset, before or after the
+   * current one.
+   * \return Returns false for a stream or if \ref offset is past the added
+   * data. Then the read position does not change.
+   */
+  bool SetReadDataOffset(std::uint64_t offset) const;
+
   [[nodiscard]] std::uint64_t GetAddDataOffset() const;
 
+  [[nodiscard]] bool IsSegmented() const;
+
+  /**
+   * \brief Get all data in order, as contiguous parts.
+   * \remark A buffer that is not segmented has one part.
+   */
+  std::vector<DataSegment> GetSegments() const;
+
   bool WriteToFile(const std::string& file_name) const;
 
   bool LoadFromFile(const std::string& file_name, std::uint64_t offset = 0, std::uint64_t size = ~static_cast<std::uint64_t>(0x0LL));
 
+  /**
+   * \brief Replace the content of this buffer with a memory mapping of the
+   * file, instead of copying the file in.
+   * \remark Mapping takes the same time for any file size, and the pages are
+   * read from disk when they are first touched. The mapping is hinted for
+   * sequential reads.
+   * \remark The mapping is copy-on-write: changes made through \ref GetData
+   * stay in this buffer and never reach the file. The first call that needs
+   * more capacity (such as \ref AddData past the end of the file) copies the
+   * data into memory owned by the buffer and releases the mapping.
+   */
+  bool MapFile(const std::string& file_name, std::uint64_t offset = 0, std::uint64_t size = ~static_cast<std::uint64_t>(0x0LL));
+
+  [[nodiscard]] bool IsMapped() const;
+
+ private:
+  struct Segment {
+    std::unique_ptr<RowDataType[]> data_{};
+    std::uint64_t capacity_{0};
+    std::uint64_t size_{0};
+  };
+
+ private:
+  void ReleaseData();
+
+  /**
+   * \brief Get the segment that the next \ref size bytes are added to.
+   * \param need_contiguous If it is false, the segment may only have room for
+   * part of the bytes.
+   */
+  Segment& GetAddSegment(std::uint64_t size, bool need_contiguous);
+
+  /**
+   * \brief Read \ref size bytes from the segments.
+   * \param data_to It can be nullptr to skip the bytes.
+   */
+  void ReadSegmentData(void* data_to, std::uint64_t size) const;
+
+  /**
+   * \brief Remove the last \ref size bytes added by \ref AddEmptyData.
+   */
+  void RemoveEmptyData(std::uint64_t size);
+
+  /**
+   * \brief Read from the source until \ref size bytes are in the buffer.
+   * \return Returns false if the source ends first.
+   */
+  bool FillStreamData(std::uint64_t size) const;
+
  private:
-  RowDataType* data_{nullptr};
-  std::uint64_t capacity_{0};
+  // A read stream refills them in the reads.
+  mutable RowDataType* data_{nullptr};
+  mutable std::uint64_t capacity_{0};
+
+  // Only used if the buffer is segmented. The segments after
+  // add_segment_index_ are empty and reused after Clear.
+  bool is_segmented_{false};
+  std::uint64_t segment_size_{0};
+  std::vector<Segment> segments_{};
+  std::size_t add_segment_index_{0};
+  mutable std::size_t read_segment_index_{0};
+  mutable std::uint64_t read_segment_offset_{0};
+
+  // The start and the size of the mapped pages, if the data is mapped from a
+  // file. data_ points into it, because the offset of a mapping must be
+  // aligned to pages.
+  void* mapping_{nullptr};
+  std::uint64_t mapping_size_{0};
+
+  // Set if data_ is borrowed from a DataBufferReader.
+  bool is_view_{false};
+
+  // Only used if the buffer is a stream. stream_offset_ is the number of bytes
+  // sent to the sink or dropped from the buffer after they are read.
+  std::unique_ptr<DataSink> sink_{};
+  std::unique_ptr<DataSource> source_{};
+  mutable std::uint64_t stream_offset_{0};
+  mutable bool is_stream_failed_{false};
 
   mutable std::uint64_t read_data_offset_{0};
-  std::uint64_t add_data_offset_{0};
+  mutable std::uint64_t add_data_offset_{0};
 };
 
+/**
+ * \brief A read position over the data of a \ref DataBuffer or of any
+ * memory, such as a memory mapping.
+ * \remark It only holds the address of the data, its end and the read
+ * offset, so it is cheap to create and to copy. A copy reads on from the same
+ * position without moving the position of the original, so peeking is a copy.
+ * \remark The data is never changed, so any number of readers can read the
+ * same data on different threads, as long as the data outlives them and is
+ * not changed meanwhile.
+ * \remark \ref Deserialize and the other readers of this library accept a
+ * reader in the place of a \ref DataBuffer.
+ */
+class DataBufferReader {
+ public:
+  DataBufferReader() = default;
+  ~DataBufferReader() = default;
+  DataBufferReader(const void* data, std::uint64_t size);
+  /**
+   * \brief Read the data of \ref data_buffer, from its read position.
+   * \remark A segmented or stream buffer is refused, because its data is not
+   * contiguous: an error is printed and the reader is empty, so
+   * \ref GetSize returns 0 and \ref CanReadData returns false. Read such a
+   * buffer directly, since every function that takes a reader also takes a
+   * \ref DataBuffer.
+   */
+  explicit DataBufferReader(const DataBuffer& data_buffer);
+  DataBufferReader(const DataBufferReader& other) = default;
+  DataBufferReader(DataBufferReader&& other) noexcept = default;
+  DataBufferReader& operator=(const DataBufferReader& other) = default;
+  DataBufferReader& operator=(DataBufferReader&& other) noexcept = default;
+
+ public:
+  void ReadData(void* data_to, std::uint64_t size);
+
+  /**
+   * \brief Skip \ref size bytes without copying them.
+   * \return The address of the skipped bytes.
+   */
+  const void* ReadDataInPlace(std::uint64_t size);
+
+  void PeekData(void* data_to, std::uint64_t size) const;
+
+  /**
+   * \brief Get the address of the next \ref size bytes without reading them.
+   * \return Returns nullptr if fewer bytes are left.
+   */
+  const void* PeekDataInPlace(std::uint64_t size) const;
+
+  [[nodiscard]] bool CanReadData(std::uint64_t size) const;
+
+  [[nodiscard]] std::uint64_t GetReadDataOffset() const;
+
+  /**
+   * \return Returns false if \ref offset is past the end of the data. Then
+   * the read position does not change.
+   */
+  bool SetReadDataOffset(std::uint64_t offset);
+
+  [[nodiscard]] std::uint64_t GetSize() const;
+
+  const void* GetData() const;
+
+  /**
+   * \brief Call \ref function with a \ref DataBuffer that reads the data of
+   * this reader from its read position, and then move the read position past
+   * what \ref function read.
+   * \remark The buffer does not copy the data, so any function that reads a
+   * \ref DataBuffer can read from a reader.
+   */
+  template <typename Function>
+  auto ReadWithDataBuffer(Function&& function) {
+    const DataBuffer data_buffer =
+        DataBuffer::CreateView(data_, GetSize(), read_data_offset_);
+    auto result = function(data_buffer);
+    read_data_offset_ = data_buffer.GetReadDataOffset();
+
+    return result;
+  }
+
+ private:
+  const std::uint8_t* data_{nullptr};
+  const std::uint8_t* end_{nullptr};
+  std::uint64_t read_data_offset_{0};
+};
+}
 }
-}
\ No newline at end of file
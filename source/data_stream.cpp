@@ -0,0 +1,103 @@
+#include "data_stream.h"
+
+#include <algorithm>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+
+#include <unistd.h>
+#endif
+
+namespace {
+// The largest size passed to one read or write call.
+constexpr std::uint64_t MAX_SYSTEM_CALL_SIZE = 1024 * 1024 * 1024;
+}  // namespace
+
+MM::Reflection::FileDescriptorSink::FileDescriptorSink(int file_descriptor)
+    : file_descriptor_(file_descriptor) {}
+
+bool MM::Reflection::FileDescriptorSink::Write(const void* data_from,
+                                               std::uint64_t size) {
+  const auto* from = static_cast<const char*>(data_from);
+  while (size != 0) {
+    const std::uint64_t write_size = std::min(size, MAX_SYSTEM_CALL_SIZE);
+#ifdef _WIN32
+    const int written_size = _write(file_descriptor_, from,
+                                    static_cast<unsigned int>(write_size));
+    if (written_size <= 0) {
+      return false;
+    }
+#else
+    const ssize_t written_size = write(file_descriptor_, from, write_size);
+    if (written_size == -1 && errno == EINTR) {
+      continue;
+    }
+    if (written_size <= 0) {
+      return false;
+    }
+#endif
+    from += written_size;
+    size -= static_cast<std::uint64_t>(written_size);
+  }
+
+  return true;
+}
+
+MM::Reflection::FileDescriptorSource::FileDescriptorSource(int file_descriptor)
+    : file_descriptor_(file_descriptor) {}
+
+std::uint64_t MM::Reflection::FileDescriptorSource::Read(void* data_to,
+                                                         std::uint64_t size) {
+  const std::uint64_t read_size = std::min(size, MAX_SYSTEM_CALL_SIZE);
+#ifdef _WIN32
+  const int result =
+      _read(file_descriptor_, data_to, static_cast<unsigned int>(read_size));
+#else
+  ssize_t result = read(file_descriptor_, data_to, read_size);
+  while (result == -1 && errno == EINTR) {
+    result = read(file_descriptor_, data_to, read_size);
+  }
+#endif
+
+  return result <= 0 ? 0 : static_cast<std::uint64_t>(result);
+}
+
+MM::Reflection::OStreamSink::OStreamSink(std::ostream& stream)
+    : stream_(stream) {}
+
+bool MM::Reflection::OStreamSink::Write(const void* data_from,
+                                        std::uint64_t size) {
+  stream_.write(static_cast<const char*>(data_from),
+                static_cast<std::streamsize>(size));
+
+  return static_cast<bool>(stream_);
+}
+
+MM::Reflection::IStreamSource::IStreamSource(std::istream& stream)
+    : stream_(stream) {}
+
+std::uint64_t MM::Reflection::IStreamSource::Read(void* data_to,
+                                                  std::uint64_t size) {
+  stream_.read(static_cast<char*>(data_to), static_cast<std::streamsize>(size));
+
+  return static_cast<std::uint64_t>(stream_.gcount());
+}
+
+MM::Reflection::CallbackSink::CallbackSink(CallbackType callback)
+    : callback_(std::move(callback)) {}
+
+bool MM::Reflection::CallbackSink::Write(const void* data_from,
+                                         std::uint64_t size) {
+  return callback_(data_from, size);
+}
+
+MM::Reflection::CallbackSource::CallbackSource(CallbackType callback)
+    : callback_(std::move(callback)) {}
+
+std::uint64_t MM::Reflection::CallbackSource::Read(void* data_to,
+                                                   std::uint64_t size) {
+  return callback_(data_to, size);
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+
+namespace MM {
+namespace Reflection {
+/**
+ * \brief Where a write stream \ref DataBuffer sends its data.
+ */
+class DataSink {
+ public:
+  virtual ~DataSink() = default;
+
+ public:
+  /**
+   * \brief Write all \ref size bytes.
+   * \return Returns false if the bytes cannot be written.
+   */
+  virtual bool Write(const void* data_from, std::uint64_t size) = 0;
+};
+
+/**
+ * \brief Where a read stream \ref DataBuffer gets its data.
+ */
+class DataSource {
+ public:
+  virtual ~DataSource() = default;
+
+ public:
+  /**
+   * \brief Read at most \ref size bytes.
+   * \return Returns the number of bytes read. Returns 0 at the end of the data
+   * or if an error occurs.
+   */
+  virtual std::uint64_t Read(void* data_to, std::uint64_t size) = 0;
+};
+
+/**
+ * \brief Write to a file descriptor.
+ * \remark The file descriptor is not closed.
+ */
+class FileDescriptorSink : public DataSink {
+ public:
+  explicit FileDescriptorSink(int file_descriptor);
+
+ public:
+  bool Write(const void* data_from, std::uint64_t size) override;
+
+ private:
+  int file_descriptor_;
+};
+
+/**
+ * \brief Read from a file descriptor.
+ * \remark The file descriptor is not closed.
+ */
+class FileDescriptorSource : public DataSource {
+ public:
+  explicit FileDescriptorSource(int file_descriptor);
+
+ public:
+  std::uint64_t Read(void* data_to, std::uint64_t size) override;
+
+ private:
+  int file_descriptor_;
+};
+
+/**
+ * \brief Write to a std::ostream.
+ * \remark File streams must be opened with std::ios::binary.
+ */
+class OStreamSink : public DataSink {
+ public:
+  explicit OStreamSink(std::ostream& stream);
+
+ public:
+  bool Write(const void* data_from, std::uint64_t size) override;
+
+ private:
+  std::ostream& stream_;
+};
+
+/**
+ * \brief Read from a std::istream.
+ * \remark File streams must be opened with std::ios::binary.
+ */
+class IStreamSource : public DataSource {
+ public:
+  explicit IStreamSource(std::istream& stream);
+
+ public:
+  std::uint64_t Read(void* data_to, std::uint64_t size) override;
+
+ private:
+  std::istream& stream_;
+};
+
+class CallbackSink : public DataSink {
+ public:
+  using CallbackType = std::function<bool(const void*, std::uint64_t)>;
+
+ public:
+  explicit CallbackSink(CallbackType callback);
+
+ public:
+  bool Write(const void* data_from, std::uint64_t size) override;
+
+ private:
+  CallbackType callback_;
+};
+
+class CallbackSource : public DataSource {
+ public:
+  using CallbackType = std::function<std::uint64_t(void*, std::uint64_t)>;
+
+ public:
+  explicit CallbackSource(CallbackType callback);
+
+ public:
+  std::uint64_t Read(void* data_to, std::uint64_t size) override;
+
+ private:
+  CallbackType callback_;
+};
+}  // namespace Reflection
+}  // namespace MM
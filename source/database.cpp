@@ -3,8 +3,15 @@
 //
 #include "database.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
 #include "meta.h"
 #include "serializer.h"
+#include "type.h"
 
 const std::string& MM::Reflection::GetEmptyString() {
   static std::string empty_string{};
@@ -31,12 +38,121 @@ MM::Reflection::GetMetaDatabase() {
   return g_meta_database.database_;
 }
 
-std::unordered_map<MM::Reflection::TypeID, const MM::Reflection::Type*>&
-MM::Reflection::GetTypeDatabase() {
-  // static std::unordered_map<TypeID, const Type*> g_type_database;
-  static DatabaseWrapper<std::unordered_map<TypeID, const Type*>> g_type_database;
+MM::Reflection::TypeDatabase& MM::Reflection::GetTypeDatabase() {
+  static TypeDatabase g_type_database;
+
+  return g_type_database;
+}
+
+MM::Reflection::TypeDatabase::Table::Table(std::size_t capacity)
+    : capacity_(capacity), slots_(std::make_unique<Slot[]>(capacity)) {}
+
+MM::Reflection::TypeDatabase::TypeDatabase() {
+  tables_.emplace_back(std::make_unique<Table>(256));
+  table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+std::size_t MM::Reflection::TypeDatabase::GetSlotIndex(const TypeID& type_id,
+                                                       std::size_t capacity) {
+  // Fibonacci hashing spreads the hash code over the whole table.
+  const TypeHashCode hash_code = type_id.GetHashCode() * static_cast<TypeHashCode>(0x9E3779B97F4A7C15);
+  return static_cast<std::size_t>(hash_code ^ (hash_code >> 32)) & (capacity - 1);
+}
+
+const MM::Reflection::Type* MM::Reflection::TypeDatabase::FindInTable(
+    const Table& table, const TypeID& type_id) {
+  const std::size_t mask = table.capacity_ - 1;
+  for (std::size_t index = GetSlotIndex(type_id, table.capacity_);; index = (index + 1) & mask) {
+    const Slot& slot = table.slots_[index];
+    const Type* type = slot.type_.load(std::memory_order_acquire);
+    if (type == nullptr) {
+      return nullptr;
+    }
+    if (slot.type_id_ == type_id) {
+      return type;
+    }
+  }
+}
+
+void MM::Reflection::TypeDatabase::InsertToTable(Table& table,
+                                                 const TypeID& type_id,
+                                                 const Type* type) {
+  const std::size_t mask = table.capacity_ - 1;
+  for (std::size_t index = GetSlotIndex(type_id, table.capacity_);; index = (index + 1) & mask) {
+    Slot& slot = table.slots_[index];
+    if (slot.type_.load(std::memory_order_relaxed) == nullptr) {
+      slot.type_id_ = type_id;
+      slot.type_.store(type, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+const MM::Reflection::Type* MM::Reflection::TypeDatabase::Find(
+    const TypeID& type_id) const {
+  return FindInTable(*table_.load(std::memory_order_acquire), type_id);
+}
+
+const MM::Reflection::Type* MM::Reflection::TypeDatabase::Insert(
+    const TypeID& type_id, const Type* type) {
+  assert(type != nullptr);
+  std::lock_guard<std::mutex> guard{insert_mutex_};
+
+  Table* table = table_.load(std::memory_order_relaxed);
+  if (const Type* exist_type = FindInTable(*table, type_id); exist_type != nullptr) {
+    if (exist_type != type && !exist_type->IsSameCppType(*type)) {
+      std::cerr << "[Error] [MMReflection] The type whose hash code is "
+                << type->GetTypeHashCode()
+                << " has the same hash code as another type, probably because "
+                   "the compiler spells both the same." << std::endl;
+      abort();
+    }
+    return exist_type;
+  }
+
+  // Keep the load factor under 1/2 so that probe sequences stay short.
+  if ((size_ + 1) * 2 > table->capacity_) {
+    auto new_table = std::make_unique<Table>(table->capacity_ * 2);
+    for (std::size_t index = 0; index != table->capacity_; ++index) {
+      const Slot& slot = table->slots_[index];
+      const Type* slot_type = slot.type_.load(std::memory_order_relaxed);
+      if (slot_type != nullptr) {
+        InsertToTable(*new_table, slot.type_id_, slot_type);
+      }
+    }
+    table = new_table.get();
+    tables_.emplace_back(std::move(new_table));
+    table_.store(table, std::memory_order_release);
+  }
+
+  InsertToTable(*table, type_id, type);
+  ++size_;
+
+  return type;
+}
+
+std::size_t MM::Reflection::TypeDatabase::GetSize() const {
+  std::lock_guard<std::mutex> guard{insert_mutex_};
+
+  return size_;
+}
+
+std::vector<std::pair<MM::Reflection::TypeID, const MM::Reflection::Type*>>
+MM::Reflection::TypeDatabase::GetAllType() const {
+  std::lock_guard<std::mutex> guard{insert_mutex_};
+
+  std::vector<std::pair<TypeID, const Type*>> result{};
+  result.reserve(size_);
+  const Table* table = table_.load(std::memory_order_relaxed);
+  for (std::size_t index = 0; index != table->capacity_; ++index) {
+    const Slot& slot = table->slots_[index];
+    const Type* type = slot.type_.load(std::memory_order_relaxed);
+    if (type != nullptr) {
+      result.emplace_back(slot.type_id_, type);
+    }
+  }
 
-  return g_type_database.database_;
+  return result;
 }
 
 bool MM::Reflection::TypeID::operator==(const TypeID& other) const {
@@ -91,6 +207,14 @@ MM::Reflection::GetNameToTypeHashDatabase() {
   return name_to_type_hash_data_base;
 }
 
+std::unordered_map<MM::Reflection::TypeHashCode, const MM::Reflection::TypeHashCode>&
+MM::Reflection::GetNameHashToTypeHashDatabase() {
+  static std::unordered_map<TypeHashCode, const TypeHashCode>
+      name_hash_to_type_hash_data_base{};
+
+  return name_hash_to_type_hash_data_base;
+}
+
 std::unordered_map<std::string, MM::Reflection::SerializerBase*>&
 MM::Reflection::GetSerializerDatabase() {
   static DatabaseWrapper<std::unordered_map<std::string, SerializerBase*>> g_serializer_database;
@@ -102,3 +226,187 @@ MM::Reflection::TypeHashCode std::hash<MM::Reflection::TypeID>::operator()(
     const MM::Reflection::TypeID& other) const noexcept {
   return other.GetHashCode();
 }
+
+namespace {
+template<typename KeyType, typename ValueType>
+struct FlatTable {
+  std::vector<KeyType> keys_{};
+  std::vector<ValueType> values_{};
+
+  template<typename MapType>
+  void Build(const MapType& database) {
+    std::vector<std::pair<KeyType, ValueType>> elements(database.begin(), database.end());
+    std::sort(elements.begin(), elements.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.first < rhs.first;
+    });
+    keys_.clear();
+    values_.clear();
+    keys_.reserve(elements.size());
+    values_.reserve(elements.size());
+    for (auto& element : elements) {
+      keys_.emplace_back(element.first);
+      values_.emplace_back(element.second);
+    }
+  }
+
+  const ValueType* Find(const KeyType& key) const {
+    auto iter = std::lower_bound(keys_.begin(), keys_.end(), key);
+    if (iter == keys_.end() || !(*iter == key)) {
+      return nullptr;
+    }
+    return &values_[iter - keys_.begin()];
+  }
+};
+
+/**
+ * \brief Names are sorted by their hash first, so a lookup compares integers
+ * and only compares the string of the matching entries.
+ */
+template<typename ValueType>
+struct FlatNameTable {
+  std::vector<std::size_t> name_hashes_{};
+  std::vector<std::string> names_{};
+  std::vector<ValueType> values_{};
+
+  template<typename MapType>
+  void Build(const MapType& database) {
+    std::vector<std::pair<std::size_t, typename MapType::const_iterator>> elements{};
+    elements.reserve(database.size());
+    for (auto iter = database.begin(); iter != database.end(); ++iter) {
+      elements.emplace_back(std::hash<std::string>{}(iter->first), iter);
+    }
+    std::sort(elements.begin(), elements.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second->first < rhs.second->first);
+    });
+    name_hashes_.clear();
+    names_.clear();
+    values_.clear();
+    name_hashes_.reserve(elements.size());
+    names_.reserve(elements.size());
+    values_.reserve(elements.size());
+    for (auto& element : elements) {
+      name_hashes_.emplace_back(element.first);
+      names_.emplace_back(element.second->first);
+      values_.emplace_back(element.second->second);
+    }
+  }
+
+  const ValueType* Find(const std::string& name) const {
+    const std::size_t name_hash = std::hash<std::string>{}(name);
+    auto iter = std::lower_bound(name_hashes_.begin(), name_hashes_.end(), name_hash);
+    for (; iter != name_hashes_.end() && *iter == name_hash; ++iter) {
+      const std::size_t index = iter - name_hashes_.begin();
+      if (names_[index] == name) {
+        return &values_[index];
+      }
+    }
+    return nullptr;
+  }
+};
+
+struct FrozenTables {
+  FlatTable<MM::Reflection::TypeHashCode, MM::Reflection::Meta*> meta_table_{};
+  FlatNameTable<MM::Reflection::TypeHashCode> name_table_{};
+  FlatTable<MM::Reflection::TypeHashCode, MM::Reflection::TypeHashCode> name_hash_table_{};
+  FlatNameTable<MM::Reflection::SerializerBase*> serializer_table_{};
+};
+
+/**
+ * \brief The flat tables are built aside and published with a release store,
+ * so lookups never see tables that are being built. Replaced tables are
+ * retained until the program ends, because a lookup may still read them.
+ */
+struct FrozenRegistry {
+  std::atomic<const FrozenTables*> tables_{nullptr};
+  std::vector<std::unique_ptr<FrozenTables>> all_tables_{};
+};
+
+FrozenRegistry& GetFrozenRegistry() {
+  static FrozenRegistry g_frozen_registry{};
+
+  return g_frozen_registry;
+}
+
+const FrozenTables* GetFrozenTables() {
+  return GetFrozenRegistry().tables_.load(std::memory_order_acquire);
+}
+}  // namespace
+
+void MM::Reflection::FreezeRegistry() {
+  FrozenRegistry& frozen_registry = GetFrozenRegistry();
+
+  auto tables = std::make_unique<FrozenTables>();
+  tables->meta_table_.Build(GetMetaDatabase());
+  tables->name_table_.Build(GetNameToTypeHashDatabase());
+  tables->name_hash_table_.Build(GetNameHashToTypeHashDatabase());
+  tables->serializer_table_.Build(GetSerializerDatabase());
+
+  frozen_registry.tables_.store(tables.get(), std::memory_order_release);
+  frozen_registry.all_tables_.emplace_back(std::move(tables));
+}
+
+void MM::Reflection::UnfreezeRegistry() {
+  GetFrozenRegistry().tables_.store(nullptr, std::memory_order_release);
+}
+
+bool MM::Reflection::IsRegistryFrozen() {
+  return GetFrozenTables() != nullptr;
+}
+
+MM::Reflection::Meta* MM::Reflection::FindMeta(TypeHashCode type_hash_code) {
+  if (const FrozenTables* frozen_tables = GetFrozenTables()) {
+    Meta* const* meta = frozen_tables->meta_table_.Find(type_hash_code);
+    return meta != nullptr ? *meta : nullptr;
+  }
+
+  auto& meta_database = GetMetaDatabase();
+  auto meta_iter = meta_database.find(type_hash_code);
+  if (meta_iter == meta_database.end()) {
+    return nullptr;
+  }
+  return meta_iter->second;
+}
+
+const MM::Reflection::Type* MM::Reflection::FindType(const TypeID& type_id) {
+  return GetTypeDatabase().Find(type_id);
+}
+
+const MM::Reflection::TypeHashCode* MM::Reflection::FindTypeHashCode(const std::string& type_name) {
+  if (const FrozenTables* frozen_tables = GetFrozenTables()) {
+    return frozen_tables->name_table_.Find(type_name);
+  }
+
+  auto& name_to_type_hash_database = GetNameToTypeHashDatabase();
+  auto name_iter = name_to_type_hash_database.find(type_name);
+  if (name_iter == name_to_type_hash_database.end()) {
+    return nullptr;
+  }
+  return &name_iter->second;
+}
+
+const MM::Reflection::TypeHashCode* MM::Reflection::FindTypeHashCodeByNameHash(TypeHashCode type_name_hash) {
+  if (const FrozenTables* frozen_tables = GetFrozenTables()) {
+    return frozen_tables->name_hash_table_.Find(type_name_hash);
+  }
+
+  auto& name_hash_to_type_hash_database = GetNameHashToTypeHashDatabase();
+  auto name_hash_iter = name_hash_to_type_hash_database.find(type_name_hash);
+  if (name_hash_iter == name_hash_to_type_hash_database.end()) {
+    return nullptr;
+  }
+  return &name_hash_iter->second;
+}
+
+MM::Reflection::SerializerBase* MM::Reflection::FindSerializer(const std::string& serializer_name) {
+  if (const FrozenTables* frozen_tables = GetFrozenTables()) {
+    SerializerBase* const* serializer = frozen_tables->serializer_table_.Find(serializer_name);
+    return serializer != nullptr ? *serializer : nullptr;
+  }
+
+  auto& serializer_database = GetSerializerDatabase();
+  auto serializer_iter = serializer_database.find(serializer_name);
+  if (serializer_iter == serializer_database.end()) {
+    return nullptr;
+  }
+  return serializer_iter->second;
+}
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace MM{
 namespace Reflection {
@@ -29,9 +34,84 @@ struct TypeID {
   TypeHashCode GetHashCode() const;
 };
 
+/**
+ * \brief Insert-only open addressing table of all created types.
+ * \remark \ref Find is wait-free and can run concurrently with \ref Insert.
+ * Writers are serialized by a mutex. A slot publishes its type pointer with a
+ * release store after its key has been written, so a reader that observes a
+ * non-null type pointer also observes the key. When the table grows, the old
+ * table is retained until the database is destroyed, so readers that still hold
+ * it never touch freed memory.
+ */
+class TypeDatabase {
+ public:
+  TypeDatabase();
+  ~TypeDatabase() = default;
+  TypeDatabase(const TypeDatabase& other) = delete;
+  TypeDatabase(TypeDatabase&& other) = delete;
+  TypeDatabase& operator=(const TypeDatabase& other) = delete;
+  TypeDatabase& operator=(TypeDatabase&& other) = delete;
+
+ public:
+  /**
+   * \brief Find the type whose id is \ref type_id.
+   * \return Returns the type, or nullptr if the type has not been inserted.
+   */
+  const Type* Find(const TypeID& type_id) const;
+
+  /**
+   * \brief Insert \ref type with the id \ref type_id.
+   * \param type The type to be inserted, it must outlive the database.
+   * \return Returns the type stored in the database.
+   * \remark If the same id was inserted before (for example by another thread
+   * or another module), the existing type is returned. If it was inserted by
+   * a different C++ type whose name is spelled the same, the program aborts
+   * instead of returning the type of the other one.
+   */
+  const Type* Insert(const TypeID& type_id, const Type* type);
+
+  std::size_t GetSize() const;
+
+  std::vector<std::pair<TypeID, const Type*>> GetAllType() const;
+
+ private:
+  struct Slot {
+    TypeID type_id_{};
+    std::atomic<const Type*> type_{nullptr};
+  };
+
+  struct Table {
+    explicit Table(std::size_t capacity);
+
+    std::size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+  };
+
+  static std::size_t GetSlotIndex(const TypeID& type_id, std::size_t capacity);
+
+  static const Type* FindInTable(const Table& table, const TypeID& type_id);
+
+  static void InsertToTable(Table& table, const TypeID& type_id, const Type* type);
+
+ private:
+  std::atomic<Table*> table_{nullptr};
+  std::vector<std::unique_ptr<Table>> tables_{};
+  std::size_t size_{0};
+  mutable std::mutex insert_mutex_{};
+};
+
 std::unordered_map<std::string, const TypeHashCode>&
 GetNameToTypeHashDatabase();
 
+/**
+ * \brief The Database that maps the hash of a registered type name (see
+ * \ref Utils::HashString) to the type hash code.
+ * \remark The name hash is stable between runs and compilers, so it is used
+ * to identify types in serialized data.
+ */
+std::unordered_map<TypeHashCode, const TypeHashCode>&
+GetNameHashToTypeHashDatabase();
+
 std::unordered_map<std::string, SerializerBase*>& GetSerializerDatabase();
 
 /**
@@ -39,7 +119,76 @@ std::unordered_map<std::string, SerializerBase*>& GetSerializerDatabase();
  */
 std::unordered_map<TypeHashCode, Meta*>& GetMetaDatabase();
 
-std::unordered_map<TypeID, const Type*>& GetTypeDatabase();
+/**
+ * \brief The Database of all created types.
+ * \remark It is safe to use from multiple threads.
+ */
+TypeDatabase& GetTypeDatabase();
+
+/**
+ * \brief Compact the meta, name, name hash and serializer databases into flat
+ * sorted tables.
+ * \remark Call it once after all \ref MM_REGISTER blocks have run (for
+ * example at the beginning of main). Subsequent lookups through \ref FindMeta,
+ * \ref FindTypeHashCode, \ref FindTypeHashCodeByNameHash and
+ * \ref FindSerializer only binary search the flat tables, a miss does not
+ * fall back to the original databases. The type database is already a flat
+ * table and is not affected.
+ * \remark Registering a new type or serializer after freezing is still
+ * allowed. It builds new flat tables and publishes them with one atomic store,
+ * and the replaced tables are kept until the program ends, so it should be
+ * rare.
+ * \remark Lookups can run concurrently with this function, but registration
+ * and other calls of this function or \ref UnfreezeRegistry cannot.
+ */
+void FreezeRegistry();
+
+/**
+ * \brief Make lookups use the original databases again, as before
+ * \ref FreezeRegistry.
+ * \remark The same threading rules as \ref FreezeRegistry apply.
+ */
+void UnfreezeRegistry();
+
+/**
+ * \brief Determine whether \ref FreezeRegistry has been called.
+ * \return Returns true if the registry is frozen, otherwise returns false.
+ */
+bool IsRegistryFrozen();
+
+/**
+ * \brief Find the metadata of the type whose hash code is \ref type_hash_code.
+ * \return Returns the metadata, or nullptr if the type is not registered.
+ */
+Meta* FindMeta(TypeHashCode type_hash_code);
+
+/**
+ * \brief Find the type whose id is \ref type_id.
+ * \return Returns the type, or nullptr if the type has not been created yet.
+ */
+const Type* FindType(const TypeID& type_id);
+
+/**
+ * \brief Find the hash code of the type registered as \ref type_name.
+ * \return Returns a pointer to the hash code, or nullptr if no type is
+ * registered under that name.
+ */
+const TypeHashCode* FindTypeHashCode(const std::string& type_name);
+
+/**
+ * \brief Find the hash code of the type whose registered name hashes to
+ * \ref type_name_hash.
+ * \return Returns a pointer to the hash code, or nullptr if no type is
+ * registered under that name.
+ */
+const TypeHashCode* FindTypeHashCodeByNameHash(TypeHashCode type_name_hash);
+
+/**
+ * \brief Find the serializer registered as \ref serializer_name.
+ * \return Returns the serializer, or nullptr if no serializer is registered
+ * under that name.
+ */
+SerializerBase* FindSerializer(const std::string& serializer_name);
 
 }  // namespace Reflection
 }
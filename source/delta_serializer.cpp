@@ -0,0 +1,182 @@
+#include "delta_serializer.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "serialization_plan.h"
+
+namespace {
+// Holds the full data of the object while it is written or read, so that
+// each call does not allocate.
+thread_local MM::Reflection::DataBuffer g_delta_stream{};
+// Holds the header and the bitmap of the object while it is read.
+thread_local std::vector<std::uint8_t> g_delta_prefix{};
+}  // namespace
+
+MM::Reflection::DataBuffer& MM::Reflection::SerializeDelta(
+    DataBuffer& data_buffer, Variable& variable) {
+  const Meta* meta = variable.GetMeta();
+  if (meta == nullptr) {
+    return Serialize(data_buffer, variable);
+  }
+  const std::shared_ptr<const SerializationPlan> plan =
+      meta->GetSchemaSerializationPlan();
+  const std::vector<std::uint8_t>& empty_stream = plan->GetEmptyStream();
+  void* object = SerializerBase::GetVariableValuePtr(variable);
+  if (!plan->IsValid() || empty_stream.empty() ||
+      plan->HaveNullPointer(object)) {
+    return Serialize(data_buffer, variable);
+  }
+  // The bytes outside of the registered properties (such as a trivial type
+  // without properties) cannot be written.
+  const std::vector<SerializationPlan::PropertyLocation>& property_locations =
+      plan->GetPropertyLocations();
+  std::uint64_t property_size = 0;
+  for (const SerializationPlan::PropertyLocation& property_location :
+       property_locations) {
+    property_size += property_location.size_;
+  }
+  if (property_size != plan->GetSerializedSize()) {
+    return Serialize(data_buffer, variable);
+  }
+
+  g_delta_stream.Clear();
+  plan->Serialize(g_delta_stream, object);
+  const auto* stream =
+      static_cast<const std::uint8_t*>(g_delta_stream.GetData());
+
+  DeltaHeader header{};
+  header.property_number_ =
+      static_cast<std::uint32_t>(property_locations.size());
+  header.type_name_hash_ = plan->GetTypeNameHash();
+  header.serialized_size_ =
+      static_cast<std::uint32_t>(plan->GetSerializedSize());
+  header.is_refrence_ = variable.IsPropertyVariable()
+                            ? (variable.GetPropertyRealType()->IsReference() ||
+                               variable.GetPropertyRealType()->IsPointer())
+                            : (variable.GetType()->IsReference() ||
+                               variable.GetType()->IsPointer());
+  data_buffer.AddData(&header, sizeof(DeltaHeader));
+
+  const std::uint64_t bitmap_size = (property_locations.size() + 7) / 8;
+  std::uint8_t bitmap[8]{};
+  std::vector<std::uint8_t> large_bitmap{};
+  std::uint8_t* bitmap_data = bitmap;
+  if (bitmap_size > sizeof(bitmap)) {
+    large_bitmap.resize(bitmap_size);
+    bitmap_data = large_bitmap.data();
+  }
+  for (std::size_t index = 0; index != property_locations.size(); ++index) {
+    const SerializationPlan::PropertyLocation& property_location =
+        property_locations[index];
+    if (std::memcmp(stream + property_location.stream_offset_,
+                    empty_stream.data() + property_location.stream_offset_,
+                    property_location.size_) != 0) {
+      bitmap_data[index / 8] |= static_cast<std::uint8_t>(1u << (index % 8));
+    }
+  }
+  if (bitmap_size != 0) {
+    data_buffer.AddData(bitmap_data, bitmap_size);
+  }
+
+  for (std::size_t index = 0; index != property_locations.size(); ++index) {
+    const SerializationPlan::PropertyLocation& property_location =
+        property_locations[index];
+    if ((bitmap_data[index / 8] & (1u << (index % 8))) != 0 &&
+        property_location.size_ != 0) {
+      data_buffer.AddData(stream + property_location.stream_offset_,
+                          property_location.size_);
+    }
+  }
+
+  return data_buffer;
+}
+
+MM::Reflection::Variable MM::Reflection::DeserializeDelta(
+    const DataBuffer& data_buffer) {
+  if (!data_buffer.CanReadData(sizeof(DeltaHeader))) {
+    std::cerr << "[Error] [MMReflection] The data is too small to hold a delta "
+                 "header.\n";
+    return Variable{};
+  }
+  // Nothing is read until the whole record is known to be readable, so a
+  // record that cannot be read is left in place.
+  DeltaHeader header{};
+  data_buffer.PeekData(&header, sizeof(DeltaHeader));
+  const std::uint64_t bitmap_size = (header.property_number_ + 7) / 8;
+
+  const TypeHashCode* type_hash_code =
+      FindTypeHashCodeByNameHash(header.type_name_hash_);
+  const Meta* meta =
+      type_hash_code == nullptr ? nullptr : FindMeta(*type_hash_code);
+  std::shared_ptr<const SerializationPlan> plan{};
+  if (meta != nullptr) {
+    plan = meta->GetSchemaSerializationPlan();
+  }
+  if (plan == nullptr || !plan->IsValid() || plan->GetEmptyStream().empty() ||
+      plan->GetPropertyLocations().size() != header.property_number_ ||
+      plan->GetSerializedSize() != header.serialized_size_) {
+    std::cerr << "[Error] [MMReflection] The type of the delta (type name hash "
+              << header.type_name_hash_
+              << ") is not registered, cannot be read or its properties "
+                 "changed.\n";
+    return Variable{};
+  }
+
+  const std::uint64_t prefix_size = sizeof(DeltaHeader) + bitmap_size;
+  if (!data_buffer.CanReadData(prefix_size)) {
+    std::cerr << "[Error] [MMReflection] The bitmap of the delta is "
+                 "incomplete.\n";
+    return Variable{};
+  }
+  g_delta_prefix.resize(prefix_size);
+  data_buffer.PeekData(g_delta_prefix.data(), prefix_size);
+  const std::uint8_t* bitmap_data = g_delta_prefix.data() + sizeof(DeltaHeader);
+  const std::vector<SerializationPlan::PropertyLocation>& property_locations =
+      plan->GetPropertyLocations();
+  std::uint64_t data_size = 0;
+  for (std::size_t index = 0; index != property_locations.size(); ++index) {
+    if ((bitmap_data[index / 8] & (1u << (index % 8))) != 0) {
+      data_size += property_locations[index].size_;
+    }
+  }
+  if (!data_buffer.CanReadData(prefix_size + data_size)) {
+    std::cerr << "[Error] [MMReflection] The data of the delta is "
+                 "incomplete.\n";
+    return Variable{};
+  }
+  data_buffer.ReadData(g_delta_prefix.data(), prefix_size);
+
+  // Start from the data of the empty object and replace the properties in the
+  // stream.
+  const std::vector<std::uint8_t>& empty_stream = plan->GetEmptyStream();
+  g_delta_stream.Clear();
+  g_delta_stream.AddData(empty_stream.data(), empty_stream.size());
+  auto* stream = static_cast<std::uint8_t*>(g_delta_stream.GetData());
+  for (std::size_t index = 0; index != property_locations.size(); ++index) {
+    const SerializationPlan::PropertyLocation& property_location =
+        property_locations[index];
+    if ((bitmap_data[index / 8] & (1u << (index % 8))) != 0 &&
+        property_location.size_ != 0) {
+      data_buffer.ReadData(stream + property_location.stream_offset_,
+                           property_location.size_);
+    }
+  }
+
+  Variable variable{};
+  SerializerBase::PreProcessDescriptor(
+      *meta, variable, DeserializerInfo{nullptr, header.is_refrence_ != 0, false});
+  memcpy(variable.GetValue(), meta->GetEmptyVariable().GetValue(),
+         meta->GetType().GetSize());
+  plan->Deserialize(g_delta_stream, variable.GetValue());
+
+  return variable;
+}
+
+MM::Reflection::Variable MM::Reflection::DeserializeDelta(
+    DataBufferReader& reader) {
+  return reader.ReadWithDataBuffer([](const DataBuffer& data_buffer) {
+    return DeserializeDelta(data_buffer);
+  });
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+#include "serializer.h"
+
+namespace MM {
+namespace Reflection {
+/**
+ * \brief The version of the streams written by \ref SerializeDelta.
+ * \remark Like \ref SCHEMA_SERIALIZER_VERSION, it is in the place of
+ * \ref SerializerDescriptor::version_, so \ref Deserialize reads these streams
+ * too.
+ */
+constexpr std::uint32_t DELTA_SERIALIZER_VERSION = STREAM_FORMAT_VERSION_FLAG | 3;
+
+struct DeltaHeader {
+  // Same place as SerializerDescriptor::version_.
+  std::uint32_t version_{DELTA_SERIALIZER_VERSION};
+  std::uint32_t property_number_{0};
+  TypeHashCode type_name_hash_{0};
+  // The size of the data of all properties, to check that the layout of the
+  // type did not change.
+  std::uint32_t serialized_size_{0};
+  std::uint32_t is_refrence_{0};
+};
+
+/**
+ * \brief Write only the properties of \ref variable that differ from the
+ * empty object of its type.
+ * \remark The stream is a \ref DeltaHeader, a bitmap with one bit per
+ * property (in the order of \ref SerializationPlan::GetPropertyLocations),
+ * and then the data of the properties whose bit is set, as
+ * \ref SchemaWriter writes it. Properties are compared with their serialized
+ * bytes, so nested objects are written whole if any byte of them differs.
+ * \remark If the type cannot be written in this format (see
+ * \ref SchemaWriter), or a pointer of its empty object is nullptr, it is
+ * written by \ref Serialize instead. \ref Deserialize reads both.
+ * \remark The stream can only be read while the properties of the type are
+ * the same as when it was written.
+ */
+DataBuffer& SerializeDelta(DataBuffer& data_buffer, Variable& variable);
+
+/**
+ * \brief Read an object written by \ref SerializeDelta.
+ * \return The object. It is invalid if the type is not registered, its
+ * properties changed or the data is incomplete, and then nothing is read.
+ * \remark The properties that are not in the stream keep the value of the
+ * empty object.
+ */
+Variable DeserializeDelta(const DataBuffer& data_buffer);
+
+Variable DeserializeDelta(DataBufferReader& reader);
+}  // namespace Reflection
+}  // namespace MM
@@ -0,0 +1,456 @@
+#include "graph_serializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "serialization_plan.h"
+
+namespace {
+// The ID written for nullptr. The object at index i has the ID i + 1.
+constexpr std::uint32_t NULL_OBJECT_ID = 0;
+
+struct GraphOperation {
+  // Copy size_ bytes if pointee_meta_ is nullptr, or write the ID of the
+  // object that the pointer at object_offset_ points to.
+  std::uint64_t object_offset_{0};
+  std::uint64_t size_{0};
+  const MM::Reflection::Meta* pointee_meta_{nullptr};
+};
+
+/**
+ * \brief The operations that write the data of one type, with nested value
+ * types inline and adjacent copies merged.
+ */
+struct GraphType {
+  std::vector<GraphOperation> operations_{};
+  std::uint64_t serialized_size_{0};
+  bool is_supported_{false};
+};
+
+bool IsTrivialSerializer(const MM::Reflection::Meta& meta) {
+  return meta.GetSerializerName() ==
+         MM::Reflection::TrivialSerializer::GetSerializerNameStatic();
+}
+
+bool IsRecursionSerializer(const MM::Reflection::Meta& meta) {
+  return meta.GetSerializerName() ==
+         MM::Reflection::UnsefeRecursionSerializer::GetSerializerNameStatic();
+}
+
+void AddGraphCopy(GraphType& graph_type, std::uint64_t object_offset,
+                  std::uint64_t size) {
+  if (size == 0) {
+    return;
+  }
+  graph_type.serialized_size_ += size;
+  if (!graph_type.operations_.empty()) {
+    GraphOperation& last = graph_type.operations_.back();
+    if (last.pointee_meta_ == nullptr &&
+        last.object_offset_ + last.size_ == object_offset) {
+      last.size_ += size;
+      return;
+    }
+  }
+  graph_type.operations_.push_back(GraphOperation{object_offset, size, nullptr});
+}
+
+/**
+ * \brief Add the operations of a type that is nested at \ref object_offset.
+ * \return Returns false if the type cannot be written as part of a graph.
+ * \remark Besides the types of the trivial and recursion serializers, types
+ * without a serializer are accepted, because a type that points to itself
+ * cannot pass \ref UnsefeRecursionSerializer::Check. The types that pointers
+ * point to are checked when the objects they point to are written, so this
+ * only recurses into value properties and ends.
+ */
+bool AppendGraphOperations(const MM::Reflection::Meta& meta,
+                           std::uint64_t object_offset, GraphType& graph_type) {
+  if (IsTrivialSerializer(meta)) {
+    AddGraphCopy(graph_type, object_offset, meta.GetType().GetSize());
+    return true;
+  }
+  if ((meta.HaveSerializer() && !IsRecursionSerializer(meta)) ||
+      !meta.HaveEmptyObject()) {
+    return false;
+  }
+
+  std::vector<const MM::Reflection::Property*> properties{};
+  for (const MM::Reflection::Property* property : meta.GetAllProperty()) {
+    if (!property->IsStatic()) {
+      properties.push_back(property);
+    }
+  }
+  std::sort(properties.begin(), properties.end(),
+            [](const MM::Reflection::Property* lhs,
+               const MM::Reflection::Property* rhs) {
+              return lhs->GetPropertyOffset() < rhs->GetPropertyOffset();
+            });
+
+  for (const MM::Reflection::Property* property : properties) {
+    const MM::Reflection::Meta* property_meta = property->GetMeta();
+    if (property_meta == nullptr) {
+      return false;
+    }
+    const std::uint64_t property_offset =
+        object_offset + property->GetPropertyOffset();
+    if (property->GetType()->IsReference() || property->GetType()->IsPointer()) {
+      graph_type.operations_.push_back(
+          GraphOperation{property_offset, sizeof(void*), property_meta});
+      graph_type.serialized_size_ += sizeof(std::uint32_t);
+      continue;
+    }
+    if (!AppendGraphOperations(*property_meta, property_offset, graph_type)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// The types are compiled once per thread and dropped when any meta changes.
+thread_local std::unordered_map<const MM::Reflection::Meta*, GraphType>
+    g_graph_types{};
+thread_local std::uint64_t g_graph_types_generation{0};
+
+const GraphType& GetGraphType(const MM::Reflection::Meta& meta) {
+  const std::uint64_t generation =
+      MM::Reflection::SerializationPlan::GetCurrentGeneration();
+  if (g_graph_types_generation != generation) {
+    g_graph_types.clear();
+    g_graph_types_generation = generation;
+  }
+
+  auto graph_type = g_graph_types.find(&meta);
+  if (graph_type != g_graph_types.end()) {
+    return graph_type->second;
+  }
+
+  GraphType new_graph_type{};
+  new_graph_type.is_supported_ = AppendGraphOperations(meta, 0, new_graph_type);
+
+  return g_graph_types.emplace(&meta, std::move(new_graph_type)).first->second;
+}
+
+struct GraphObjectKey {
+  const void* address_{nullptr};
+  const MM::Reflection::Meta* meta_{nullptr};
+
+  friend bool operator==(const GraphObjectKey& lhs, const GraphObjectKey& rhs) {
+    return lhs.address_ == rhs.address_ && lhs.meta_ == rhs.meta_;
+  }
+};
+
+struct GraphObjectKeyHash {
+  std::size_t operator()(const GraphObjectKey& key) const {
+    return std::hash<const void*>{}(key.address_) ^
+           (std::hash<const void*>{}(key.meta_) << 1);
+  }
+};
+
+/**
+ * \brief Collect the objects of a graph and write their data.
+ */
+class GraphWriter {
+ public:
+  void AddRootObject(const void* address, const MM::Reflection::Meta& meta) {
+    GetObjectID(address, &meta);
+  }
+
+  /**
+   * \brief Write the data of the objects, adding the objects that they point
+   * to.
+   * \return Returns false if a type in the graph cannot be written.
+   */
+  bool WriteObjects(MM::Reflection::DataBuffer& data_buffer) {
+    // objects_ grows while the objects found so far are written.
+    for (std::size_t index = 0; index != objects_.size(); ++index) {
+      const GraphObjectKey object = objects_[index];
+      const GraphType& graph_type = GetGraphType(*object.meta_);
+      if (!graph_type.is_supported_) {
+        return false;
+      }
+      if (graph_type.serialized_size_ == 0) {
+        continue;
+      }
+
+      auto* stream = static_cast<std::uint8_t*>(
+          data_buffer.AddEmptyData(graph_type.serialized_size_));
+      const auto* object_bytes = static_cast<const std::uint8_t*>(object.address_);
+      for (const GraphOperation& operation : graph_type.operations_) {
+        if (operation.pointee_meta_ == nullptr) {
+          std::memcpy(stream, object_bytes + operation.object_offset_,
+                      operation.size_);
+          stream += operation.size_;
+          continue;
+        }
+        const void* pointee = nullptr;
+        std::memcpy(&pointee, object_bytes + operation.object_offset_,
+                    sizeof(void*));
+        const std::uint32_t object_id =
+            GetObjectID(pointee, operation.pointee_meta_);
+        std::memcpy(stream, &object_id, sizeof(std::uint32_t));
+        stream += sizeof(std::uint32_t);
+      }
+    }
+
+    return true;
+  }
+
+  const std::vector<GraphObjectKey>& GetObjects() const { return objects_; }
+
+  const std::vector<const MM::Reflection::Meta*>& GetTypes() const {
+    return types_;
+  }
+
+  const std::vector<std::uint32_t>& GetObjectTypes() const {
+    return object_types_;
+  }
+
+ private:
+  std::uint32_t GetObjectID(const void* address,
+                            const MM::Reflection::Meta* meta) {
+    if (address == nullptr) {
+      return NULL_OBJECT_ID;
+    }
+
+    const auto result = object_ids_.emplace(
+        GraphObjectKey{address, meta},
+        static_cast<std::uint32_t>(objects_.size() + 1));
+    if (result.second) {
+      objects_.push_back(GraphObjectKey{address, meta});
+      const auto type_index = type_indexes_.emplace(
+          meta, static_cast<std::uint32_t>(types_.size()));
+      if (type_index.second) {
+        types_.push_back(meta);
+      }
+      object_types_.push_back(type_index.first->second);
+    }
+
+    return result.first->second;
+  }
+
+ private:
+  std::vector<GraphObjectKey> objects_{};
+  std::unordered_map<GraphObjectKey, std::uint32_t, GraphObjectKeyHash>
+      object_ids_{};
+  std::vector<const MM::Reflection::Meta*> types_{};
+  std::unordered_map<const MM::Reflection::Meta*, std::uint32_t>
+      type_indexes_{};
+  std::vector<std::uint32_t> object_types_{};
+};
+
+// Holds the data of the objects while the tables are collected, so that each
+// call does not allocate.
+thread_local MM::Reflection::DataBuffer g_graph_stream{};
+// Holds the data of an object that is split between segments.
+thread_local std::vector<std::uint8_t> g_graph_object_data{};
+
+// Write a variable that cannot be written as a graph by its own serializer.
+MM::Reflection::DataBuffer& SerializeWithoutGraph(
+    MM::Reflection::DataBuffer& data_buffer, MM::Reflection::Variable& variable,
+    const MM::Reflection::Meta& meta) {
+  if (!meta.HaveSerializer()) {
+    std::cerr << "[Error] [MMReflection] The type named " << meta.GetTypeName()
+              << " has no serializer and cannot be written as a graph.\n";
+    return data_buffer;
+  }
+
+  return MM::Reflection::Serialize(data_buffer, variable);
+}
+
+const MM::Reflection::Meta* FindGraphMeta(
+    MM::Reflection::TypeHashCode type_name_hash) {
+  const MM::Reflection::TypeHashCode* type_hash_code =
+      MM::Reflection::FindTypeHashCodeByNameHash(type_name_hash);
+  return type_hash_code == nullptr ? nullptr
+                                   : MM::Reflection::FindMeta(*type_hash_code);
+}
+}  // namespace
+
+MM::Reflection::DataBuffer& MM::Reflection::SerializeGraph(
+    DataBuffer& data_buffer, Variable& variable) {
+  const Meta* meta = variable.GetMeta();
+  if (meta == nullptr) {
+    return Serialize(data_buffer, variable);
+  }
+  if (!meta->HaveEmptyObject()) {
+    return SerializeWithoutGraph(data_buffer, variable, *meta);
+  }
+
+  const void* object = SerializerBase::GetVariableValuePtr(variable);
+  if (object == nullptr) {
+    return SerializeWithoutGraph(data_buffer, variable, *meta);
+  }
+
+  GraphWriter graph_writer{};
+  graph_writer.AddRootObject(object, *meta);
+  g_graph_stream.Clear();
+  if (!graph_writer.WriteObjects(g_graph_stream)) {
+    return SerializeWithoutGraph(data_buffer, variable, *meta);
+  }
+
+  GraphHeader header{};
+  header.type_number_ =
+      static_cast<std::uint32_t>(graph_writer.GetTypes().size());
+  header.object_number_ =
+      static_cast<std::uint32_t>(graph_writer.GetObjects().size());
+  header.is_refrence_ = variable.IsPropertyVariable()
+                            ? (variable.GetPropertyRealType()->IsReference() ||
+                               variable.GetPropertyRealType()->IsPointer())
+                            : (variable.GetType()->IsReference() ||
+                               variable.GetType()->IsPointer());
+  data_buffer.AddData(&header, sizeof(GraphHeader));
+  for (const Meta* type_meta : graph_writer.GetTypes()) {
+    const TypeHashCode type_name_hash =
+        Utils::HashString(type_meta->GetTypeName());
+    data_buffer.AddData(&type_name_hash, sizeof(TypeHashCode));
+  }
+  data_buffer.AddData(graph_writer.GetObjectTypes().data(),
+                      graph_writer.GetObjectTypes().size() *
+                          sizeof(std::uint32_t));
+  if (g_graph_stream.GetAddDataOffset() != 0) {
+    data_buffer.AddData(g_graph_stream.GetData(), g_graph_stream.GetAddDataOffset());
+  }
+
+  return data_buffer;
+}
+
+MM::Reflection::Variable MM::Reflection::DeserializeGraph(
+    const DataBuffer& data_buffer) {
+  if (!data_buffer.CanReadData(sizeof(GraphHeader))) {
+    std::cerr << "[Error] [MMReflection] The data is too small to hold a graph "
+                 "header.\n";
+    return Variable{};
+  }
+  GraphHeader header{};
+  data_buffer.ReadData(&header, sizeof(GraphHeader));
+  if (header.type_number_ == 0 || header.object_number_ == 0 ||
+      !data_buffer.CanReadData(
+          header.type_number_ * static_cast<std::uint64_t>(sizeof(TypeHashCode)) +
+          header.object_number_ *
+              static_cast<std::uint64_t>(sizeof(std::uint32_t)))) {
+    std::cerr << "[Error] [MMReflection] The tables of the graph are "
+                 "incomplete.\n";
+    return Variable{};
+  }
+
+  // The types are copied, because the cache of this thread is cleared when a
+  // meta changes.
+  std::vector<const Meta*> metas(header.type_number_, nullptr);
+  std::vector<GraphType> graph_types(header.type_number_);
+  for (std::uint32_t index = 0; index != header.type_number_; ++index) {
+    TypeHashCode type_name_hash{0};
+    data_buffer.ReadData(&type_name_hash, sizeof(TypeHashCode));
+    metas[index] = FindGraphMeta(type_name_hash);
+    if (metas[index] != nullptr) {
+      graph_types[index] = GetGraphType(*metas[index]);
+    }
+    if (!graph_types[index].is_supported_) {
+      std::cerr << "[Error] [MMReflection] The type of the graph (type name "
+                   "hash "
+                << type_name_hash
+                << ") is not registered or cannot be read.\n";
+      return Variable{};
+    }
+  }
+
+  std::vector<std::uint32_t> object_types(header.object_number_, 0);
+  data_buffer.ReadData(object_types.data(),
+                       object_types.size() * sizeof(std::uint32_t));
+  std::uint64_t data_size = 0;
+  for (const std::uint32_t object_type : object_types) {
+    if (object_type >= header.type_number_) {
+      std::cerr << "[Error] [MMReflection] The graph has an object of type "
+                << object_type << ", but only " << header.type_number_
+                << " types.\n";
+      return Variable{};
+    }
+    data_size += graph_types[object_type].serialized_size_;
+  }
+  if (!metas[object_types[0]]->HaveEmptyObject() ||
+      !data_buffer.CanReadData(data_size)) {
+    std::cerr << "[Error] [MMReflection] The data of the graph is incomplete "
+                 "or its properties changed.\n";
+    return Variable{};
+  }
+
+  // Allocate every object first, so that pointers to objects later in the
+  // graph can be patched while the objects are read.
+  Variable variable{};
+  std::vector<std::uint8_t*> objects(header.object_number_, nullptr);
+  for (std::uint32_t index = 0; index != header.object_number_; ++index) {
+    const Meta& meta = *metas[object_types[index]];
+    if (index == 0) {
+      SerializerBase::PreProcessDescriptor(
+          meta, variable,
+          DeserializerInfo{nullptr, header.is_refrence_ != 0, false});
+      objects[index] = static_cast<std::uint8_t*>(variable.GetValue());
+    } else {
+      objects[index] = static_cast<std::uint8_t*>(
+          SerializerBase::AllocateRefrenceObject(meta.GetType().GetSize()));
+    }
+    if (meta.HaveEmptyObject()) {
+      std::memcpy(objects[index], meta.GetEmptyVariable().GetValue(),
+                  meta.GetType().GetSize());
+    }
+  }
+
+  for (std::uint32_t index = 0; index != header.object_number_; ++index) {
+    const GraphType& graph_type = graph_types[object_types[index]];
+    if (graph_type.serialized_size_ == 0) {
+      continue;
+    }
+    const auto* stream = static_cast<const std::uint8_t*>(
+        data_buffer.PeekDataInPlace(graph_type.serialized_size_));
+    if (stream != nullptr) {
+      data_buffer.ReadDataInPlace(graph_type.serialized_size_);
+    } else {
+      g_graph_object_data.resize(graph_type.serialized_size_);
+      data_buffer.ReadData(g_graph_object_data.data(),
+                           graph_type.serialized_size_);
+      stream = g_graph_object_data.data();
+    }
+
+    std::uint8_t* object = objects[index];
+    for (const GraphOperation& operation : graph_type.operations_) {
+      if (operation.pointee_meta_ == nullptr) {
+        std::memcpy(object + operation.object_offset_, stream, operation.size_);
+        stream += operation.size_;
+        continue;
+      }
+      std::uint32_t object_id = NULL_OBJECT_ID;
+      std::memcpy(&object_id, stream, sizeof(std::uint32_t));
+      stream += sizeof(std::uint32_t);
+      void* pointee = nullptr;
+      if (object_id != NULL_OBJECT_ID) {
+        if (object_id > header.object_number_ ||
+            metas[object_types[object_id - 1]] != operation.pointee_meta_) {
+          std::cerr << "[Error] [MMReflection] The graph has a pointer to the "
+                       "object "
+                    << object_id << " of another type or out of the graph.\n";
+          // The root object is owned by variable unless it is a refrence.
+          for (std::uint32_t object_index = header.is_refrence_ != 0 ? 0 : 1;
+               object_index != header.object_number_; ++object_index) {
+            SerializerBase::FreeRefrenceObject(objects[object_index]);
+          }
+          return Variable{};
+        }
+        pointee = objects[object_id - 1];
+      }
+      std::memcpy(object + operation.object_offset_, &pointee, sizeof(void*));
+    }
+  }
+
+  return variable;
+}
+
+MM::Reflection::Variable MM::Reflection::DeserializeGraph(
+    DataBufferReader& reader) {
+  return reader.ReadWithDataBuffer([](const DataBuffer& data_buffer) {
+    return DeserializeGraph(data_buffer);
+  });
+}
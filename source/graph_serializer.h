@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+#include "serializer.h"
+
+namespace MM {
+namespace Reflection {
+/**
+ * \brief The version of the streams written by \ref SerializeGraph.
+ * \remark It is in the place of \ref SerializerDescriptor::version_, so
+ * \ref Deserialize reads these streams too.
+ */
+constexpr std::uint32_t GRAPH_SERIALIZER_VERSION = STREAM_FORMAT_VERSION_FLAG | 5;
+
+struct GraphHeader {
+  // Same place as SerializerDescriptor::version_.
+  std::uint32_t version_{GRAPH_SERIALIZER_VERSION};
+  std::uint32_t type_number_{0};
+  std::uint32_t object_number_{0};
+  std::uint32_t is_refrence_{0};
+};
+
+/**
+ * \brief Write \ref variable and every object reachable through its pointer
+ * and refrence properties, each object once.
+ * \remark Every distinct object (address and type) gets an ID, and pointer
+ * and refrence properties are written as the ID of the object they point to
+ * (0 for nullptr). So objects shared by several pointers are written once and
+ * cycles end.
+ * \remark The stream is a \ref GraphHeader, the type name hashes of the
+ * types in the graph, the type index of each object, and then the data of
+ * each object, with the root object first. The data of an object is the data
+ * of its properties ordered by offset, with nested value types inline.
+ * \remark Pointers into the middle of another object are written as
+ * separate objects.
+ * \remark Types that use the \ref TrivialSerializer or the
+ * \ref UnsefeRecursionSerializer are accepted, and so are types without a
+ * serializer that have an empty object and registered properties. So a type
+ * that points to itself, which the \ref UnsefeRecursionSerializer refuses,
+ * can be written by this.
+ * \remark If a type in the graph is not accepted, or the root type has no
+ * empty object, \ref variable is written by \ref Serialize instead.
+ * \ref Deserialize reads both. If the root type has no serializer either,
+ * nothing is written.
+ */
+DataBuffer& SerializeGraph(DataBuffer& data_buffer, Variable& variable);
+
+/**
+ * \brief Read a graph written by \ref SerializeGraph.
+ * \return The root object. It is invalid if a type of the graph is not
+ * registered or its properties changed.
+ * \remark Each object is allocated once (see
+ * \ref SerializerBase::AllocateRefrenceObject), so pointers that shared an
+ * object still share one.
+ */
+Variable DeserializeGraph(const DataBuffer& data_buffer);
+
+Variable DeserializeGraph(DataBufferReader& reader);
+}  // namespace Reflection
+}  // namespace MM
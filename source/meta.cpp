@@ -2,8 +2,30 @@
 
 #include <set>
 
+#include "serialization_plan.h"
 #include "serializer.h"
 
+namespace {
+std::shared_ptr<const MM::Reflection::SerializationPlan>
+GetOrCompileSerializationPlan(
+    const MM::Reflection::Meta& meta,
+    std::shared_ptr<const MM::Reflection::SerializationPlan>& cached_plan,
+    MM::Reflection::SerializationPlan::Layout layout) {
+  std::shared_ptr<const MM::Reflection::SerializationPlan> plan =
+      std::atomic_load(&cached_plan);
+  if (plan != nullptr &&
+      plan->GetGeneration() ==
+          MM::Reflection::SerializationPlan::GetCurrentGeneration()) {
+    return plan;
+  }
+
+  plan = MM::Reflection::SerializationPlan::Compile(meta, layout);
+  std::atomic_store(&cached_plan, plan);
+
+  return plan;
+}
+}  // namespace
+
 MM::Reflection::Meta::Meta(
     const std::string& type_name, const Type& type,
     std::unordered_map<std::string, Constructor>&& constructors,
@@ -13,7 +35,9 @@ MM::Reflection::Meta::Meta(
       type_(&type),
       constructors_(std::move(constructors)),
       methods_(std::move(methods)),
-      properties_(std::move(properties)) {}
+      properties_(std::move(properties)) {
+  RebuildNameIndex();
+}
 
 MM::Reflection::Meta::Meta(const std::string& type_name, const Type& type,
                            std::unordered_map<std::string, EnumPair>&& enums)
@@ -37,6 +61,9 @@ MM::Reflection::Meta::Meta(Meta&& other) noexcept
       constructors_(std::move(other.constructors_)),
       methods_(std::move(other.methods_)),
       properties_(std::move(other.properties_)),
+      constructor_index_(std::move(other.constructor_index_)),
+      method_index_(std::move(other.method_index_)),
+      property_index_(std::move(other.property_index_)),
       serializer_name_(std::move(other.serializer_name_)),
       enums_(std::move(other.enums_)),
       enum_value_to_name_(std::move(other.enum_value_to_name_)) {
@@ -46,8 +73,8 @@ MM::Reflection::Meta::Meta(Meta&& other) noexcept
       std::move(other.empty_variable_const_refrence_);
   // If the referenced object is a small object, the reference address needs to be changed.
   if (empty_variable_.variable_type_ == Variable::VariableType::SMALL_OBJECT) {
-    empty_variable_refrence_.wrapper_.small_wrapper_.ptr2 = empty_variable_.GetValue();
-    empty_variable_const_refrence_.wrapper_.small_wrapper_.ptr2 = empty_variable_.GetValue();
+    empty_variable_refrence_.wrapper_.small_wrapper_.SetPtr2(empty_variable_.GetValue());
+    empty_variable_const_refrence_.wrapper_.small_wrapper_.SetPtr2(empty_variable_.GetValue());
   }
 }
 
@@ -75,6 +102,11 @@ const MM::Reflection::Constructor* MM::Reflection::Meta::GetConstructor(
   return nullptr;
 }
 
+const MM::Reflection::Constructor* MM::Reflection::Meta::GetConstructor(
+    NameId constructor_name) const {
+  return constructor_index_.Find(constructor_name);
+}
+
 std::vector<const MM::Reflection::Constructor*>
 MM::Reflection::Meta::GetAllConstructor() const {
   if (constructors_.empty()) {
@@ -116,6 +148,11 @@ const MM::Reflection::Method* MM::Reflection::Meta::GetMethod(
   return nullptr;
 }
 
+const MM::Reflection::Method* MM::Reflection::Meta::GetMethod(
+    NameId method_name) const {
+  return method_index_.Find(method_name);
+}
+
 std::vector<const MM::Reflection::Method*> MM::Reflection::Meta::GetAllMethod() const {
   if (methods_.empty()) {
     return std::vector<const Method*>{};
@@ -149,6 +186,11 @@ const MM::Reflection::Property* MM::Reflection::Meta::GetProperty(
   return nullptr;
 }
 
+const MM::Reflection::Property* MM::Reflection::Meta::GetProperty(
+    NameId property_name) const {
+  return property_index_.Find(property_name);
+}
+
 std::vector<const MM::Reflection::Property*>
 MM::Reflection::Meta::GetAllProperty() const {
   if (properties_.empty()) {
@@ -191,6 +233,7 @@ bool MM::Reflection::Meta::AddConstructor(Constructor&& constuctor) {
   }
 
   constructors_[constuctor.GetConstructorName()] = std::move(constuctor);
+  constructor_index_.Build(constructors_);
 
   return true;
 }
@@ -198,6 +241,7 @@ bool MM::Reflection::Meta::AddConstructor(Constructor&& constuctor) {
 void MM::Reflection::Meta::RemoveConstructor(
     const std::string& constructor_name) {
   constructors_.erase(constructor_name);
+  constructor_index_.Build(constructors_);
 }
 
 bool MM::Reflection::Meta::AddMethod(Method&& method) {
@@ -206,12 +250,16 @@ bool MM::Reflection::Meta::AddMethod(Method&& method) {
   }
 
   methods_[method.GetMethodName()] = std::move(method);
+  method_index_.Build(methods_);
+  SerializationPlan::InvalidateAll();
 
   return true;
 }
 
 void MM::Reflection::Meta::RemoveMethod(const std::string& method_name) {
   methods_.erase(method_name);
+  method_index_.Build(methods_);
+  SerializationPlan::InvalidateAll();
 }
 
 bool MM::Reflection::Meta::AddProperty(Property&& property) {
@@ -224,12 +272,16 @@ bool MM::Reflection::Meta::AddProperty(Property&& property) {
   }
 
   properties_.emplace(property.GetPropertyName(), std::move(property));
+  property_index_.Build(properties_);
+  SerializationPlan::InvalidateAll();
 
   return true;
 }
 
 void MM::Reflection::Meta::RemoveProperty(const std::string& property_name) {
   properties_.erase(property_name);
+  property_index_.Build(properties_);
+  SerializationPlan::InvalidateAll();
 }
 
 bool MM::Reflection::Meta::AddEnum(EnumPair&& enum_pair) {
@@ -271,21 +323,24 @@ MM::Reflection::Variable MM::Reflection::Meta::CreateEnumVariable(
 
 bool MM::Reflection::Meta::SetSerializerName(
     const std::string& serializer_name) {
-  const std::unordered_map<std::string, SerializerBase*>& data_base = GetSerializerDatabase();
-  const auto find_rseult = data_base.find(serializer_name);
-  if (find_rseult == data_base.end()) {
+  const SerializerBase* serializer = FindSerializer(serializer_name);
+  if (serializer == nullptr) {
     return false;
   }
-  if (!find_rseult->second->Check(*this)) {
+  if (!serializer->Check(*this)) {
     return false;
   }
 
   serializer_name_ = serializer_name;
+  SerializationPlan::InvalidateAll();
 
   return true;
 }
 
-void MM::Reflection::Meta::RemoveSerializerName() { serializer_name_.clear(); }
+void MM::Reflection::Meta::RemoveSerializerName() {
+  serializer_name_.clear();
+  SerializationPlan::InvalidateAll();
+}
 
 MM::Reflection::Variable MM::Reflection::Meta::CreateInstance(
     const std::string& constructor_name) const {
@@ -371,6 +426,17 @@ MM::Reflection::Variable MM::Reflection::Meta::CreateInstance(
   return constructor->Invoke(args);
 }
 
+MM::Reflection::Variable MM::Reflection::Meta::CreateInstance(
+    const std::string& constructor_name, Variable* const* args,
+    std::size_t argument_number) const {
+  const Constructor* constructor = GetConstructor(constructor_name);
+  if (constructor == nullptr) {
+    return Variable{};
+  }
+
+  return constructor->Invoke(args, argument_number);
+}
+
 const std::string& MM::Reflection::Meta::GetEmptyObjectMethodName() {
   static std::string empyt_object_method_name = "GetEmptyObject";
 
@@ -402,3 +468,21 @@ const std::string& MM::Reflection::Meta::GetSerializerName() const {
 bool MM::Reflection::Meta::HaveSerializer() const {
   return !GetSerializerName().empty();
 }
+
+std::shared_ptr<const MM::Reflection::SerializationPlan>
+MM::Reflection::Meta::GetSerializationPlan() const {
+  return GetOrCompileSerializationPlan(*this, serialization_plan_,
+                                       SerializationPlan::Layout::DESCRIPTOR);
+}
+
+std::shared_ptr<const MM::Reflection::SerializationPlan>
+MM::Reflection::Meta::GetSchemaSerializationPlan() const {
+  return GetOrCompileSerializationPlan(*this, schema_serialization_plan_,
+                                       SerializationPlan::Layout::SCHEMA);
+}
+
+void MM::Reflection::Meta::RebuildNameIndex() {
+  constructor_index_.Build(constructors_);
+  method_index_.Build(methods_);
+  property_index_.Build(properties_);
+}
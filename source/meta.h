@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -7,10 +8,13 @@
 #include "constructor.h"
 #include "enum.h"
 #include "method.h"
+#include "name_id.h"
 #include "property.h"
 
 namespace MM {
 namespace Reflection {
+class SerializationPlan;
+
 class Meta {
 template <typename ClassType_> friend class Class;
 template <typename EnumType_, EnumValue DefaultValue> friend class Enum;
@@ -58,6 +62,13 @@ public:
   */
  const Constructor* GetConstructor(const std::string& constructor_name) const;
 
+ /**
+  * \brief Get \ref MM::Reflection::Constructor with a interned name.
+  * \param constructor_name The interned name of constructor.
+  * \return The \ref MM::Reflection::Constructor, or nullptr if it does not exist.
+  */
+ const Constructor* GetConstructor(NameId constructor_name) const;
+
  /**
   * \brief Get all \ref MM::Reflection::Method of this meta.
   * \return All \ref MM::Reflection::Method of this meta.
@@ -85,6 +96,13 @@ public:
   */
  const Method* GetMethod(const std::string& method_name) const;
 
+ /**
+  * \brief Get \ref MM::Reflection::Method with a interned name.
+  * \param method_name The interned name of method.
+  * \return The \ref MM::Reflection::Method, or nullptr if it does not exist.
+  */
+ const Method* GetMethod(NameId method_name) const;
+
  /**
   * \brief Get all \ref MM::Reflection::Method of this meta.
   * \return All \ref MM::Reflection::Method of this meta.
@@ -107,6 +125,13 @@ public:
   */
  const Property* GetProperty(const std::string& property_name) const;
 
+ /**
+  * \brief Get \ref MM::Reflection::Property with a interned name.
+  * \param property_name The interned name of property.
+  * \return The \ref MM::Reflection::Property, or nullptr if it does not exist.
+  */
+ const Property* GetProperty(NameId property_name) const;
+
  /**
   * \brief Get all \ref MM::Reflection::Property of this meta.
   * \return All \ref MM::Reflection::Property of this meta.
@@ -288,6 +313,36 @@ public:
  Variable CreateInstance(const std::string& constructor_name,
                          std::vector<Variable*>& args) const;
 
+ /**
+  * \brief Create instance with any number of parameters.
+  * \param constructor_name The name of the constructor used.
+  * \param args The address of the arguments.
+  * \param argument_number The number of arguments.
+  * \return \ref MM::Reflection::Variable containing the return value of this
+  * function.
+  * \remark If the number or type of incoming argument is different
+  * from the argument required by the constructor held by this meta, the
+  * function held by this object will not be called and return an empty \ref
+  * MM::Reflection::Variable.
+  */
+ Variable CreateInstance(const std::string& constructor_name,
+                         Variable* const* args,
+                         std::size_t argument_number) const;
+
+ /**
+  * \brief Create instance with any number of parameters.
+  * \param constructor_name The name of the constructor used.
+  * \param args Arguments.
+  * \return \ref MM::Reflection::Variable containing the return value of this
+  * function.
+  * \remark The arguments are passed on the stack, no memory is allocated.
+  */
+ template <typename... Args, typename = std::enable_if_t<(std::is_same_v<Args, Variable> && ...)>>
+ Variable CreateInstance(const std::string& constructor_name, Args&... args) const {
+   std::array<Variable*, sizeof...(Args)> arg_array{&args...};
+   return CreateInstance(constructor_name, arg_array.data(), sizeof...(Args));
+ }
+
  static const std::string& GetEmptyObjectMethodName();
 
  bool HaveEmptyObject() const;
@@ -338,6 +393,28 @@ public:
 
  bool HaveSerializer() const;
 
+ /**
+  * \brief Get the compiled \ref SerializationPlan of this type.
+  * \return The plan. It is never nullptr, but may be invalid.
+  * \remark The plan is compiled on first use and compiled again after any
+  * metadata changes its properties, methods or serializer. It is thread-safe.
+  */
+ std::shared_ptr<const SerializationPlan> GetSerializationPlan() const;
+
+ /**
+  * \brief Get the compiled \ref SerializationPlan of this type for the
+  * records of \ref SchemaWriter.
+  * \return The plan. It is never nullptr, but may be invalid.
+  */
+ std::shared_ptr<const SerializationPlan> GetSchemaSerializationPlan() const;
+
+private:
+ /**
+  * \brief Rebuild the \ref NameId indexes after constructors, methods or
+  * properties changed.
+  */
+ void RebuildNameIndex();
+
 private:
  std::string type_name_{};
 
@@ -361,6 +438,14 @@ private:
   */
  std::unordered_map<std::string, Property> properties_;
 
+ /**
+  * \brief Sorted \ref NameId indexes of the constructor, method and property
+  * maps.
+  */
+ NameIdIndex<Constructor> constructor_index_{};
+ NameIdIndex<Method> method_index_{};
+ NameIdIndex<Property> property_index_{};
+
  std::unordered_map<std::string, EnumPair> enums_;
 
  std::unordered_map<EnumValue, std::string> enum_value_to_name_;
@@ -372,6 +457,10 @@ private:
  mutable Variable empty_variable_const_refrence_{};
 
  std::string serializer_name_{};
+
+ mutable std::shared_ptr<const SerializationPlan> serialization_plan_{};
+
+ mutable std::shared_ptr<const SerializationPlan> schema_serialization_plan_{};
 };
 }
 }
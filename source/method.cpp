@@ -1,19 +1,22 @@
 #include "method.h"
 
 bool MM::Reflection::AllTypeIsArgTypeFromVector(const MM::Reflection::MethodWrapperBase& method, const std::vector<MM::Reflection::Variable*>& args) {
+  return AllTypeIsArgTypeFromSpan(method, args.data(), args.size());
+}
+
+bool MM::Reflection::AllTypeIsArgTypeFromSpan(const MM::Reflection::MethodWrapperBase& method, MM::Reflection::Variable* const* args, std::size_t argument_number) {
   if (!method.IsValid()) {
     return false;
   }
-  if (args.size() != method.GetArgumentNumber()) {
+  if (argument_number != method.GetArgumentNumber()) {
     return false;
   }
-  for (const auto& arg: args) {
-    if (arg == nullptr || !(arg->IsValid())) {
+  const TypeHashCode* argument_type_hash_codes = method.GetArgumentTypeHashCodes();
+  for (std::size_t arg_index = 0; arg_index != argument_number; ++arg_index) {
+    if (args[arg_index] == nullptr || !(args[arg_index]->IsValid())) {
       return false;
     }
-  }
-  for (std::uint32_t arg_index = 0; arg_index != method.GetArgumentNumber(); ++arg_index) {
-    if (args[arg_index]->GetType()->GetTypeHashCode() != method.GetArgumentType(arg_index)->GetTypeHashCode()) {
+    if (args[arg_index]->GetType()->GetTypeHashCode() != argument_type_hash_codes[arg_index]) {
       return false;
     }
   }
@@ -124,6 +127,38 @@ MM::Reflection::Variable MM::Reflection::MethodWrapperBase::Invoke(
   return Variable{};
 }
 
+MM::Reflection::Variable MM::Reflection::MethodWrapperBase::Invoke(
+    Variable& instance, Variable* const* args,
+    std::size_t argument_number) const {
+  return Variable{};
+}
+
+bool MM::Reflection::MethodWrapperBase::InvokeInto(
+    Variable& out, Variable& instance, Variable* const* args,
+    std::size_t argument_number) const {
+  return false;
+}
+
+MM::Reflection::Variable MM::Reflection::MethodWrapperBase::InvokeInto(
+    void* storage, Variable& instance, Variable* const* args,
+    std::size_t argument_number) const {
+  return Variable{};
+}
+
+std::uint64_t MM::Reflection::MethodWrapperBase::GetReturnWrapperSize() const {
+  return 0;
+}
+
+const MM::Reflection::TypeHashCode*
+MM::Reflection::MethodWrapperBase::GetArgumentTypeHashCodes() const {
+  return nullptr;
+}
+
+MM::Reflection::Variable MM::Reflection::MethodWrapperBase::InvokeUnchecked(
+    Variable& instance, Variable* const* args) const {
+  return Variable{};
+}
+
 bool MM::Reflection::MethodWrapperBase::IsValid() const {
   return !method_name_.empty();
 }
@@ -301,3 +336,112 @@ MM::Reflection::Variable MM::Reflection::Method::Invoke(
     Variable& instance, std::vector<Variable*>&& args) const {
   return Invoke(instance, args);
 }
+
+MM::Reflection::Variable MM::Reflection::Method::Invoke(
+    Variable& instance, Variable* const* args,
+    std::size_t argument_number) const {
+  if (!IsValid()) {
+    return Variable{};
+  }
+
+  return method_wrapper_->Invoke(instance, args, argument_number);
+}
+
+bool MM::Reflection::Method::InvokeInto(Variable& out, Variable& instance,
+                                        Variable* const* args,
+                                        std::size_t argument_number) const {
+  if (!IsValid()) {
+    return false;
+  }
+
+  return method_wrapper_->InvokeInto(out, instance, args, argument_number);
+}
+
+MM::Reflection::Variable MM::Reflection::Method::InvokeInto(
+    void* storage, Variable& instance, Variable* const* args,
+    std::size_t argument_number) const {
+  if (!IsValid()) {
+    return Variable{};
+  }
+
+  return method_wrapper_->InvokeInto(storage, instance, args, argument_number);
+}
+
+std::uint64_t MM::Reflection::Method::GetReturnWrapperSize() const {
+  if (!IsValid()) {
+    return 0;
+  }
+
+  return method_wrapper_->GetReturnWrapperSize();
+}
+
+MM::Reflection::MethodHandle MM::Reflection::Method::Bind() const {
+  if (!IsValid()) {
+    return MethodHandle{};
+  }
+
+  return MethodHandle{method_wrapper_.get()};
+}
+
+MM::Reflection::MethodHandle::MethodHandle(
+    const MethodWrapperBase* method_wrapper)
+    : method_wrapper_(method_wrapper),
+      argument_type_hash_codes_(method_wrapper->GetArgumentTypeHashCodes()),
+      argument_number_(method_wrapper->GetArgumentNumber()),
+      is_static_(method_wrapper->IsStatic()) {
+  const Type* class_type = method_wrapper->GetClassType();
+  if (class_type != nullptr) {
+    class_type_hash_code_ = class_type->GetTypeHashCode();
+    class_is_const_ = class_type->IsConst();
+  }
+}
+
+bool MM::Reflection::MethodHandle::IsValid() const {
+  return method_wrapper_ != nullptr;
+}
+
+bool MM::Reflection::MethodHandle::IsStatic() const { return is_static_; }
+
+std::uint32_t MM::Reflection::MethodHandle::GetArgumentNumber() const {
+  return argument_number_;
+}
+
+bool MM::Reflection::MethodHandle::CheckArguments(
+    Variable& instance, Variable* const* args,
+    std::size_t argument_number) const {
+  if (!IsValid() || argument_number != argument_number_) {
+    return false;
+  }
+  if (!is_static_) {
+    const Type* instance_type = instance.GetType();
+    if (instance_type == nullptr ||
+        instance_type->GetTypeHashCode() != class_type_hash_code_ ||
+        instance_type->IsConst() != class_is_const_) {
+      return false;
+    }
+  }
+  for (std::size_t arg_index = 0; arg_index != argument_number; ++arg_index) {
+    if (args[arg_index] == nullptr || !args[arg_index]->IsValid() ||
+        args[arg_index]->GetType()->GetTypeHashCode() !=
+            argument_type_hash_codes_[arg_index]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+MM::Reflection::Variable MM::Reflection::MethodHandle::Invoke(
+    Variable& instance, Variable* const* args,
+    std::size_t argument_number) const {
+  if (!CheckArguments(instance, args, argument_number)) {
+    return Variable{};
+  }
+
+  return method_wrapper_->InvokeUnchecked(instance, args);
+}
+
+MM::Reflection::Variable MM::Reflection::MethodHandle::InvokeUnchecked(
+    Variable& instance, Variable* const* args) const {
+  return method_wrapper_->InvokeUnchecked(instance, args);
+}
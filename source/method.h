@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <new>
 #include <type_traits>
 #include <array>
 
@@ -217,6 +218,83 @@ class MethodWrapperBase {
   virtual Variable Invoke(Variable& instance,
                           std::vector<Variable*>& args) const;
 
+  /**
+   * \brief Call the function with any number of parameters.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return \ref MM::Reflection::Variable containing the return value of this
+   * function.
+   * \remark If the number or type of incoming argument is different
+   * from the argument required by the function held by this object, the
+   * function held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  virtual Variable Invoke(Variable& instance, Variable* const* args,
+                          std::size_t argument_number) const;
+
+  /**
+   * \brief Call the function and store the return value in \ref out.
+   * \param out The variable that receives the return value.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return Returns true if the function is called, otherwise returns false.
+   * \remark If \ref out is valid and holds a non-const value of the return
+   * type, the return value is move assigned to it and nothing is allocated.
+   * If \ref out is invalid, it will be replaced by a new variable holding the
+   * return value. Otherwise the function will not be called.
+   * \remark If the function returns a reference and \ref out is a reference
+   * variable, \ref out is rebound to the returned object. Nothing is assigned
+   * through the reference it held before.
+   */
+  virtual bool InvokeInto(Variable& out, Variable& instance,
+                          Variable* const* args,
+                          std::size_t argument_number) const;
+
+  /**
+   * \brief Call the function and construct the return value in \ref storage.
+   * \param storage The location of the newly constructed wrapper of the
+   * return value, it must have at least \ref GetReturnWrapperSize bytes.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return \ref MM::Reflection::Variable that holds the return value
+   * constructed in \ref storage.
+   * \remark If the number or type of incoming argument is different
+   * from the argument required by the function held by this object, the
+   * function held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  virtual Variable InvokeInto(void* storage, Variable& instance,
+                              Variable* const* args,
+                              std::size_t argument_number) const;
+
+  /**
+   * \brief Get the size of the storage required by \ref InvokeInto.
+   * \return The size of the wrapper of the return value.
+   */
+  virtual std::uint64_t GetReturnWrapperSize() const;
+
+  /**
+   * \brief Get the hash codes of all argument types.
+   * \return The address of an array of \ref GetArgumentNumber hash codes. The
+   * array lives as long as the program.
+   */
+  virtual const TypeHashCode* GetArgumentTypeHashCodes() const;
+
+  /**
+   * \brief Invoke the function without checking the instance and arguments.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of \ref GetArgumentNumber arguments.
+   * \return \ref MM::Reflection::Variable containing the return value of this
+   * function.
+   * \remark The caller must guarantee that the instance and all arguments are
+   * valid and have the types required by the function, otherwise the behavior
+   * is undefined.
+   */
+  virtual Variable InvokeUnchecked(Variable& instance, Variable* const* args) const;
+
  private:
     std::string method_name_{};
 };
@@ -236,11 +314,12 @@ bool AllTypeIsArgType(const MethodWrapperBase& method, std::array<Variable*, var
   if (!method.IsValid()) {
     return false;
   }
+  const TypeHashCode* argument_type_hash_codes = method.GetArgumentTypeHashCodes();
   for (std::uint32_t variable_index = 0; variable_index != variable_number; ++variable_index) {
     if (args[variable_index] == nullptr ||
         !args[variable_index]->IsValid() ||
         (args[variable_index]->GetType()->GetTypeHashCode() !=
-         method.GetArgumentType(variable_index)->GetTypeHashCode())) {
+         argument_type_hash_codes[variable_index])) {
       return false;
     }
   }
@@ -250,6 +329,8 @@ bool AllTypeIsArgType(const MethodWrapperBase& method, std::array<Variable*, var
 
 bool AllTypeIsArgTypeFromVector(const MethodWrapperBase& method, const std::vector<Variable*>& args);
 
+bool AllTypeIsArgTypeFromSpan(const MethodWrapperBase& method, Variable* const* args, std::size_t argument_number);
+
 bool VariableInstaceIsValid(const MethodWrapperBase& method, Variable& instance);
 
 template < typename FunctionType, typename ArgsCollection,
@@ -291,6 +372,23 @@ Variable InvokeCommonMethodImp(
   }
 }
 
+template <typename FunctionType, typename ArgsCollection,
+          std::uint64_t... ArgIndex_>
+decltype(auto) CallMethodImp(
+    Variable& instance,
+    FunctionType function_ptr,
+    ArgsCollection&& args, Utils::IndexSequence<ArgIndex_...>) {
+  using FunctionSig = Utils::FunctionSignature<FunctionType>;
+  using Args = typename FunctionSig::Args;
+  if constexpr (FunctionSig::IsStatic) {
+    return (*function_ptr)((*reinterpret_cast<std::add_pointer_t<Utils::GetCommonTypeT<std::tuple_element_t<ArgIndex_, Args>>>>(args[ArgIndex_]->GetValue()))...);
+  } else {
+    using InstancePtrType = Utils::IfThenElseT<FunctionSig::IsConst, typename std::add_pointer_t<std::add_const_t<typename FunctionSig::InstanceType>>, typename std::add_pointer_t<typename FunctionSig::InstanceType>>;
+    InstancePtrType instance_ptr = reinterpret_cast<InstancePtrType>(instance.GetValue());
+    return ((*instance_ptr).*function_ptr)((*reinterpret_cast<std::add_pointer_t<Utils::GetCommonTypeT<std::tuple_element_t<ArgIndex_, Args>>>>(args[ArgIndex_]->GetValue()))...);
+  }
+}
+
 template <typename FunctionType>
 Variable InvokeImp(const MethodWrapperBase& method, Variable& instance,
                    FunctionType function_ptr,
@@ -384,7 +482,7 @@ class MethodWrapper
     return ((MethodWrapperBase::HashCode() ^
              GetReturnType()->GetTypeHashCode() ^
              GetClassType()->GetTypeHashCode()) ^
-            ... ^ (typeid(Args_).hash_code()));
+            ... ^ (Utils::TypeHashCodeV<Args_>));
   }
 
   /**
@@ -427,13 +525,22 @@ class MethodWrapper
    * \return The \ref MM::Reflection::Type of target argument type.
    */
   const Type* GetArgumentType(std::uint32_t argument_index) const override {
-    std::array<const Type*, sizeof...(Args_)> ArgTypes{(&MM::Reflection::Type::CreateType<Args_>())...};
+    static const std::array<const Type*, sizeof...(Args_)> ArgTypes{(&MM::Reflection::Type::CreateType<Args_>())...};
     if (argument_index >= sizeof...(Args_)) {
       return nullptr;
     }
     return ArgTypes[argument_index];
   }
 
+  /**
+   * \brief Get the hash codes of all argument types.
+   * \return The address of an array of \ref GetArgumentNumber hash codes. The
+   * array lives as long as the program.
+   */
+  const TypeHashCode* GetArgumentTypeHashCodes() const override {
+    return argument_type_hash_codes_.data();
+  }
+
   /**
    * \brief Get the \ref MM::Reflection::Type of class type.
    * \return The \ref MM::Reflection::Type of class type.
@@ -644,12 +751,263 @@ class MethodWrapper
     return InvokeVectorImp(*this, instance, function_ptr_, args, Utils::MakeIndexSequence<sizeof...(Args_)>());
   }
 
+  /**
+   * \brief Call the function with any number of parameters.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return \ref MM::Reflection::Variable containing the return value of this
+   * function.
+   * \remark If the number or type of incoming argument is different
+   * from the argument required by the function held by this object, the
+   * function held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(Variable& instance, Variable* const* args,
+                  std::size_t argument_number) const override {
+    if (!CanInvoke(instance, args, argument_number)) {
+      return Variable{};
+    }
+
+    return InvokeUnchecked(instance, args);
+  }
+
+  /**
+   * \brief Call the function and store the return value in \ref out.
+   * \param out The variable that receives the return value.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return Returns true if the function is called, otherwise returns false.
+   * \remark If \ref out is valid and holds a non-const value of the return
+   * type, the return value is move assigned to it and nothing is allocated.
+   * If \ref out is invalid, it will be replaced by a new variable holding the
+   * return value. Otherwise the function will not be called.
+   * \remark If the function returns a reference and \ref out is a reference
+   * variable, \ref out is rebound to the returned object. Nothing is assigned
+   * through the reference it held before.
+   */
+  bool InvokeInto(Variable& out, Variable& instance, Variable* const* args,
+                  std::size_t argument_number) const override {
+    if (!CanInvoke(instance, args, argument_number)) {
+      return false;
+    }
+
+    if constexpr (std::is_void_v<ReturnType_>) {
+      CallMethodImp(instance, function_ptr_, args, Utils::MakeIndexSequence<sizeof...(Args_)>());
+      if (!out.IsValid()) {
+        out = Variable::CreateVoidVariable();
+      }
+      return true;
+    } else {
+      using ReturnValueType = std::remove_cv_t<std::remove_reference_t<ReturnType_>>;
+      if (!out.IsValid()) {
+        out = Variable::CreateVariable<ReturnType_>(CallMethodImp(instance, function_ptr_, args, Utils::MakeIndexSequence<sizeof...(Args_)>()));
+        return true;
+      }
+      if constexpr (std::is_lvalue_reference_v<ReturnType_>) {
+        if (out.IsRefrenceVariable()) {
+          // Assigning to a reference variable writes to the object it refers
+          // to, so the variable is rebuilt instead.
+          Variable result = Variable::CreateVariable<ReturnType_>(CallMethodImp(instance, function_ptr_, args, Utils::MakeIndexSequence<sizeof...(Args_)>()));
+          out.~Variable();
+          new (&out) Variable{std::move(result)};
+          return true;
+        }
+      }
+      if constexpr (std::is_assignable_v<ReturnValueType&, ReturnType_>) {
+        const Type* out_type = out.GetType();
+        if (out_type->GetTypeHashCode() != Utils::TypeHashCodeV<ReturnType_> || out_type->IsConst()) {
+          return false;
+        }
+        *static_cast<ReturnValueType*>(out.GetValue()) = CallMethodImp(instance, function_ptr_, args, Utils::MakeIndexSequence<sizeof...(Args_)>());
+        return true;
+      } else {
+        return false;
+      }
+    }
+  }
+
+  /**
+   * \brief Call the function and construct the return value in \ref storage.
+   * \param storage The location of the newly constructed wrapper of the
+   * return value, it must have at least \ref GetReturnWrapperSize bytes.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return \ref MM::Reflection::Variable that holds the return value
+   * constructed in \ref storage.
+   * \remark If the number or type of incoming argument is different
+   * from the argument required by the function held by this object, the
+   * function held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable InvokeInto(void* storage, Variable& instance, Variable* const* args,
+                      std::size_t argument_number) const override {
+    if (storage == nullptr || !CanInvoke(instance, args, argument_number)) {
+      return Variable{};
+    }
+
+    if constexpr (std::is_void_v<ReturnType_>) {
+      CallMethodImp(instance, function_ptr_, args, Utils::MakeIndexSequence<sizeof...(Args_)>());
+      return Variable::CreateVoidVariable();
+    } else {
+      return Variable::CreateVariablePlacement<ReturnType_>(storage, CallMethodImp(instance, function_ptr_, args, Utils::MakeIndexSequence<sizeof...(Args_)>()));
+    }
+  }
+
+  /**
+   * \brief Get the size of the storage required by \ref InvokeInto.
+   * \return The size of the wrapper of the return value.
+   */
+  std::uint64_t GetReturnWrapperSize() const override {
+    if constexpr (std::is_void_v<ReturnType_>) {
+      return 0;
+    } else if constexpr (std::is_lvalue_reference_v<ReturnType_>) {
+      return sizeof(VariableRefrenceWrapper<ReturnType_>);
+    } else {
+      return sizeof(VariableWrapper<ReturnType_>);
+    }
+  }
+
+  /**
+   * \brief Invoke the function without checking the instance and arguments.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of \ref GetArgumentNumber arguments.
+   * \return \ref MM::Reflection::Variable containing the return value of this
+   * function.
+   * \remark The caller must guarantee that the instance and all arguments are
+   * valid and have the types required by the function, otherwise the behavior
+   * is undefined.
+   */
+  Variable InvokeUnchecked(Variable& instance, Variable* const* args) const override {
+    if constexpr (IsStatic_) {
+      return InvokeStaticMethodImp(function_ptr_, args, Utils::MakeIndexSequence<sizeof...(Args_)>());
+    } else {
+      return InvokeCommonMethodImp(instance, function_ptr_, args, Utils::MakeIndexSequence<sizeof...(Args_)>());
+    }
+  }
+
  private:
+  bool CanInvoke(Variable& instance, Variable* const* args,
+                 std::size_t argument_number) const {
+    if (!IsValid() || argument_number != sizeof...(Args_)) {
+      return false;
+    }
+    if constexpr (!IsStatic_) {
+      if (!VariableInstaceIsValid(*this, instance)) {
+        return false;
+      }
+    }
+
+    return AllTypeIsArgTypeFromSpan(*this, args, argument_number);
+  }
+
+ private:
+  static constexpr std::array<TypeHashCode, sizeof...(Args_)> argument_type_hash_codes_{Utils::TypeHashCodeV<Args_>...};
 
  private:
   FunctionType function_ptr_ = nullptr;
 };
 
+/**
+ * \brief A pre-bound handle of a \ref MM::Reflection::Method.
+ * \remark \ref MM::Reflection::Method::Bind resolves the argument type hash
+ * codes and the class type once, so checking a call only compares integers and
+ * no memory is allocated per call.
+ * \remark The handle does not own the method, it must not outlive the
+ * \ref MM::Reflection::Meta that holds the method.
+ */
+class MethodHandle {
+  friend class Method;
+
+ public:
+  MethodHandle() = default;
+  ~MethodHandle() = default;
+  MethodHandle(const MethodHandle& other) = default;
+  MethodHandle(MethodHandle&& other) noexcept = default;
+  MethodHandle& operator=(const MethodHandle& other) = default;
+  MethodHandle& operator=(MethodHandle&& other) noexcept = default;
+
+ public:
+  /**
+   * \brief Judge whether the object is a valid object.
+   * \return Returns true if the object is a valid object, otherwise returns
+   * false.
+   */
+  bool IsValid() const;
+
+  /**
+   * \brief Determine whether the function is static.
+   * \return If the function is static, it returns true, otherwise it returns
+   * false.
+   */
+  bool IsStatic() const;
+
+  /**
+   * \brief Returns the number of arguments to the function.
+   * \return The number of arguments to the function.
+   */
+  std::uint32_t GetArgumentNumber() const;
+
+  /**
+   * \brief Check whether the instance and the arguments can be used to call
+   * the function.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return Returns true if the function can be called, otherwise returns
+   * false.
+   */
+  bool CheckArguments(Variable& instance, Variable* const* args, std::size_t argument_number) const;
+
+  /**
+   * \brief Call the function with any number of parameters.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return \ref MM::Reflection::Variable containing the return value of this
+   * function.
+   * \remark If this object is invalid or \ref CheckArguments returns false,
+   * empty \ref MM::Reflection::Variable will be return.
+   */
+  Variable Invoke(Variable& instance, Variable* const* args, std::size_t argument_number) const;
+
+  template <typename... Args, typename = std::enable_if_t<(std::is_same_v<Args, Variable> && ...)>>
+  Variable Invoke(Variable& instance, Args&... args) const {
+    std::array<Variable*, sizeof...(Args)> arg_array{&args...};
+    return Invoke(instance, arg_array.data(), sizeof...(Args));
+  }
+
+  /**
+   * \brief Call the function without checking the instance and arguments.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of \ref GetArgumentNumber arguments.
+   * \return \ref MM::Reflection::Variable containing the return value of this
+   * function.
+   * \remark The caller must guarantee that this object is valid and
+   * \ref CheckArguments returns true, otherwise the behavior is undefined.
+   */
+  Variable InvokeUnchecked(Variable& instance, Variable* const* args) const;
+
+  template <typename... Args, typename = std::enable_if_t<(std::is_same_v<Args, Variable> && ...)>>
+  Variable InvokeUnchecked(Variable& instance, Args&... args) const {
+    std::array<Variable*, sizeof...(Args)> arg_array{&args...};
+    return InvokeUnchecked(instance, arg_array.data());
+  }
+
+ private:
+  explicit MethodHandle(const MethodWrapperBase* method_wrapper);
+
+ private:
+  const MethodWrapperBase* method_wrapper_{nullptr};
+  const TypeHashCode* argument_type_hash_codes_{nullptr};
+  TypeHashCode class_type_hash_code_{0};
+  std::uint32_t argument_number_{0};
+  bool is_static_{false};
+  bool class_is_const_{false};
+};
+
 class Method {
   friend class Meta;
 
@@ -887,6 +1245,96 @@ class Method {
    */
   Variable Invoke(Variable& instance, std::vector<Variable*>&& args) const;
 
+  /**
+   * \brief Call the function with any number of parameters.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return \ref MM::Reflection::Variable containing the return value of this
+   * function.
+   * \remark If this object is invalid ,empty \ref MM::Reflection::Variable will
+   * be return. \remark If the number or type of incoming argument is different
+   * from the argument required by the function held by this object, the
+   * function held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(Variable& instance, Variable* const* args,
+                  std::size_t argument_number) const;
+
+  /**
+   * \brief Call the function with any number of parameters.
+   * \param instance instance Instance that calls this function.
+   * \param args Arguments.
+   * \return \ref MM::Reflection::Variable containing the return value of this
+   * function.
+   * \remark The arguments are passed on the stack, no memory is allocated.
+   */
+  template <typename... Args, typename = std::enable_if_t<(std::is_same_v<Args, Variable> && ...)>>
+  Variable Invoke(Variable& instance, Args&... args) const {
+    std::array<Variable*, sizeof...(Args)> arg_array{&args...};
+    return Invoke(instance, arg_array.data(), sizeof...(Args));
+  }
+
+  /**
+   * \brief Call the function and store the return value in \ref out.
+   * \param out The variable that receives the return value.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return Returns true if the function is called, otherwise returns false.
+   * \remark If \ref out is valid and holds a non-const value of the return
+   * type, the return value is move assigned to it and nothing is allocated.
+   * If \ref out is invalid, it will be replaced by a new variable holding the
+   * return value. Otherwise the function will not be called.
+   * \remark If the function returns a reference and \ref out is a reference
+   * variable, \ref out is rebound to the returned object. Nothing is assigned
+   * through the reference it held before.
+   */
+  bool InvokeInto(Variable& out, Variable& instance, Variable* const* args,
+                  std::size_t argument_number) const;
+
+  template <typename... Args, typename = std::enable_if_t<(std::is_same_v<Args, Variable> && ...)>>
+  bool InvokeInto(Variable& out, Variable& instance, Args&... args) const {
+    std::array<Variable*, sizeof...(Args)> arg_array{&args...};
+    return InvokeInto(out, instance, arg_array.data(), sizeof...(Args));
+  }
+
+  /**
+   * \brief Call the function and construct the return value in \ref storage.
+   * \param storage The location of the newly constructed wrapper of the
+   * return value, it must have at least \ref GetReturnWrapperSize bytes.
+   * \param instance instance Instance that calls this function.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return \ref MM::Reflection::Variable that holds the return value
+   * constructed in \ref storage.
+   * \remark If this object is invalid or the number or type of incoming
+   * argument is different from the argument required by the function held by
+   * this object, empty \ref MM::Reflection::Variable will be return.
+   */
+  Variable InvokeInto(void* storage, Variable& instance, Variable* const* args,
+                      std::size_t argument_number) const;
+
+  template <typename... Args, typename = std::enable_if_t<(std::is_same_v<Args, Variable> && ...)>>
+  Variable InvokeInto(void* storage, Variable& instance, Args&... args) const {
+    std::array<Variable*, sizeof...(Args)> arg_array{&args...};
+    return InvokeInto(storage, instance, arg_array.data(), sizeof...(Args));
+  }
+
+  /**
+   * \brief Get the size of the storage required by \ref InvokeInto.
+   * \return The size of the wrapper of the return value.
+   * \remark Return 0 if the object is invalid.
+   */
+  std::uint64_t GetReturnWrapperSize() const;
+
+  /**
+   * \brief Create a pre-bound handle of this method.
+   * \return The \ref MM::Reflection::MethodHandle of this method.
+   * \remark If this object is invalid, an invalid handle will be returned.
+   */
+  MethodHandle Bind() const;
+
  private:
   explicit Method(std::unique_ptr<MethodWrapperBase>&& method_wrapper) : method_wrapper_(std::move(method_wrapper)) {}
 
@@ -0,0 +1,68 @@
+#include "name_id.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "database.h"
+
+namespace {
+struct NameIdTable {
+  std::mutex mutex_{};
+  std::unordered_map<std::string, MM::Reflection::NameId::IdType> name_to_id_{};
+  // Id 0 is the invalid id. std::deque keeps the address of names stable.
+  std::deque<std::string> names_{std::string{}};
+};
+
+NameIdTable& GetNameIdTable() {
+  static NameIdTable g_name_id_table{};
+
+  return g_name_id_table;
+}
+}  // namespace
+
+MM::Reflection::NameId::NameId(const std::string& name) {
+  NameIdTable& name_id_table = GetNameIdTable();
+  std::lock_guard<std::mutex> guard{name_id_table.mutex_};
+
+  auto find_result = name_id_table.name_to_id_.find(name);
+  if (find_result != name_id_table.name_to_id_.end()) {
+    id_ = find_result->second;
+    return;
+  }
+
+  id_ = static_cast<IdType>(name_id_table.names_.size());
+  name_id_table.names_.emplace_back(name);
+  name_id_table.name_to_id_.emplace(name, id_);
+}
+
+MM::Reflection::NameId::NameId(const char* name) : NameId(std::string{name}) {}
+
+MM::Reflection::NameId MM::Reflection::NameId::Find(const std::string& name) {
+  NameIdTable& name_id_table = GetNameIdTable();
+  std::lock_guard<std::mutex> guard{name_id_table.mutex_};
+
+  NameId result{};
+  auto find_result = name_id_table.name_to_id_.find(name);
+  if (find_result != name_id_table.name_to_id_.end()) {
+    result.id_ = find_result->second;
+  }
+
+  return result;
+}
+
+bool MM::Reflection::NameId::IsValid() const { return id_ != 0; }
+
+MM::Reflection::NameId::IdType MM::Reflection::NameId::GetId() const {
+  return id_;
+}
+
+const std::string& MM::Reflection::NameId::GetName() const {
+  if (!IsValid()) {
+    return GetEmptyString();
+  }
+
+  NameIdTable& name_id_table = GetNameIdTable();
+  std::lock_guard<std::mutex> guard{name_id_table.mutex_};
+  return name_id_table.names_[id_];
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MM {
+namespace Reflection {
+/**
+ * \brief A small token of an interned name.
+ * \remark Equal names always get the same id, so comparing two \ref NameId is
+ * an integer compare. Resolve names once (for example into a static variable)
+ * and pass the \ref NameId to the lookup functions of \ref Meta and
+ * \ref Variable.
+ */
+class NameId {
+ public:
+  using IdType = std::uint32_t;
+
+ public:
+  NameId() = default;
+  ~NameId() = default;
+  /**
+   * \brief Intern \ref name.
+   * \remark It is thread-safe. An interned name is never removed, so the
+   * names of the table only grow. Use \ref Find for names that come from
+   * outside, such as user input.
+   */
+  explicit NameId(const std::string& name);
+  explicit NameId(const char* name);
+  NameId(const NameId& other) = default;
+  NameId(NameId&& other) noexcept = default;
+  NameId& operator=(const NameId& other) = default;
+  NameId& operator=(NameId&& other) noexcept = default;
+
+ public:
+  /**
+   * \brief Get the id of \ref name without interning it.
+   * \return The id. It is invalid if \ref name has not been interned.
+   * \remark It is thread-safe.
+   */
+  static NameId Find(const std::string& name);
+
+ public:
+  friend bool operator==(const NameId& lhs, const NameId& rhs) {
+    return lhs.id_ == rhs.id_;
+  }
+
+  friend bool operator!=(const NameId& lhs, const NameId& rhs) {
+    return lhs.id_ != rhs.id_;
+  }
+
+  friend bool operator<(const NameId& lhs, const NameId& rhs) {
+    return lhs.id_ < rhs.id_;
+  }
+
+ public:
+  /**
+   * \brief Judge whether the object is a valid object.
+   * \return Returns true if the object holds an interned name, otherwise
+   * returns false.
+   */
+  bool IsValid() const;
+
+  IdType GetId() const;
+
+  /**
+   * \brief Get the interned name.
+   * \return The interned name.
+   * \remark If the object is not valid, the default empty std::string will be
+   * returned.
+   */
+  const std::string& GetName() const;
+
+ private:
+  IdType id_{0};
+};
+
+/**
+ * \brief Sorted index from \ref NameId to the values of a name keyed map.
+ * \remark The values must have stable addresses (the map is node based), the
+ * index has to be rebuilt after the map is changed.
+ */
+template <typename ValueType>
+class NameIdIndex {
+ public:
+  template <typename MapType>
+  void Build(const MapType& map) {
+    std::vector<std::pair<NameId::IdType, const ValueType*>> elements{};
+    elements.reserve(map.size());
+    for (const auto& element : map) {
+      elements.emplace_back(NameId{element.first}.GetId(), &element.second);
+    }
+    std::sort(elements.begin(), elements.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.first < rhs.first;
+    });
+
+    ids_.clear();
+    values_.clear();
+    ids_.reserve(elements.size());
+    values_.reserve(elements.size());
+    for (const auto& element : elements) {
+      ids_.emplace_back(element.first);
+      values_.emplace_back(element.second);
+    }
+  }
+
+  const ValueType* Find(NameId name_id) const {
+    auto iter = std::lower_bound(ids_.begin(), ids_.end(), name_id.GetId());
+    if (iter == ids_.end() || *iter != name_id.GetId()) {
+      return nullptr;
+    }
+    return values_[iter - ids_.begin()];
+  }
+
+ private:
+  std::vector<NameId::IdType> ids_{};
+  std::vector<const ValueType*> values_{};
+};
+}  // namespace Reflection
+}  // namespace MM
+
+template <>
+struct std::hash<MM::Reflection::NameId> {
+  std::size_t operator()(const MM::Reflection::NameId& name_id) const noexcept {
+    return name_id.GetId();
+  }
+};
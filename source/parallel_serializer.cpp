@@ -0,0 +1,531 @@
+#include "parallel_serializer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "serialization_plan.h"
+
+namespace {
+std::uint32_t GetThreadNumber(std::uint32_t thread_number,
+                              std::uint64_t work_number) {
+  if (thread_number == 0) {
+    thread_number = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  return static_cast<std::uint32_t>(std::max<std::uint64_t>(
+      1, std::min<std::uint64_t>(thread_number, work_number)));
+}
+
+/**
+ * \brief Call \ref function with the index of each thread, on the calling
+ * thread and \ref thread_number - 1 new threads.
+ */
+void RunOnThreads(std::uint32_t thread_number,
+                  const std::function<void(std::uint32_t)>& function) {
+  std::vector<std::thread> threads{};
+  threads.reserve(thread_number - 1);
+  for (std::uint32_t thread_index = 1; thread_index < thread_number;
+       ++thread_index) {
+    threads.emplace_back(function, thread_index);
+  }
+  function(0);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+/**
+ * \brief Copy \ref size bytes from the position \ref offset of the data in
+ * \ref segments.
+ */
+void CopySegmentData(const std::vector<MM::Reflection::DataSegment>& segments,
+                     std::uint64_t offset, void* data_to, std::uint64_t size) {
+  auto* to = static_cast<std::uint8_t*>(data_to);
+  for (const MM::Reflection::DataSegment& segment : segments) {
+    if (size == 0) {
+      return;
+    }
+    if (offset >= segment.size_) {
+      offset -= segment.size_;
+      continue;
+    }
+    const std::uint64_t copy_size = std::min(size, segment.size_ - offset);
+    std::memcpy(to, static_cast<const std::uint8_t*>(segment.data_) + offset,
+                copy_size);
+    to += copy_size;
+    size -= copy_size;
+    offset = 0;
+  }
+}
+
+/**
+ * \brief Read one shard from the data of a buffer, so that each thread reads
+ * from a buffer of its own.
+ */
+class ShardSource : public MM::Reflection::DataSource {
+ public:
+  ShardSource(const std::vector<MM::Reflection::DataSegment>& segments,
+              std::uint64_t offset, std::uint64_t size)
+      : segments_(segments), offset_(offset), end_offset_(offset + size) {}
+
+ public:
+  std::uint64_t Read(void* data_to, std::uint64_t size) override {
+    size = std::min(size, end_offset_ - offset_);
+    CopySegmentData(segments_, offset_, data_to, size);
+    offset_ += size;
+
+    return size;
+  }
+
+ private:
+  const std::vector<MM::Reflection::DataSegment>& segments_;
+  std::uint64_t offset_;
+  std::uint64_t end_offset_;
+};
+
+}  // namespace
+
+class MM::Reflection::ParallelShardCache {
+ public:
+  /**
+   * \brief Write \ref variable as \ref Serialize does.
+   */
+  void Serialize(DataBuffer& data_buffer, Variable& variable) {
+    const TypeInfo& type_info = GetTypeInfo(*variable.GetMeta());
+    if (type_info.plan_ == nullptr) {
+      type_info.serializer_->Serialize(data_buffer, variable);
+      return;
+    }
+
+    const SerializerDescriptor descriptor =
+        SerializerBase::CreateDescriptor(variable, type_info.version_, 0);
+    data_buffer.AddData(&descriptor, sizeof(SerializerDescriptor));
+    data_buffer.AddData(&type_info.type_name_hash_, sizeof(TypeHashCode));
+    type_info.plan_->Serialize(data_buffer,
+                               SerializerBase::GetVariableValuePtr(variable));
+  }
+
+  /**
+   * \brief Read an object as \ref Deserialize does.
+   * \return The object. It is invalid if its type is not registered or has no
+   * serializer.
+   */
+  Variable Deserialize(const DataBuffer& data_buffer) {
+    constexpr std::uint64_t PREFIX_SIZE =
+        sizeof(SerializerDescriptor) + sizeof(TypeHashCode);
+    if (!data_buffer.CanReadData(PREFIX_SIZE)) {
+      return MM::Reflection::Deserialize(data_buffer);
+    }
+    std::uint8_t prefix[PREFIX_SIZE]{};
+    data_buffer.PeekData(prefix, PREFIX_SIZE);
+    SerializerDescriptor descriptor{};
+    TypeHashCode type_name_hash{0};
+    std::memcpy(&descriptor, prefix, sizeof(SerializerDescriptor));
+    std::memcpy(&type_name_hash, prefix + sizeof(SerializerDescriptor),
+                sizeof(TypeHashCode));
+    // Other streams and the type names written by old versions are left to
+    // Deserialize.
+    if ((descriptor.version_ & STREAM_FORMAT_VERSION_FLAG) != 0 ||
+        descriptor.c_style_type_name_size_ != 0) {
+      return MM::Reflection::Deserialize(data_buffer);
+    }
+    const TypeInfo* type_info = FindTypeInfo(type_name_hash);
+    if (type_info == nullptr) {
+      std::cerr << "[Error] [MMReflection] The type of the object (type name "
+                   "hash "
+                << type_name_hash
+                << ") is not registered or has no serializer.\n";
+      return Variable{};
+    }
+    data_buffer.ReadData(prefix, PREFIX_SIZE);
+
+    const Meta& meta = *type_info->meta_;
+    const DeserializerInfo deserializer_info{nullptr, descriptor.is_refrence_,
+                                             false};
+    if (type_info->plan_ != nullptr) {
+      Variable variable{};
+      SerializerBase::PreProcessDescriptor(meta, variable, deserializer_info);
+      std::memcpy(variable.GetValue(), meta.GetEmptyVariable().GetValue(),
+                  meta.GetType().GetSize());
+      if (type_info->plan_->Deserialize(data_buffer, variable.GetValue())) {
+        return variable;
+      }
+      // The object is split between segments, so the serializer reads it.
+      if (descriptor.is_refrence_) {
+        SerializerBase::FreeRefrenceObject(variable.GetValue());
+      }
+    }
+
+    return type_info->serializer_->Deserialize(data_buffer, meta,
+                                               deserializer_info);
+  }
+
+ private:
+  struct TypeInfo {
+    // nullptr if the type is not registered or has no serializer.
+    const Meta* meta_{nullptr};
+    const SerializerBase* serializer_{nullptr};
+    // nullptr if the serializer does not write the type by a plan.
+    std::shared_ptr<const SerializationPlan> plan_{};
+    TypeHashCode type_name_hash_{0};
+    std::uint32_t version_{0};
+  };
+
+  static TypeInfo CreateTypeInfo(const Meta& meta) {
+    TypeInfo type_info{};
+    type_info.serializer_ = FindSerializer(meta.GetSerializerName());
+    if (type_info.serializer_ == nullptr) {
+      return type_info;
+    }
+    type_info.meta_ = &meta;
+    type_info.plan_ = meta.GetSerializationPlan();
+    if (!type_info.plan_->IsValid()) {
+      type_info.plan_ = nullptr;
+    }
+    type_info.type_name_hash_ = Utils::HashString(meta.GetTypeName());
+    type_info.version_ = type_info.serializer_->GetVersion();
+
+    return type_info;
+  }
+
+  const TypeInfo& GetTypeInfo(const Meta& meta) {
+    auto type_info = types_by_meta_.find(&meta);
+    if (type_info == types_by_meta_.end()) {
+      type_info = types_by_meta_.emplace(&meta, CreateTypeInfo(meta)).first;
+    }
+    assert(type_info->second.serializer_ != nullptr);
+
+    return type_info->second;
+  }
+
+  const TypeInfo* FindTypeInfo(TypeHashCode type_name_hash) {
+    auto type_info = types_by_name_hash_.find(type_name_hash);
+    if (type_info == types_by_name_hash_.end()) {
+      const TypeHashCode* type_hash_code =
+          FindTypeHashCodeByNameHash(type_name_hash);
+      const Meta* meta =
+          type_hash_code == nullptr ? nullptr : FindMeta(*type_hash_code);
+      type_info = types_by_name_hash_
+                      .emplace(type_name_hash,
+                               meta == nullptr || !meta->HaveSerializer()
+                                   ? TypeInfo{}
+                                   : CreateTypeInfo(*meta))
+                      .first;
+    }
+
+    return type_info->second.meta_ == nullptr ? nullptr : &type_info->second;
+  }
+
+ private:
+  std::unordered_map<const Meta*, TypeInfo> types_by_meta_{};
+  std::unordered_map<TypeHashCode, TypeInfo> types_by_name_hash_{};
+};
+
+namespace {
+/**
+ * \brief Free the objects read into \ref variables and make the variables
+ * invalid.
+ * \remark The objects are read without an arena, so they are allocated by
+ * malloc.
+ */
+void ReleaseVariables(MM::Reflection::Variable* variables,
+                      std::uint64_t variable_number) {
+  for (std::uint64_t index = 0; index != variable_number; ++index) {
+    if (variables[index].IsValid() && variables[index].IsRefrenceVariable()) {
+      free(variables[index].GetValue());
+    }
+    variables[index].Destroy();
+  }
+}
+
+/**
+ * \brief Read the objects of one shard into \ref variables.
+ * \return Returns false if an object cannot be read or the objects do not end
+ * at the end of the shard. Then the objects read are released.
+ */
+bool ReadShard(const MM::Reflection::DataBuffer& data_buffer,
+               const MM::Reflection::ParallelShard& shard,
+               MM::Reflection::Variable* variables) {
+  MM::Reflection::ParallelShardCache shard_cache{};
+  const std::uint64_t end_offset =
+      data_buffer.GetReadDataOffset() + shard.data_size_;
+  for (std::uint64_t index = 0; index != shard.object_number_; ++index) {
+    variables[index] = shard_cache.Deserialize(data_buffer);
+    if (!variables[index].IsValid()) {
+      ReleaseVariables(variables, index);
+      return false;
+    }
+  }
+  if (data_buffer.GetReadDataOffset() != end_offset) {
+    ReleaseVariables(variables, shard.object_number_);
+    return false;
+  }
+
+  return true;
+}
+}  // namespace
+
+bool MM::Reflection::SerializeParallel(DataBuffer& data_buffer,
+                                       Variable* variables,
+                                       std::uint64_t variable_number,
+                                       std::uint32_t thread_number) {
+  for (std::uint64_t index = 0; index != variable_number; ++index) {
+    const Meta* meta = variables[index].GetMeta();
+    if (meta == nullptr || !meta->HaveSerializer()) {
+      std::cerr << "[Error] [MMReflection] The object " << index
+                << " has no serializer, so the objects cannot be written.\n";
+      return false;
+    }
+  }
+
+  const std::uint32_t shard_number = static_cast<std::uint32_t>(
+      (variable_number + PARALLEL_SHARD_OBJECT_NUMBER - 1) /
+      PARALLEL_SHARD_OBJECT_NUMBER);
+  thread_number = GetThreadNumber(thread_number, shard_number);
+  std::vector<DataBuffer> shard_buffers{};
+  shard_buffers.reserve(shard_number);
+  for (std::uint32_t shard_index = 0; shard_index != shard_number;
+       ++shard_index) {
+    shard_buffers.emplace_back(DataBuffer::CreateSegmented());
+  }
+  const auto get_shard_begin = [variable_number](std::uint32_t shard_index) {
+    return std::min<std::uint64_t>(shard_index * PARALLEL_SHARD_OBJECT_NUMBER,
+                                   variable_number);
+  };
+  std::atomic<std::uint32_t> next_shard_index{0};
+  RunOnThreads(thread_number, [&shard_buffers, &get_shard_begin,
+                               &next_shard_index, shard_number,
+                               variables](std::uint32_t) {
+    for (std::uint32_t shard_index = next_shard_index++;
+         shard_index < shard_number; shard_index = next_shard_index++) {
+      ParallelShardCache shard_cache{};
+      DataBuffer& shard_buffer = shard_buffers[shard_index];
+      const std::uint64_t end = get_shard_begin(shard_index + 1);
+      for (std::uint64_t index = get_shard_begin(shard_index); index != end;
+           ++index) {
+        shard_cache.Serialize(shard_buffer, variables[index]);
+      }
+    }
+  });
+
+  ParallelHeader header{};
+  header.shard_number_ = shard_number;
+  header.object_number_ = variable_number;
+  std::vector<ParallelShard> shards(shard_number);
+  std::uint64_t data_size = 0;
+  for (std::uint32_t shard_index = 0; shard_index != shard_number;
+       ++shard_index) {
+    shards[shard_index].data_offset_ = data_size;
+    shards[shard_index].data_size_ =
+        shard_buffers[shard_index].GetAddDataOffset();
+    shards[shard_index].object_number_ =
+        get_shard_begin(shard_index + 1) - get_shard_begin(shard_index);
+    data_size += shards[shard_index].data_size_;
+  }
+  data_buffer.AddData(&header, sizeof(ParallelHeader));
+  data_buffer.AddData(shards.data(), shards.size() * sizeof(ParallelShard));
+  if (data_size == 0) {
+    return true;
+  }
+
+  // A stream sends its data to the sink in order, so only other buffers are
+  // filled by the threads.
+  if (data_buffer.IsStream()) {
+    for (const DataBuffer& shard_buffer : shard_buffers) {
+      for (const DataSegment& segment : shard_buffer.GetSegments()) {
+        data_buffer.AddData(segment.data_, segment.size_);
+      }
+    }
+    return true;
+  }
+  auto* data = static_cast<std::uint8_t*>(data_buffer.AddEmptyData(data_size));
+  next_shard_index = 0;
+  RunOnThreads(thread_number, [&shard_buffers, &shards, &next_shard_index,
+                               shard_number, data](std::uint32_t) {
+    for (std::uint32_t shard_index = next_shard_index++;
+         shard_index < shard_number; shard_index = next_shard_index++) {
+      std::uint8_t* to = data + shards[shard_index].data_offset_;
+      for (const DataSegment& segment :
+           shard_buffers[shard_index].GetSegments()) {
+        std::memcpy(to, segment.data_, segment.size_);
+        to += segment.size_;
+      }
+    }
+  });
+
+  return true;
+}
+
+std::uint64_t MM::Reflection::GetParallelObjectNumber(
+    const DataBuffer& data_buffer) {
+  if (!data_buffer.CanReadData(sizeof(ParallelHeader))) {
+    return 0;
+  }
+  ParallelHeader header{};
+  data_buffer.PeekData(&header, sizeof(ParallelHeader));
+
+  return header.version_ == PARALLEL_SERIALIZER_VERSION ? header.object_number_
+                                                        : 0;
+}
+
+std::uint64_t MM::Reflection::DeserializeParallel(
+    const DataBuffer& data_buffer, Variable* variables,
+    std::uint64_t max_variable_number, std::uint32_t thread_number) {
+  if (!data_buffer.CanReadData(sizeof(ParallelHeader))) {
+    std::cerr << "[Error] [MMReflection] The data is too small to hold a "
+                 "parallel header.\n";
+    return 0;
+  }
+  ParallelHeader header{};
+  data_buffer.PeekData(&header, sizeof(ParallelHeader));
+  if (header.version_ != PARALLEL_SERIALIZER_VERSION) {
+    std::cerr << "[Error] [MMReflection] The data is not written by "
+                 "SerializeParallel.\n";
+    return 0;
+  }
+  if (header.object_number_ > max_variable_number) {
+    std::cerr << "[Error] [MMReflection] The data holds "
+              << header.object_number_ << " objects, but the array only holds "
+              << max_variable_number << ".\n";
+    return 0;
+  }
+  data_buffer.ReadData(&header, sizeof(ParallelHeader));
+  const std::uint64_t index_size =
+      header.shard_number_ * static_cast<std::uint64_t>(sizeof(ParallelShard));
+  if (!data_buffer.CanReadData(index_size)) {
+    std::cerr << "[Error] [MMReflection] The index of the shards is "
+                 "incomplete.\n";
+    return 0;
+  }
+  std::vector<ParallelShard> shards(header.shard_number_);
+  data_buffer.ReadData(shards.data(), index_size);
+
+  // The shards are adjacent, so the index also tells where each object goes.
+  std::vector<std::uint64_t> shard_begins(header.shard_number_ + 1, 0);
+  std::uint64_t data_size = 0;
+  for (std::uint32_t shard_index = 0; shard_index != header.shard_number_;
+       ++shard_index) {
+    if (shards[shard_index].data_offset_ != data_size) {
+      std::cerr << "[Error] [MMReflection] The shard " << shard_index
+                << " is not after the shard before it.\n";
+      return 0;
+    }
+    data_size += shards[shard_index].data_size_;
+    shard_begins[shard_index + 1] =
+        shard_begins[shard_index] + shards[shard_index].object_number_;
+  }
+  if (shard_begins.back() != header.object_number_) {
+    std::cerr << "[Error] [MMReflection] The shards hold "
+              << shard_begins.back() << " objects, but the header has "
+              << header.object_number_ << ".\n";
+    return 0;
+  }
+
+  // Some shards are read on the calling thread, which must not allocate from
+  // its arena while the other threads use malloc.
+  const VariableArenaScope no_arena_scope{};
+  if (data_buffer.IsStream()) {
+    for (std::uint32_t shard_index = 0; shard_index != header.shard_number_;
+         ++shard_index) {
+      if (!ReadShard(data_buffer, shards[shard_index],
+                     variables + shard_begins[shard_index])) {
+        std::cerr << "[Error] [MMReflection] The shard " << shard_index
+                  << " cannot be read.\n";
+        ReleaseVariables(variables, shard_begins[shard_index]);
+        return 0;
+      }
+    }
+    return header.object_number_;
+  }
+
+  if (!data_buffer.CanReadData(data_size)) {
+    std::cerr << "[Error] [MMReflection] The data of the shards is "
+                 "incomplete.\n";
+    return 0;
+  }
+  // Contiguous data is read in place by a reader per shard, and segmented data
+  // is copied out of the segments by a stream per shard.
+  const bool is_segmented = data_buffer.IsSegmented();
+  const std::vector<DataSegment> segments =
+      is_segmented ? data_buffer.GetSegments() : std::vector<DataSegment>{};
+  const std::uint64_t data_offset = data_buffer.GetReadDataOffset();
+  std::atomic<std::uint32_t> next_shard_index{0};
+  std::atomic<bool> is_failed{false};
+  std::vector<std::uint8_t> is_shard_read(header.shard_number_, 0);
+  RunOnThreads(
+      GetThreadNumber(thread_number, header.shard_number_),
+      [&](std::uint32_t) {
+        for (std::uint32_t shard_index = next_shard_index++;
+             shard_index < header.shard_number_ && !is_failed;
+             shard_index = next_shard_index++) {
+          const ParallelShard& shard = shards[shard_index];
+          bool is_read = false;
+          if (is_segmented) {
+            const DataBuffer shard_buffer =
+                DataBuffer::CreateReadStream(std::make_unique<ShardSource>(
+                    segments, data_offset + shard.data_offset_,
+                    shard.data_size_));
+            is_read = ReadShard(shard_buffer, shard,
+                                variables + shard_begins[shard_index]);
+          } else {
+            DataBufferReader shard_reader{
+                static_cast<const std::uint8_t*>(data_buffer.GetData()) +
+                    data_offset + shard.data_offset_,
+                shard.data_size_};
+            is_read = shard_reader.ReadWithDataBuffer(
+                [&shard, &shard_begins, shard_index,
+                 variables](const DataBuffer& shard_buffer) {
+                  return ReadShard(shard_buffer, shard,
+                                   variables + shard_begins[shard_index]);
+                });
+          }
+          if (!is_read) {
+            std::cerr << "[Error] [MMReflection] The shard " << shard_index
+                      << " cannot be read.\n";
+            is_failed = true;
+          }
+          is_shard_read[shard_index] = is_read;
+        }
+      });
+  if (is_failed) {
+    for (std::uint32_t shard_index = 0; shard_index != header.shard_number_;
+         ++shard_index) {
+      if (is_shard_read[shard_index] != 0) {
+        ReleaseVariables(variables + shard_begins[shard_index],
+                         shards[shard_index].object_number_);
+      }
+    }
+    return 0;
+  }
+  if (data_size != 0) {
+    data_buffer.ReadDataInPlace(data_size);
+  }
+
+  return header.object_number_;
+}
+
+std::uint64_t MM::Reflection::GetParallelObjectNumber(
+    const DataBufferReader& reader) {
+  DataBufferReader peek_reader{reader};
+  return peek_reader.ReadWithDataBuffer([](const DataBuffer& data_buffer) {
+    return GetParallelObjectNumber(data_buffer);
+  });
+}
+
+std::uint64_t MM::Reflection::DeserializeParallel(
+    DataBufferReader& reader, Variable* variables,
+    std::uint64_t max_variable_number, std::uint32_t thread_number) {
+  return reader.ReadWithDataBuffer([variables, max_variable_number,
+                                    thread_number](const DataBuffer& data_buffer) {
+    return DeserializeParallel(data_buffer, variables, max_variable_number,
+                               thread_number);
+  });
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+
+#include "serializer.h"
+
+namespace MM {
+namespace Reflection {
+/**
+ * \brief The version of the streams written by \ref SerializeParallel.
+ * \remark It is in the place of \ref SerializerDescriptor::version_, so
+ * \ref Deserialize can tell these streams apart and refuse them.
+ */
+constexpr std::uint32_t PARALLEL_SERIALIZER_VERSION = STREAM_FORMAT_VERSION_FLAG | 6;
+
+/**
+ * \brief The number of adjacent objects in each shard written by
+ * \ref SerializeParallel, except the last one.
+ * \remark It does not depend on the number of threads, so the threads share
+ * the work evenly when the objects differ in size, and the same objects are
+ * always written as the same bytes.
+ */
+constexpr std::uint64_t PARALLEL_SHARD_OBJECT_NUMBER = 256;
+
+/**
+ * \brief The serializer, plan and type name hash of each type of one shard,
+ * which \ref SerializeParallel and \ref DeserializeParallel look up once per
+ * shard instead of once per object.
+ */
+class ParallelShardCache;
+
+struct ParallelHeader {
+  // Same place as SerializerDescriptor::version_.
+  std::uint32_t version_{PARALLEL_SERIALIZER_VERSION};
+  std::uint32_t shard_number_{0};
+  std::uint64_t object_number_{0};
+};
+
+/**
+ * \brief The index entry of one shard of a \ref SerializeParallel stream.
+ */
+struct ParallelShard {
+  // From the end of the index.
+  std::uint64_t data_offset_{0};
+  std::uint64_t data_size_{0};
+  std::uint64_t object_number_{0};
+};
+
+/**
+ * \brief Write \ref variable_number objects on \ref thread_number threads.
+ * \param thread_number The number of threads, including the calling thread.
+ * 0 uses one thread per core.
+ * \return Returns false if an object has no serializer. Then nothing is
+ * written.
+ * \remark The objects are split into shards of
+ * \ref PARALLEL_SHARD_OBJECT_NUMBER adjacent objects, and each thread takes
+ * the next shard and writes it as \ref Serialize does into a buffer of its
+ * own. The stream is a \ref ParallelHeader, one \ref ParallelShard per
+ * shard, and then the data of the shards in order, copied by the threads too.
+ * \remark The objects must not be changed while they are written.
+ */
+bool SerializeParallel(DataBuffer& data_buffer, Variable* variables,
+                       std::uint64_t variable_number,
+                       std::uint32_t thread_number = 0);
+
+/**
+ * \brief Get the number of objects of the \ref SerializeParallel stream at
+ * the read position of \ref data_buffer, without reading it.
+ * \return Returns 0 if there is no such stream.
+ */
+std::uint64_t GetParallelObjectNumber(const DataBuffer& data_buffer);
+
+std::uint64_t GetParallelObjectNumber(const DataBufferReader& reader);
+
+/**
+ * \brief Read a stream written by \ref SerializeParallel, one shard per thread
+ * at a time.
+ * \param variables The address of an array of at least
+ * \ref max_variable_number variables. The objects are moved into them in the
+ * order they were written.
+ * \param thread_number The number of threads, including the calling thread.
+ * 0 uses one thread per core.
+ * \return Returns the number of objects read. Returns 0 if the stream has
+ * more objects than \ref max_variable_number or an object cannot be read.
+ * Then the objects already read are freed and their variables are invalid.
+ * \remark Pointers and refrences of the objects are allocated on the thread
+ * that reads them, so the current \ref VariableArena of the calling thread is
+ * not used, not even for the shards read on the calling thread.
+ * \remark A stream buffer (see \ref DataBuffer::CreateReadStream) cannot be
+ * read out of order, so its shards are read on the calling thread.
+ */
+std::uint64_t DeserializeParallel(const DataBuffer& data_buffer,
+                                  Variable* variables,
+                                  std::uint64_t max_variable_number,
+                                  std::uint32_t thread_number = 0);
+
+std::uint64_t DeserializeParallel(DataBufferReader& reader,
+                                  Variable* variables,
+                                  std::uint64_t max_variable_number,
+                                  std::uint32_t thread_number = 0);
+}  // namespace Reflection
+}  // namespace MM
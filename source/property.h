@@ -320,6 +320,106 @@ struct StaticRefrencePropertyDescriptor {
   ValueType* address_;
 };
 
+/**
+ * \brief A pre-resolved handle of a property of type \ref PropertyType.
+ * \remark It is created by \ref Property::MakeAccessor, which checks the
+ * property type once. \ref Get and \ref Set only add the property offset to
+ * the object address (or load the static address), so they do not look up
+ * names, call virtual functions or create \ref MM::Reflection::Variable.
+ * \remark The caller must guarantee that the object is of the class that
+ * holds the property.
+ */
+template <typename PropertyType>
+class PropertyAccessor {
+  friend class Property;
+
+ public:
+  using Type = std::remove_reference_t<PropertyType>;
+
+ public:
+  PropertyAccessor() = default;
+  ~PropertyAccessor() = default;
+  PropertyAccessor(const PropertyAccessor& other) = default;
+  PropertyAccessor(PropertyAccessor&& other) noexcept = default;
+  PropertyAccessor& operator=(const PropertyAccessor& other) = default;
+  PropertyAccessor& operator=(PropertyAccessor&& other) noexcept = default;
+
+ public:
+  /**
+   * \brief Judge whether the object is a valid object.
+   * \return Returns true if the object is a valid object, otherwise returns
+   * false.
+   */
+  bool IsValid() const { return get_function_ != nullptr; }
+
+  /**
+   * \brief Get the property of \ref object.
+   * \param object The address of the object that holds the property.
+   * \return The reference of the property.
+   * \remark The kind of the property (field, refrence field or static) is
+   * resolved once when the accessor is created, so this is one indirect call
+   * without branches.
+   */
+  Type& Get(void* object) const {
+    assert(IsValid());
+    return get_function_(*this, object);
+  }
+
+  const Type& Get(const void* object) const {
+    return Get(const_cast<void*>(object));
+  }
+
+  Type& Get(Variable& object) const {
+    return Get(object.GetValue());
+  }
+
+  const Type& Get(const Variable& object) const {
+    return Get(object.GetValue());
+  }
+
+  /**
+   * \brief Set the property of \ref object.
+   * \param object The address of the object that holds the property.
+   * \param value The new value of the property.
+   */
+  template <typename ValueType>
+  void Set(void* object, ValueType&& value) const {
+    Get(object) = std::forward<ValueType>(value);
+  }
+
+  template <typename ValueType>
+  void Set(Variable& object, ValueType&& value) const {
+    Get(object.GetValue()) = std::forward<ValueType>(value);
+  }
+
+ private:
+  using GetFunction = Type& (*)(const PropertyAccessor& accessor, void* object);
+
+  PropertyAccessor(std::uint64_t offset, bool is_refrence)
+      : offset_(offset), get_function_(is_refrence ? &GetRefrence : &GetField) {}
+
+  explicit PropertyAccessor(Type* static_address)
+      : static_address_(static_address),
+        get_function_(static_address != nullptr ? &GetStatic : nullptr) {}
+
+  static Type& GetField(const PropertyAccessor& accessor, void* object) {
+    return *reinterpret_cast<Type*>(static_cast<char*>(object) + accessor.offset_);
+  }
+
+  static Type& GetRefrence(const PropertyAccessor& accessor, void* object) {
+    return **reinterpret_cast<Type**>(static_cast<char*>(object) + accessor.offset_);
+  }
+
+  static Type& GetStatic(const PropertyAccessor& accessor, void*) {
+    return *accessor.static_address_;
+  }
+
+ private:
+  std::uint64_t offset_{0};
+  Type* static_address_{nullptr};
+  GetFunction get_function_{nullptr};
+};
+
 class Property {
   friend class Meta;
   friend class Variable;
@@ -408,6 +508,35 @@ class Property {
    */
   const Meta* GetClassMeta() const;
 
+  /**
+   * \brief Create a pre-resolved accessor of this property.
+   * \tparam PropertyType The type of this property. References and top level
+   * const are ignored when comparing it with the registered type.
+   * \return The accessor of this property.
+   * \remark If this object is invalid, the type of this property is not
+   * \ref PropertyType, or this property is const but \ref PropertyType is not,
+   * an invalid accessor will be returned.
+   */
+  template <typename PropertyType>
+  PropertyAccessor<PropertyType> MakeAccessor() const {
+    if (!IsValid()) {
+      return PropertyAccessor<PropertyType>{};
+    }
+    const MM::Reflection::Type* property_type = GetType();
+    if (property_type->GetTypeHashCode() != Utils::TypeHashCodeV<PropertyType>) {
+      return PropertyAccessor<PropertyType>{};
+    }
+    if (property_type->IsConst() && !Utils::IsConstV<PropertyType>) {
+      return PropertyAccessor<PropertyType>{};
+    }
+
+    if (IsStatic()) {
+      return PropertyAccessor<PropertyType>{
+          static_cast<typename PropertyAccessor<PropertyType>::Type*>(GetStaticPropertyAddress())};
+    }
+    return PropertyAccessor<PropertyType>{GetPropertyOffset(), property_type->IsReference()};
+  }
+
  private:
   /**
    * \brief Gets the variable that the attribute refers to.
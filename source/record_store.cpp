@@ -0,0 +1,359 @@
+#include "record_store.h"
+
+#include <array>
+#include <cstring>
+#include <iostream>
+
+namespace {
+// The size returned by SeekRecord for a damaged record.
+constexpr std::uint64_t INVALID_RECORD_SIZE = ~static_cast<std::uint64_t>(0);
+
+// The slice-by-8 step reads little-endian words, so other machines only use
+// the byte-wise step.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool IS_LITTLE_ENDIAN = false;
+#else
+constexpr bool IS_LITTLE_ENDIAN = true;
+#endif
+
+using Crc32cTable = std::array<std::array<std::uint32_t, 256>, 8>;
+
+Crc32cTable CreateCrc32cTable() {
+  // The reflected Castagnoli polynomial.
+  constexpr std::uint32_t POLYNOMIAL = 0x82F63B78u;
+  Crc32cTable table{};
+  for (std::uint32_t byte = 0; byte != 256; ++byte) {
+    std::uint32_t crc = byte;
+    for (int bit = 0; bit != 8; ++bit) {
+      crc = (crc >> 1) ^ (POLYNOMIAL & (0u - (crc & 1u)));
+    }
+    table[0][byte] = crc;
+  }
+  // table[n] is the CRC of a byte followed by n zero bytes, so 8 bytes are
+  // handled in each step.
+  for (std::uint32_t byte = 0; byte != 256; ++byte) {
+    for (std::size_t slice = 1; slice != 8; ++slice) {
+      const std::uint32_t crc = table[slice - 1][byte];
+      table[slice][byte] = (crc >> 8) ^ table[0][crc & 0xFFu];
+    }
+  }
+
+  return table;
+}
+
+std::uint32_t Crc32c(const void* data, std::uint64_t size) {
+  static const Crc32cTable table = CreateCrc32cTable();
+  const auto* bytes = static_cast<const std::uint8_t*>(data);
+  std::uint32_t crc = 0xFFFFFFFFu;
+  if constexpr (IS_LITTLE_ENDIAN) {
+    for (; size >= 8; size -= 8, bytes += 8) {
+      std::uint32_t low{0};
+      std::uint32_t high{0};
+      std::memcpy(&low, bytes, sizeof(std::uint32_t));
+      std::memcpy(&high, bytes + 4, sizeof(std::uint32_t));
+      low ^= crc;
+      crc = table[7][low & 0xFFu] ^ table[6][(low >> 8) & 0xFFu] ^
+            table[5][(low >> 16) & 0xFFu] ^ table[4][low >> 24] ^
+            table[3][high & 0xFFu] ^ table[2][(high >> 8) & 0xFFu] ^
+            table[1][(high >> 16) & 0xFFu] ^ table[0][high >> 24];
+    }
+  }
+  for (; size != 0; --size, ++bytes) {
+    crc = (crc >> 8) ^ table[0][(crc ^ *bytes) & 0xFFu];
+  }
+
+  return ~crc;
+}
+}  // namespace
+
+MM::Reflection::RecordWriter::RecordWriter(DataBuffer& data_buffer)
+    : data_buffer_(data_buffer),
+      start_offset_(data_buffer.GetAddDataOffset()) {
+  const RecordStoreHeader header{};
+  data_buffer_.AddData(&header, sizeof(RecordStoreHeader));
+}
+
+bool MM::Reflection::RecordWriter::AddRecord(Variable& variable) {
+  record_.Clear();
+  Serialize(record_, variable);
+
+  return AddRecordHeader(record_.GetData(), record_.GetAddDataOffset());
+}
+
+bool MM::Reflection::RecordWriter::AddRecordData(const void* data_from,
+                                                 std::uint64_t size) {
+  return AddRecordHeader(data_from, size);
+}
+
+std::uint64_t MM::Reflection::RecordWriter::GetRecordNumber() const {
+  return record_offsets_.size();
+}
+
+MM::Reflection::DataBuffer& MM::Reflection::RecordWriter::Finish() {
+  if (is_finished_) {
+    return data_buffer_;
+  }
+  is_finished_ = true;
+
+  RecordStoreFooter footer{};
+  footer.index_offset_ = data_buffer_.GetAddDataOffset() - start_offset_;
+  footer.record_number_ = record_offsets_.size();
+  const std::uint64_t index_size =
+      record_offsets_.size() * sizeof(std::uint64_t);
+  footer.index_checksum_ = Crc32c(record_offsets_.data(), index_size);
+  if (index_size != 0) {
+    data_buffer_.AddData(record_offsets_.data(), index_size);
+  }
+  data_buffer_.AddData(&footer, sizeof(RecordStoreFooter));
+
+  return data_buffer_;
+}
+
+bool MM::Reflection::RecordWriter::AddRecordHeader(const void* data_from,
+                                                   std::uint64_t size) {
+  if (is_finished_) {
+    std::cerr << "[Error] [MMReflection] The record store is finished, so no "
+                 "record can be added.\n";
+    return false;
+  }
+  if (size > ~static_cast<std::uint32_t>(0)) {
+    std::cerr << "[Error] [MMReflection] The record of " << size
+              << " bytes is larger than 4 GB.\n";
+    return false;
+  }
+
+  record_offsets_.push_back(data_buffer_.GetAddDataOffset() - start_offset_);
+  const RecordHeader record_header{static_cast<std::uint32_t>(size),
+                                   Crc32c(data_from, size)};
+  data_buffer_.AddData(&record_header, sizeof(RecordHeader));
+  if (size != 0) {
+    data_buffer_.AddData(data_from, size);
+  }
+
+  return true;
+}
+
+bool MM::Reflection::RecordReader::Open(const std::string& file_name) {
+  DataBuffer data_buffer{};
+  if (!data_buffer.MapFile(file_name)) {
+    return false;
+  }
+
+  return Open(std::move(data_buffer));
+}
+
+bool MM::Reflection::RecordReader::Open(DataBuffer&& data_buffer) {
+  data_buffer_ = std::move(data_buffer);
+  record_number_ = 0;
+  index_data_ = nullptr;
+  index_.clear();
+  is_recovered_ = false;
+  is_valid_ = false;
+
+  if (data_buffer_.IsStream() ||
+      data_buffer_.GetAddDataOffset() < sizeof(RecordStoreHeader)) {
+    std::cerr << "[Error] [MMReflection] The data is too small to hold a "
+                 "record store, or it is a stream.\n";
+    return false;
+  }
+  // The records are read in place by a reader, which needs contiguous data.
+  if (data_buffer_.IsSegmented()) {
+    DataBuffer contiguous_buffer{};
+    contiguous_buffer.Reserver(data_buffer_.GetAddDataOffset());
+    for (const DataSegment& segment : data_buffer_.GetSegments()) {
+      contiguous_buffer.AddData(segment.data_, segment.size_);
+    }
+    data_buffer_ = std::move(contiguous_buffer);
+  }
+  RecordStoreHeader header{};
+  CreateReader().PeekData(&header, sizeof(RecordStoreHeader));
+  if (header.version_ != RECORD_STORE_VERSION) {
+    std::cerr << "[Error] [MMReflection] The data is not a record store.\n";
+    return false;
+  }
+
+  is_valid_ = ReadIndex() || RebuildIndex();
+
+  return is_valid_;
+}
+
+bool MM::Reflection::RecordReader::IsValid() const { return is_valid_; }
+
+bool MM::Reflection::RecordReader::IsRecovered() const { return is_recovered_; }
+
+std::uint64_t MM::Reflection::RecordReader::GetRecordNumber() const {
+  return record_number_;
+}
+
+bool MM::Reflection::RecordReader::ReadRecordData(
+    std::uint64_t record_index, std::vector<std::uint8_t>& data_to) const {
+  DataBufferReader reader = CreateReader();
+  const std::uint64_t size = SeekRecord(record_index, reader);
+  if (size == INVALID_RECORD_SIZE) {
+    return false;
+  }
+  data_to.resize(size);
+  if (size != 0) {
+    reader.PeekData(data_to.data(), size);
+  }
+
+  return true;
+}
+
+MM::Reflection::Variable MM::Reflection::RecordReader::ReadRecord(
+    std::uint64_t record_index) const {
+  DataBufferReader reader = CreateReader();
+  const std::uint64_t size = SeekRecord(record_index, reader);
+  if (size == INVALID_RECORD_SIZE) {
+    return Variable{};
+  }
+
+  // The object is read from the data of the record only, so a damaged object
+  // cannot read past the record.
+  DataBufferReader record_reader{
+      static_cast<const std::uint8_t*>(reader.GetData()) +
+          reader.GetReadDataOffset(),
+      size};
+  Variable variable = Deserialize(record_reader);
+  if (!variable.IsValid()) {
+    return variable;
+  }
+  // The serializers that trust their data do not check the end, so an object
+  // that was read past the record is refused here.
+  if (record_reader.GetReadDataOffset() > size) {
+    std::cerr << "[Error] [MMReflection] The object of the record "
+              << record_index << " is read past the end of the record.\n";
+    if (variable.IsRefrenceVariable()) {
+      SerializerBase::FreeRefrenceObject(variable.GetValue());
+    }
+    return Variable{};
+  }
+  if (record_reader.GetReadDataOffset() != size) {
+    std::cerr << "[Error] [MMReflection] The object of the record "
+              << record_index << " does not end at the end of the record.\n";
+  }
+
+  return variable;
+}
+
+std::uint64_t MM::Reflection::RecordReader::ReadRecords(
+    std::uint64_t begin_index, std::uint64_t end_index,
+    const std::function<bool(std::uint64_t, Variable&)>& callback) const {
+  std::uint64_t read_number = 0;
+  for (std::uint64_t record_index = begin_index;
+       record_index < end_index && record_index < record_number_;
+       ++record_index) {
+    Variable variable = ReadRecord(record_index);
+    if (!variable.IsValid()) {
+      break;
+    }
+    ++read_number;
+    if (!callback(record_index, variable)) {
+      break;
+    }
+  }
+
+  return read_number;
+}
+
+bool MM::Reflection::RecordReader::ReadIndex() {
+  const std::uint64_t store_size = data_buffer_.GetAddDataOffset();
+  if (store_size < sizeof(RecordStoreHeader) + sizeof(RecordStoreFooter)) {
+    return false;
+  }
+  DataBufferReader reader = CreateReader();
+  RecordStoreFooter footer{};
+  reader.SetReadDataOffset(store_size - sizeof(RecordStoreFooter));
+  reader.PeekData(&footer, sizeof(RecordStoreFooter));
+  const std::uint64_t index_size =
+      footer.record_number_ * sizeof(std::uint64_t);
+  if (footer.magic_ != RECORD_STORE_MAGIC ||
+      footer.index_offset_ < sizeof(RecordStoreHeader) ||
+      footer.record_number_ > store_size / sizeof(std::uint64_t) ||
+      footer.index_offset_ + index_size + sizeof(RecordStoreFooter) !=
+          store_size) {
+    return false;
+  }
+
+  reader.SetReadDataOffset(footer.index_offset_);
+  const void* index_data = reader.PeekDataInPlace(index_size);
+  if (Crc32c(index_data, index_size) != footer.index_checksum_) {
+    std::cerr << "[Error] [MMReflection] The index of the record store is "
+                 "damaged.\n";
+    return false;
+  }
+
+  index_data_ = static_cast<const std::uint8_t*>(index_data);
+  record_number_ = footer.record_number_;
+  return true;
+}
+
+bool MM::Reflection::RecordReader::RebuildIndex() {
+  std::cerr << "[Error] [MMReflection] The record store has no valid footer, "
+               "so its index is rebuilt from the records.\n";
+  is_recovered_ = true;
+  index_.clear();
+
+  DataBufferReader reader = CreateReader();
+  const std::uint64_t store_size = reader.GetSize();
+  std::uint64_t record_offset = sizeof(RecordStoreHeader);
+  while (store_size - record_offset >= sizeof(RecordHeader)) {
+    RecordHeader record_header{};
+    reader.SetReadDataOffset(record_offset);
+    reader.ReadData(&record_header, sizeof(RecordHeader));
+    if (!reader.CanReadData(record_header.size_) ||
+        Crc32c(reader.PeekDataInPlace(record_header.size_),
+               record_header.size_) != record_header.checksum_) {
+      break;
+    }
+    index_.push_back(record_offset);
+    record_offset += sizeof(RecordHeader) + record_header.size_;
+  }
+
+  index_data_ = reinterpret_cast<const std::uint8_t*>(index_.data());
+  record_number_ = index_.size();
+  return true;
+}
+
+MM::Reflection::DataBufferReader MM::Reflection::RecordReader::CreateReader()
+    const {
+  return DataBufferReader{data_buffer_.GetData(),
+                          data_buffer_.GetAddDataOffset()};
+}
+
+std::uint64_t MM::Reflection::RecordReader::GetRecordOffset(
+    std::uint64_t record_index) const {
+  std::uint64_t record_offset{0};
+  std::memcpy(&record_offset, index_data_ + record_index * sizeof(std::uint64_t),
+              sizeof(std::uint64_t));
+
+  return record_offset;
+}
+
+std::uint64_t MM::Reflection::RecordReader::SeekRecord(
+    std::uint64_t record_index, DataBufferReader& reader) const {
+  if (!is_valid_ || record_index >= record_number_) {
+    std::cerr << "[Error] [MMReflection] The record store has no record "
+              << record_index << ".\n";
+    return INVALID_RECORD_SIZE;
+  }
+
+  const std::uint64_t record_offset = GetRecordOffset(record_index);
+  RecordHeader record_header{};
+  if (!reader.SetReadDataOffset(record_offset) ||
+      !reader.CanReadData(sizeof(RecordHeader))) {
+    std::cerr << "[Error] [MMReflection] The offset of the record "
+              << record_index << " is out of the record store.\n";
+    return INVALID_RECORD_SIZE;
+  }
+  reader.ReadData(&record_header, sizeof(RecordHeader));
+  if (!reader.CanReadData(record_header.size_) ||
+      Crc32c(reader.PeekDataInPlace(record_header.size_),
+             record_header.size_) != record_header.checksum_) {
+    std::cerr << "[Error] [MMReflection] The record " << record_index
+              << " is damaged.\n";
+    return INVALID_RECORD_SIZE;
+  }
+
+  return record_header.size_;
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "serializer.h"
+
+namespace MM {
+namespace Reflection {
+/**
+ * \brief The version of the streams written by \ref RecordWriter.
+ * \remark It is in the place of \ref SerializerDescriptor::version_, so
+ * \ref Deserialize can tell these streams apart and refuse them.
+ */
+constexpr std::uint32_t RECORD_STORE_VERSION = STREAM_FORMAT_VERSION_FLAG | 7;
+
+/**
+ * \brief The last 4 bytes of a finished record store.
+ */
+constexpr std::uint32_t RECORD_STORE_MAGIC = 0x53524D4Du;
+
+struct RecordStoreHeader {
+  // Same place as SerializerDescriptor::version_.
+  std::uint32_t version_{RECORD_STORE_VERSION};
+  std::uint32_t reserved_{0};
+};
+
+/**
+ * \brief The length prefix of a record.
+ */
+struct RecordHeader {
+  std::uint32_t size_{0};
+  // The CRC-32C of the data of the record.
+  std::uint32_t checksum_{0};
+};
+
+/**
+ * \brief The end of a finished record store. It follows the index, which is
+ * the 8 bytes offset of each \ref RecordHeader from the start of the store.
+ */
+struct RecordStoreFooter {
+  std::uint64_t index_offset_{0};
+  std::uint64_t record_number_{0};
+  // The CRC-32C of the index.
+  std::uint32_t index_checksum_{0};
+  std::uint32_t magic_{RECORD_STORE_MAGIC};
+};
+
+/**
+ * \brief Append records to a data buffer in the record store format.
+ * \remark The store is a \ref RecordStoreHeader, one \ref RecordHeader and the
+ * data per record, and after \ref Finish the index of the records and a
+ * \ref RecordStoreFooter.
+ * \remark Records are written to the buffer when they are added, so the
+ * buffer can be a write stream to a file (see
+ * \ref DataBuffer::CreateWriteStream). Only the index is kept in memory.
+ * \remark A store that was not finished (such as after a crash) can still be
+ * read up to the last complete record, see \ref RecordReader.
+ */
+class RecordWriter {
+ public:
+  /**
+   * \brief Write the header of the store to \ref data_buffer.
+   * \remark The store starts at the add position of \ref data_buffer, and the
+   * buffer must outlive this writer.
+   */
+  explicit RecordWriter(DataBuffer& data_buffer);
+  ~RecordWriter() = default;
+  RecordWriter(const RecordWriter& other) = delete;
+  RecordWriter(RecordWriter&& other) = delete;
+  RecordWriter& operator=(const RecordWriter& other) = delete;
+  RecordWriter& operator=(RecordWriter&& other) = delete;
+
+ public:
+  /**
+   * \brief Add the record of \ref variable, written by \ref Serialize.
+   * \return Returns false if the store is finished or the record is larger
+   * than 4 GB.
+   */
+  bool AddRecord(Variable& variable);
+
+  /**
+   * \brief Add a record with the bytes of \ref data_from.
+   */
+  bool AddRecordData(const void* data_from, std::uint64_t size);
+
+  std::uint64_t GetRecordNumber() const;
+
+  /**
+   * \brief Write the index and the footer. No record can be added later.
+   */
+  DataBuffer& Finish();
+
+ private:
+  bool AddRecordHeader(const void* data_from, std::uint64_t size);
+
+ private:
+  DataBuffer& data_buffer_;
+  std::uint64_t start_offset_{0};
+  std::vector<std::uint64_t> record_offsets_{};
+  // Holds the serialized object, so that its size is known before it is added.
+  DataBuffer record_{};
+  bool is_finished_{false};
+};
+
+/**
+ * \brief Read the records of a store written by \ref RecordWriter in any
+ * order.
+ * \remark Opening only reads the footer and checks the index, and fetching a
+ * record only looks up its offset in the index. The checksum of a record is
+ * checked each time it is fetched.
+ * \remark If the store has no valid footer, the index is rebuilt by reading
+ * the length prefixes from the start, up to the first incomplete or damaged
+ * record.
+ * \remark Each fetch reads the data through a \ref DataBufferReader of its
+ * own, so several threads can fetch records from one reader at once.
+ */
+class RecordReader {
+ public:
+  RecordReader() = default;
+  ~RecordReader() = default;
+  RecordReader(const RecordReader& other) = delete;
+  RecordReader(RecordReader&& other) noexcept = default;
+  RecordReader& operator=(const RecordReader& other) = delete;
+  RecordReader& operator=(RecordReader&& other) noexcept = default;
+
+ public:
+  /**
+   * \brief Map the file (see \ref DataBuffer::MapFile) and read its index.
+   * \return Returns false if the file cannot be mapped or is not a record
+   * store.
+   */
+  bool Open(const std::string& file_name);
+
+  /**
+   * \brief Read the index of the store at the start of \ref data_buffer.
+   * \remark \ref data_buffer must not be a stream. A segmented buffer is
+   * copied to contiguous memory.
+   */
+  bool Open(DataBuffer&& data_buffer);
+
+  bool IsValid() const;
+
+  /**
+   * \return Returns true if the store had no valid footer and its index was
+   * rebuilt.
+   */
+  bool IsRecovered() const;
+
+  std::uint64_t GetRecordNumber() const;
+
+  /**
+   * \brief Copy the data of the record \ref record_index to \ref data_to.
+   * \return Returns false if there is no such record or its checksum does not
+   * match.
+   */
+  bool ReadRecordData(std::uint64_t record_index,
+                      std::vector<std::uint8_t>& data_to) const;
+
+  /**
+   * \brief Read the object of the record \ref record_index.
+   * \return The object. It is invalid if there is no such record, its checksum
+   * does not match or it cannot be read by \ref Deserialize from the data of
+   * the record alone.
+   */
+  Variable ReadRecord(std::uint64_t record_index) const;
+
+  /**
+   * \brief Read the objects of the records in [\ref begin_index,
+   * \ref end_index) in order and pass each to \ref callback.
+   * \return Returns the number of records passed. It stops at the first
+   * record that cannot be read, or when \ref callback returns false.
+   */
+  std::uint64_t ReadRecords(
+      std::uint64_t begin_index, std::uint64_t end_index,
+      const std::function<bool(std::uint64_t, Variable&)>& callback) const;
+
+ private:
+  bool ReadIndex();
+
+  bool RebuildIndex();
+
+  DataBufferReader CreateReader() const;
+
+  std::uint64_t GetRecordOffset(std::uint64_t record_index) const;
+
+  /**
+   * \brief Check the record and move the read position of \ref reader to its
+   * data.
+   * \return Returns the size of the data, or ~0 if the record is damaged.
+   */
+  std::uint64_t SeekRecord(std::uint64_t record_index,
+                           DataBufferReader& reader) const;
+
+ private:
+  DataBuffer data_buffer_{};
+  std::uint64_t record_number_{0};
+  // The index in the buffer, or index_ if it is rebuilt.
+  const std::uint8_t* index_data_{nullptr};
+  std::vector<std::uint64_t> index_{};
+  bool is_recovered_{false};
+  bool is_valid_{false};
+};
+}  // namespace Reflection
+}  // namespace MM
@@ -1,4 +1,12 @@
 #pragma once
 
+#include "batch_serializer.h"
+#include "delta_serializer.h"
+#include "graph_serializer.h"
+#include "parallel_serializer.h"
+#include "record_store.h"
 #include "registration.h"
+#include "schema_serializer.h"
+#include "serialization_plan.h"
+#include "serialized_view.h"
 #include "serializer.h"
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "constructor.h"
 #include "method.h"
 #include "property.h"
+#include "serializer.h"
 #include "meta.h"
 #include "type_utils.h"
 #include "marco.h"
@@ -201,6 +202,8 @@ protected:
         }
       }
 
+      old_meta->RebuildNameIndex();
+
       SetEmptyObject(*old_meta);
       if (old_meta->GetSerializerName() != serializer_name_) {
         old_meta->SetSerializerName(serializer_name_);
@@ -215,9 +218,19 @@ protected:
 
     auto name_to_hash_emplace_result = name_to_type_database.emplace(std::pair{meta_.GetTypeName(), meta_.GetType().GetTypeHashCode()});
     assert(name_to_hash_emplace_result.second);
+    auto name_hash_to_hash_emplace_result = GetNameHashToTypeHashDatabase().emplace(
+        std::pair{Utils::HashString(meta_.GetTypeName()), meta_.GetType().GetTypeHashCode()});
+    if (!name_hash_to_hash_emplace_result.second) {
+      std::cerr << "[Error] [MMReflecion] The hash of the reflection type name " << meta_.GetTypeName() << " collides with another registered type name." << std::endl;
+      abort();
+    }
     auto type_hash_code = meta_.GetType().GetTypeHashCode();
     auto meta_data_emplace_result = meta_database.emplace(std::pair{type_hash_code, new Meta{std::move(meta_)}});
     assert(meta_data_emplace_result.second);
+    // A frozen registry only looks in its flat tables.
+    if (IsRegistryFrozen()) {
+      FreezeRegistry();
+    }
   }
 
 private:
@@ -321,8 +334,18 @@ void RegisterSerializer() {
   if (serializer_database.count(new_serializer->GetSerializerName()) != 0) {
     return;
   }
+  if ((new_serializer->GetVersion() & STREAM_FORMAT_VERSION_FLAG) != 0) {
+    std::cerr << "[Error] [MMReflection] The version of serializer "
+              << new_serializer->GetSerializerName()
+              << " is reserved for stream formats.\n";
+    delete new_serializer;
+    return;
+  }
 
   serializer_database.emplace(new_serializer->GetSerializerName(), new_serializer);
+  if (IsRegistryFrozen()) {
+    FreezeRegistry();
+  }
 }
 }  // namespace Reflection
 }  // namespace MM
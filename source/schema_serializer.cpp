@@ -0,0 +1,408 @@
+#include "schema_serializer.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace {
+enum SchemaLayoutState : std::uint8_t {
+  UNKNOWN,
+  CHECKING,
+  SAME_LAYOUT,
+  DIFFERENT_LAYOUT
+};
+
+bool GetSchemaTypeKind(const MM::Reflection::Meta& meta,
+                       MM::Reflection::SchemaTypeKind& kind) {
+  if (meta.GetSerializerName() ==
+      MM::Reflection::TrivialSerializer::GetSerializerNameStatic()) {
+    kind = MM::Reflection::SchemaTypeKind::TRIVIAL;
+    return true;
+  }
+  if (meta.GetSerializerName() ==
+      MM::Reflection::UnsefeRecursionSerializer::GetSerializerNameStatic()) {
+    kind = MM::Reflection::SchemaTypeKind::RECURSION;
+    return true;
+  }
+
+  return false;
+}
+}  // namespace
+
+bool MM::Reflection::SchemaWriter::AddObject(Variable& variable) {
+  const Meta* meta = variable.GetMeta();
+  if (meta == nullptr) {
+    std::cerr << "[Error] [MMReflection] The type of the variable is not "
+                 "registered, so it cannot be written with a schema.\n";
+    return false;
+  }
+  const std::shared_ptr<const SerializationPlan> plan =
+      meta->GetSchemaSerializationPlan();
+  if (!plan->IsValid()) {
+    std::cerr << "[Error] [MMReflection] The type named " << meta->GetTypeName()
+              << " does not use the "
+              << TrivialSerializer::GetSerializerNameStatic() << " or "
+              << UnsefeRecursionSerializer::GetSerializerNameStatic()
+              << " serializer for all nested types, so it cannot be written "
+                 "with a schema.\n";
+    return false;
+  }
+
+  const bool is_refrence = variable.IsPropertyVariable()
+                               ? (variable.GetPropertyRealType()->IsReference() ||
+                                  variable.GetPropertyRealType()->IsPointer())
+                               : (variable.GetType()->IsReference() ||
+                                  variable.GetType()->IsPointer());
+  std::uint32_t record_header = AddType(*meta);
+  if (is_refrence) {
+    record_header |= SCHEMA_RECORD_REFRENCE_FLAG;
+  }
+  records_.AddData(&record_header, sizeof(std::uint32_t));
+  plan->Serialize(records_, SerializerBase::GetVariableValuePtr(variable));
+  ++object_number_;
+
+  return true;
+}
+
+std::uint32_t MM::Reflection::SchemaWriter::GetObjectNumber() const {
+  return object_number_;
+}
+
+MM::Reflection::DataBuffer& MM::Reflection::SchemaWriter::Finish(
+    DataBuffer& data_buffer) {
+  SchemaHeader header{};
+  header.type_number_ = static_cast<std::uint32_t>(types_.size());
+  header.property_number_ = property_number_;
+  header.object_number_ = object_number_;
+  data_buffer.AddData(&header, sizeof(SchemaHeader));
+
+  for (const Meta* meta : types_) {
+    const std::shared_ptr<const SerializationPlan> plan =
+        meta->GetSchemaSerializationPlan();
+    SchemaType schema_type{};
+    schema_type.type_name_hash_ = plan->GetTypeNameHash();
+    schema_type.size_ = static_cast<std::uint32_t>(meta->GetType().GetSize());
+    GetSchemaTypeKind(*meta, schema_type.kind_);
+    schema_type.property_number_ =
+        static_cast<std::uint16_t>(plan->GetSchemaProperties().size());
+    data_buffer.AddData(&schema_type, sizeof(SchemaType));
+
+    for (const auto& property_info : plan->GetSchemaProperties()) {
+      SchemaProperty schema_property{};
+      schema_property.property_name_hash_ = property_info.name_hash_;
+      schema_property.type_index_ = type_indexes_.at(property_info.meta_);
+      schema_property.is_refrence_ = property_info.is_refrence_;
+      data_buffer.AddData(&schema_property, sizeof(SchemaProperty));
+    }
+  }
+
+  for (const DataSegment& segment : records_.GetSegments()) {
+    data_buffer.AddData(segment.data_, segment.size_);
+  }
+
+  types_.clear();
+  type_indexes_.clear();
+  property_number_ = 0;
+  object_number_ = 0;
+  records_.Clear();
+
+  return data_buffer;
+}
+
+std::uint32_t MM::Reflection::SchemaWriter::AddType(const Meta& meta) {
+  const auto type_index = type_indexes_.find(&meta);
+  if (type_index != type_indexes_.end()) {
+    return type_index->second;
+  }
+
+  const auto new_type_index = static_cast<std::uint32_t>(types_.size());
+  types_.push_back(&meta);
+  type_indexes_.emplace(&meta, new_type_index);
+
+  for (const auto& property_info :
+       meta.GetSchemaSerializationPlan()->GetSchemaProperties()) {
+    AddType(*property_info.meta_);
+    ++property_number_;
+  }
+
+  return new_type_index;
+}
+
+MM::Reflection::SchemaReader::SchemaReader(const DataBuffer& data_buffer)
+    : data_buffer_(data_buffer) {
+  is_valid_ = ReadSchema();
+}
+
+MM::Reflection::SchemaReader::SchemaReader(DataBufferReader& reader)
+    : reader_data_buffer_(DataBuffer::CreateView(reader.GetData(),
+                                                 reader.GetSize(),
+                                                 reader.GetReadDataOffset())),
+      reader_(&reader),
+      data_buffer_(reader_data_buffer_) {
+  is_valid_ = ReadSchema();
+  reader_->SetReadDataOffset(data_buffer_.GetReadDataOffset());
+}
+
+bool MM::Reflection::SchemaReader::IsValid() const { return is_valid_; }
+
+std::uint32_t MM::Reflection::SchemaReader::GetObjectNumber() const {
+  return header_.object_number_;
+}
+
+bool MM::Reflection::SchemaReader::HaveObject() const {
+  return is_valid_ && read_object_number_ < header_.object_number_;
+}
+
+MM::Reflection::Variable MM::Reflection::SchemaReader::ReadObject() {
+  Variable variable = ReadNextObject();
+  if (reader_ != nullptr) {
+    reader_->SetReadDataOffset(data_buffer_.GetReadDataOffset());
+  }
+
+  return variable;
+}
+
+MM::Reflection::Variable MM::Reflection::SchemaReader::ReadNextObject() {
+  if (!HaveObject()) {
+    return Variable{};
+  }
+  ++read_object_number_;
+
+  std::uint32_t record_header{0};
+  data_buffer_.ReadData(&record_header, sizeof(std::uint32_t));
+  const bool is_refrence = (record_header & SCHEMA_RECORD_REFRENCE_FLAG) != 0;
+  const std::uint32_t type_index = record_header & ~SCHEMA_RECORD_REFRENCE_FLAG;
+  if (type_index >= types_.size()) {
+    std::cerr << "[Error] [MMReflection] The record refers to type " << type_index
+              << ", but the schema only has " << types_.size() << " types.\n";
+    is_valid_ = false;
+    return Variable{};
+  }
+
+  const TypeInfo& type_info = types_[type_index];
+  if (type_info.meta_ == nullptr) {
+    std::cerr << "[Error] [MMReflection] The type of the record (type name hash "
+              << type_info.schema_type_.type_name_hash_
+              << ") is not registered or cannot be read.\n";
+    ReadBody(type_index, nullptr);
+    return Variable{};
+  }
+
+  Variable variable{};
+  SerializerBase::PreProcessDescriptor(
+      *type_info.meta_, variable, DeserializerInfo{nullptr, is_refrence, false});
+  if (type_info.schema_type_.kind_ == SchemaTypeKind::RECURSION) {
+    memcpy(variable.GetValue(), type_info.meta_->GetEmptyVariable().GetValue(),
+           type_info.meta_->GetType().GetSize());
+  }
+  ReadBody(type_index, static_cast<std::uint8_t*>(variable.GetValue()));
+
+  return variable;
+}
+
+bool MM::Reflection::SchemaReader::ReadSchema() {
+  if (!data_buffer_.CanReadData(sizeof(SchemaHeader))) {
+    std::cerr << "[Error] [MMReflection] The data is too small to hold a schema "
+                 "header.\n";
+    return false;
+  }
+  data_buffer_.ReadData(&header_, sizeof(SchemaHeader));
+  if (header_.version_ != SCHEMA_SERIALIZER_VERSION) {
+    std::cerr << "[Error] [MMReflection] The data is not written with a schema "
+                 "(version "
+              << header_.version_ << ").\n";
+    return false;
+  }
+  const std::uint64_t schema_size =
+      header_.type_number_ * sizeof(SchemaType) +
+      header_.property_number_ * static_cast<std::uint64_t>(sizeof(SchemaProperty));
+  if (!data_buffer_.CanReadData(schema_size)) {
+    std::cerr << "[Error] [MMReflection] The schema table is truncated.\n";
+    return false;
+  }
+
+  types_.resize(header_.type_number_);
+  properties_.reserve(header_.property_number_);
+  for (TypeInfo& type_info : types_) {
+    data_buffer_.ReadData(&type_info.schema_type_, sizeof(SchemaType));
+    type_info.first_property_ = properties_.size();
+    if (properties_.size() + type_info.schema_type_.property_number_ >
+        header_.property_number_) {
+      std::cerr << "[Error] [MMReflection] The schema table has more properties "
+                   "than its header.\n";
+      return false;
+    }
+    for (std::uint16_t index = 0;
+         index != type_info.schema_type_.property_number_; ++index) {
+      PropertyInfo property_info{};
+      data_buffer_.ReadData(&property_info.schema_property_,
+                            sizeof(SchemaProperty));
+      if (property_info.schema_property_.type_index_ >= header_.type_number_) {
+        std::cerr << "[Error] [MMReflection] The schema table refers to a type "
+                     "that does not exist.\n";
+        return false;
+      }
+      properties_.push_back(property_info);
+    }
+    MatchType(type_info);
+  }
+
+  for (const TypeInfo& type_info : types_) {
+    MatchProperties(type_info);
+  }
+
+  std::vector<std::uint8_t> states(types_.size(), UNKNOWN);
+  for (std::uint32_t type_index = 0; type_index != types_.size(); ++type_index) {
+    TypeInfo& type_info = types_[type_index];
+    type_info.use_plan_ = IsSameLayout(type_index, states) &&
+                          type_info.plan_->IsValid();
+  }
+
+  return true;
+}
+
+void MM::Reflection::SchemaReader::MatchType(TypeInfo& type_info) const {
+  const TypeHashCode* type_hash_code =
+      FindTypeHashCodeByNameHash(type_info.schema_type_.type_name_hash_);
+  if (type_hash_code == nullptr) {
+    return;
+  }
+  const Meta* meta = FindMeta(*type_hash_code);
+  if (meta == nullptr || !meta->HaveEmptyObject()) {
+    return;
+  }
+  SchemaTypeKind kind{};
+  if (!GetSchemaTypeKind(*meta, kind) || kind != type_info.schema_type_.kind_) {
+    return;
+  }
+  if (kind == SchemaTypeKind::TRIVIAL &&
+      meta->GetType().GetSize() != type_info.schema_type_.size_) {
+    return;
+  }
+
+  type_info.meta_ = meta;
+  type_info.plan_ = meta->GetSchemaSerializationPlan();
+}
+
+void MM::Reflection::SchemaReader::MatchProperties(const TypeInfo& type_info) {
+  if (type_info.meta_ == nullptr ||
+      type_info.schema_type_.kind_ != SchemaTypeKind::RECURSION) {
+    return;
+  }
+
+  for (std::uint16_t index = 0; index != type_info.schema_type_.property_number_;
+       ++index) {
+    PropertyInfo& property_info = properties_[type_info.first_property_ + index];
+    const SchemaProperty& schema_property = property_info.schema_property_;
+    for (const auto& local_property : type_info.plan_->GetSchemaProperties()) {
+      if (local_property.name_hash_ != schema_property.property_name_hash_) {
+        continue;
+      }
+      const Meta* property_meta = types_[schema_property.type_index_].meta_;
+      if (property_meta != nullptr && local_property.meta_ == property_meta &&
+          local_property.is_refrence_ == (schema_property.is_refrence_ != 0)) {
+        property_info.property_ = local_property.property_;
+      }
+      break;
+    }
+  }
+}
+
+bool MM::Reflection::SchemaReader::IsSameLayout(
+    std::uint32_t type_index, std::vector<std::uint8_t>& states) const {
+  switch (states[type_index]) {
+    case SAME_LAYOUT:
+    case CHECKING:
+      return true;
+    case DIFFERENT_LAYOUT:
+      return false;
+    default:
+      break;
+  }
+
+  const TypeInfo& type_info = types_[type_index];
+  if (type_info.meta_ == nullptr) {
+    states[type_index] = DIFFERENT_LAYOUT;
+    return false;
+  }
+  if (type_info.schema_type_.kind_ == SchemaTypeKind::TRIVIAL) {
+    states[type_index] = SAME_LAYOUT;
+    return true;
+  }
+
+  states[type_index] = CHECKING;
+  const auto& local_properties = type_info.plan_->GetSchemaProperties();
+  bool is_same_layout =
+      local_properties.size() == type_info.schema_type_.property_number_;
+  for (std::size_t index = 0; is_same_layout && index != local_properties.size();
+       ++index) {
+    const PropertyInfo& property_info =
+        properties_[type_info.first_property_ + index];
+    is_same_layout =
+        property_info.property_ == local_properties[index].property_ &&
+        IsSameLayout(property_info.schema_property_.type_index_, states);
+  }
+  states[type_index] = is_same_layout ? SAME_LAYOUT : DIFFERENT_LAYOUT;
+
+  return is_same_layout;
+}
+
+void MM::Reflection::SchemaReader::ReadBody(std::uint32_t type_index,
+                                            std::uint8_t* object) const {
+  const TypeInfo& type_info = types_[type_index];
+  if (object != nullptr && type_info.use_plan_ &&
+      type_info.plan_->Deserialize(data_buffer_, object)) {
+    return;
+  }
+
+  if (type_info.schema_type_.kind_ == SchemaTypeKind::TRIVIAL) {
+    if (type_info.schema_type_.size_ == 0) {
+      return;
+    }
+    if (object != nullptr) {
+      data_buffer_.ReadData(object, type_info.schema_type_.size_);
+    } else {
+      data_buffer_.ReadDataInPlace(type_info.schema_type_.size_);
+    }
+    return;
+  }
+
+  for (std::uint16_t index = 0; index != type_info.schema_type_.property_number_;
+       ++index) {
+    const PropertyInfo& property_info =
+        properties_[type_info.first_property_ + index];
+    const std::uint32_t property_type_index =
+        property_info.schema_property_.type_index_;
+    const TypeInfo& property_type_info = types_[property_type_index];
+    std::uint8_t* property_address =
+        object != nullptr && property_info.property_ != nullptr
+            ? object + property_info.property_->GetPropertyOffset()
+            : nullptr;
+    std::uint8_t* property_object = property_address;
+
+    if (property_address != nullptr) {
+      const Meta& property_meta = *property_type_info.meta_;
+      if (property_info.schema_property_.is_refrence_ != 0) {
+        property_object = static_cast<std::uint8_t*>(
+            SerializerBase::AllocateRefrenceObject(
+                property_meta.GetType().GetSize()));
+        memcpy(property_address, &property_object, sizeof(void*));
+      }
+      if (property_type_info.schema_type_.kind_ == SchemaTypeKind::RECURSION) {
+        memcpy(property_object, property_meta.GetEmptyVariable().GetValue(),
+               property_meta.GetType().GetSize());
+      }
+    }
+
+    ReadBody(property_type_index, property_object);
+  }
+}
+
+MM::Reflection::DataBuffer& MM::Reflection::SerializeWithSchema(
+    DataBuffer& data_buffer, Variable& variable) {
+  SchemaWriter schema_writer{};
+  if (!schema_writer.AddObject(variable)) {
+    return Serialize(data_buffer, variable);
+  }
+
+  return schema_writer.Finish(data_buffer);
+}
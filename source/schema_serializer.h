@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "serialization_plan.h"
+#include "serializer.h"
+
+namespace MM {
+namespace Reflection {
+/**
+ * \brief The version of the streams written by \ref SchemaWriter.
+ * \remark The streams written by \ref Serialize start with a
+ * \ref SerializerDescriptor whose version never has
+ * \ref STREAM_FORMAT_VERSION_FLAG set, so \ref Deserialize can tell the two
+ * formats apart by the first 4 bytes.
+ */
+constexpr std::uint32_t SCHEMA_SERIALIZER_VERSION = STREAM_FORMAT_VERSION_FLAG | 2;
+
+/**
+ * \brief Set in the record header when the object was written from a pointer or
+ * refrence.
+ */
+constexpr std::uint32_t SCHEMA_RECORD_REFRENCE_FLAG = 0x80000000u;
+
+struct SchemaHeader {
+  // Same place as SerializerDescriptor::version_.
+  std::uint32_t version_{SCHEMA_SERIALIZER_VERSION};
+  std::uint32_t type_number_{0};
+  std::uint32_t property_number_{0};
+  std::uint32_t object_number_{0};
+};
+
+static_assert(sizeof(SchemaHeader) == sizeof(SerializerDescriptor),
+              "The schema header must replace the descriptor.");
+
+enum class SchemaTypeKind : std::uint16_t { TRIVIAL, RECURSION };
+
+/**
+ * \brief One type in the schema table. It is followed by
+ * \ref property_number_ \ref SchemaProperty.
+ */
+struct SchemaType {
+  TypeHashCode type_name_hash_{0};
+  std::uint32_t size_{0};
+  SchemaTypeKind kind_{SchemaTypeKind::TRIVIAL};
+  std::uint16_t property_number_{0};
+};
+
+struct SchemaProperty {
+  TypeHashCode property_name_hash_{0};
+  std::uint32_t type_index_{0};
+  std::uint32_t is_refrence_{0};
+};
+
+/**
+ * \brief Write objects in the schema-once format.
+ * \remark The stream is a \ref SchemaHeader, a table with every type reachable
+ * from the written objects (each type with its properties, by name hash and
+ * type index), and then one record per object. A record is a 4 bytes type
+ * index followed by the data of the properties, ordered by offset, with no
+ * descriptor or type name. Pointer and refrence properties are followed by the
+ * data of the object they point to.
+ * \remark Only types that use the \ref TrivialSerializer or the
+ * \ref UnsefeRecursionSerializer (for all nested types) can be written.
+ */
+class SchemaWriter {
+ public:
+  SchemaWriter() = default;
+  ~SchemaWriter() = default;
+  SchemaWriter(const SchemaWriter& other) = delete;
+  SchemaWriter(SchemaWriter&& other) noexcept = default;
+  SchemaWriter& operator=(const SchemaWriter& other) = delete;
+  SchemaWriter& operator=(SchemaWriter&& other) noexcept = default;
+
+ public:
+  /**
+   * \brief Add the record of \ref variable.
+   * \return Returns false if the type of \ref variable cannot be written in
+   * this format.
+   */
+  bool AddObject(Variable& variable);
+
+  std::uint32_t GetObjectNumber() const;
+
+  /**
+   * \brief Write the header, the schema table and all records added so far to
+   * \ref data_buffer, and reset this writer.
+   */
+  DataBuffer& Finish(DataBuffer& data_buffer);
+
+ private:
+  std::uint32_t AddType(const Meta& meta);
+
+ private:
+  std::vector<const Meta*> types_{};
+  std::unordered_map<const Meta*, std::uint32_t> type_indexes_{};
+  std::uint32_t property_number_{0};
+  std::uint32_t object_number_{0};
+  // Segmented, so that adding records never copies the ones already added.
+  DataBuffer records_{DataBuffer::CreateSegmented()};
+};
+
+/**
+ * \brief Read the objects of a stream written by \ref SchemaWriter.
+ * \remark The schema table is matched against the registered metadata once.
+ * Properties are matched by name, so records written before properties were
+ * added, removed or moved can still be read: unknown properties are skipped and
+ * missing ones keep the value of the empty object. Types whose layout did not
+ * change are read with their \ref SerializationPlan.
+ */
+class SchemaReader {
+ public:
+  /**
+   * \brief Read the header and the schema table from \ref data_buffer.
+   */
+  explicit SchemaReader(const DataBuffer& data_buffer);
+  /**
+   * \brief Read the header and the schema table from \ref reader.
+   * \remark \ref reader must outlive this reader. Its read position moves
+   * with each object read.
+   */
+  explicit SchemaReader(DataBufferReader& reader);
+  ~SchemaReader() = default;
+  SchemaReader(const SchemaReader& other) = delete;
+  SchemaReader(SchemaReader&& other) = delete;
+  SchemaReader& operator=(const SchemaReader& other) = delete;
+  SchemaReader& operator=(SchemaReader&& other) = delete;
+
+ public:
+  bool IsValid() const;
+
+  std::uint32_t GetObjectNumber() const;
+
+  bool HaveObject() const;
+
+  /**
+   * \brief Read the next object.
+   * \return The object. It is invalid if there are no more objects or the type
+   * of the object is not registered.
+   */
+  Variable ReadObject();
+
+ private:
+  struct TypeInfo {
+    SchemaType schema_type_{};
+    // nullptr if the type is not registered or cannot be read.
+    const Meta* meta_{nullptr};
+    std::size_t first_property_{0};
+    // The plan of the registered type, set with meta_.
+    std::shared_ptr<const SerializationPlan> plan_{};
+    // Set if the layout of the type matches the registered metadata.
+    bool use_plan_{false};
+  };
+
+  struct PropertyInfo {
+    SchemaProperty schema_property_{};
+    // nullptr if the data of the property is skipped.
+    const Property* property_{nullptr};
+  };
+
+ private:
+  bool ReadSchema();
+
+  Variable ReadNextObject();
+
+  void MatchType(TypeInfo& type_info) const;
+
+  void MatchProperties(const TypeInfo& type_info);
+
+  bool IsSameLayout(std::uint32_t type_index,
+                    std::vector<std::uint8_t>& states) const;
+
+  void ReadBody(std::uint32_t type_index, std::uint8_t* object) const;
+
+ private:
+  // Reads the data of reader_, if this reader is created from one.
+  DataBuffer reader_data_buffer_{};
+  DataBufferReader* reader_{nullptr};
+  const DataBuffer& data_buffer_;
+  SchemaHeader header_{};
+  std::vector<TypeInfo> types_{};
+  std::vector<PropertyInfo> properties_{};
+  std::uint32_t read_object_number_{0};
+  bool is_valid_{false};
+};
+
+/**
+ * \brief Write \ref variable as a stream with a single object in the
+ * schema-once format.
+ * \remark If the type cannot be written in this format, it is written by
+ * \ref Serialize instead. \ref Deserialize reads both.
+ * \remark The schema table is written with every call. To write many objects,
+ * use one \ref SchemaWriter so that the table is written once.
+ */
+DataBuffer& SerializeWithSchema(DataBuffer& data_buffer, Variable& variable);
+}  // namespace Reflection
+}  // namespace MM
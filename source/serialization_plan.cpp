@@ -0,0 +1,505 @@
+#include "serialization_plan.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "meta.h"
+#include "serializer.h"
+
+namespace {
+std::atomic<std::uint64_t> g_serialization_plan_generation{1};
+
+// The metas whose plans are being compiled on this thread. A type that reaches
+// itself through pointers cannot be serialized, so its plan is invalid.
+thread_local std::vector<const MM::Reflection::Meta*> g_compiling_metas{};
+
+bool IsTrivialSerializer(const MM::Reflection::Meta& meta) {
+  return meta.GetSerializerName() ==
+         MM::Reflection::TrivialSerializer::GetSerializerNameStatic();
+}
+
+bool IsRecursionSerializer(const MM::Reflection::Meta& meta) {
+  return meta.GetSerializerName() ==
+         MM::Reflection::UnsefeRecursionSerializer::GetSerializerNameStatic();
+}
+
+std::vector<const MM::Reflection::Property*> GetPropertiesByOffset(
+    const MM::Reflection::Meta& meta) {
+  std::vector<const MM::Reflection::Property*> result{};
+  for (const MM::Reflection::Property* property : meta.GetAllProperty()) {
+    if (!property->IsStatic()) {
+      result.push_back(property);
+    }
+  }
+  std::sort(result.begin(), result.end(),
+            [](const MM::Reflection::Property* lhs,
+               const MM::Reflection::Property* rhs) {
+              return lhs->GetPropertyOffset() < rhs->GetPropertyOffset();
+            });
+
+  return result;
+}
+}  // namespace
+
+class MM::Reflection::SerializationPlan::Builder {
+ public:
+  Builder(SerializationPlan& plan, Layout layout)
+      : plan_(plan), layout_(layout) {}
+
+ public:
+  bool AppendBody(const Meta& meta, std::uint64_t object_offset) {
+    if (IsTrivialSerializer(meta)) {
+      // The stream holds the bytes of the object.
+      if (depth_ == 0) {
+        for (const Property* property : meta.GetAllProperty()) {
+          if (!property->IsStatic()) {
+            plan_.property_locations_.push_back(PropertyLocation{
+                property, property->GetMeta(),
+                plan_.serialized_size_ + property->GetPropertyOffset(),
+                property->GetPropertySize()});
+          }
+        }
+      }
+      AddCopy(object_offset, meta.GetType().GetSize());
+      return true;
+    }
+    if (!IsRecursionSerializer(meta)) {
+      return false;
+    }
+
+    const std::vector<const Property*> properties =
+        layout_ == Layout::SCHEMA ? GetPropertiesByOffset(meta)
+                                  : meta.GetAllProperty();
+    for (const Property* property : properties) {
+      if (property->IsStatic()) {
+        continue;
+      }
+      const Meta* property_meta = property->GetMeta();
+      if (property_meta == nullptr || !property_meta->HaveSerializer()) {
+        return false;
+      }
+      const SerializerBase* property_serializer =
+          FindSerializer(property_meta->GetSerializerName());
+      if (property_serializer == nullptr) {
+        return false;
+      }
+
+      const std::uint64_t property_offset =
+          object_offset + property->GetPropertyOffset();
+      const bool is_refrence =
+          property->GetType()->IsReference() || property->GetType()->IsPointer();
+      if (!is_refrence && IsRecursionSerializer(*property_meta)) {
+        if (!property_meta->HaveEmptyObject()) {
+          return false;
+        }
+        AddFillEmpty(property_offset,
+                     property_meta->GetEmptyVariable().GetValue(),
+                     property_meta->GetType().GetSize());
+      }
+      if (layout_ == Layout::DESCRIPTOR) {
+        AddDescriptor(property_serializer->GetVersion(), is_refrence,
+                      Utils::HashString(property_meta->GetTypeName()));
+      }
+      const std::uint64_t data_offset = plan_.serialized_size_;
+      if (is_refrence) {
+        std::shared_ptr<const SerializationPlan> sub_plan =
+            layout_ == Layout::SCHEMA
+                ? property_meta->GetSchemaSerializationPlan()
+                : property_meta->GetSerializationPlan();
+        if (!sub_plan->IsValid()) {
+          return false;
+        }
+        AddFollowPointer(property_offset, std::move(sub_plan));
+      } else {
+        ++depth_;
+        const bool is_appended = AppendBody(*property_meta, property_offset);
+        --depth_;
+        if (!is_appended) {
+          return false;
+        }
+      }
+
+      if (depth_ == 0) {
+        plan_.property_locations_.push_back(
+            PropertyLocation{property, property_meta, data_offset,
+                             plan_.serialized_size_ - data_offset});
+      }
+    }
+
+    return true;
+  }
+
+ private:
+  void AddDescriptor(std::uint32_t version, bool is_refrence,
+                     TypeHashCode type_name_hash) {
+    // Zero the padding, so the written bytes do not depend on the stack.
+    SerializerDescriptor descriptor{};
+    std::memset(static_cast<void*>(&descriptor), 0, sizeof(SerializerDescriptor));
+    descriptor.version_ = version;
+    descriptor.is_refrence_ = is_refrence;
+
+    plan_.descriptor_checks_.push_back(DescriptorCheck{
+        plan_.serialized_size_, version, is_refrence, type_name_hash});
+    AddLiteral(&descriptor, sizeof(SerializerDescriptor));
+    AddLiteral(&type_name_hash, sizeof(TypeHashCode));
+  }
+
+  void AddLiteral(const void* data, std::uint64_t size) {
+    const std::uint64_t literal_offset = AppendLiteralData(data, size);
+    if (!plan_.operations_.empty()) {
+      Operation& last = plan_.operations_.back();
+      if (last.type_ == OperationType::LITERAL &&
+          last.literal_offset_ + last.size_ == literal_offset) {
+        last.size_ += size;
+        plan_.serialized_size_ += size;
+        return;
+      }
+    }
+
+    Operation operation{};
+    operation.type_ = OperationType::LITERAL;
+    operation.stream_offset_ = plan_.serialized_size_;
+    operation.literal_offset_ = literal_offset;
+    operation.size_ = size;
+    plan_.operations_.push_back(operation);
+    plan_.serialized_size_ += size;
+  }
+
+  void AddCopy(std::uint64_t object_offset, std::uint64_t size) {
+    plan_.columns_.push_back(Column{object_offset, size});
+    if (!plan_.operations_.empty()) {
+      Operation& last = plan_.operations_.back();
+      if (last.type_ == OperationType::COPY &&
+          last.object_offset_ + last.size_ == object_offset) {
+        last.size_ += size;
+        plan_.serialized_size_ += size;
+        return;
+      }
+    }
+
+    Operation operation{};
+    operation.type_ = OperationType::COPY;
+    operation.object_offset_ = object_offset;
+    operation.stream_offset_ = plan_.serialized_size_;
+    operation.size_ = size;
+    plan_.operations_.push_back(operation);
+    plan_.serialized_size_ += size;
+  }
+
+  void AddFillEmpty(std::uint64_t object_offset, const void* empty_object,
+                    std::uint64_t size) {
+    Operation operation{};
+    operation.type_ = OperationType::FILL_EMPTY;
+    operation.object_offset_ = object_offset;
+    operation.stream_offset_ = plan_.serialized_size_;
+    operation.literal_offset_ = plan_.empty_objects_.size();
+    const auto* bytes = static_cast<const std::uint8_t*>(empty_object);
+    plan_.empty_objects_.insert(plan_.empty_objects_.end(), bytes, bytes + size);
+    operation.size_ = size;
+    plan_.fill_operations_.push_back(operation);
+  }
+
+  void AddFollowPointer(std::uint64_t object_offset,
+                        std::shared_ptr<const SerializationPlan>&& sub_plan) {
+    Operation operation{};
+    operation.type_ = OperationType::FOLLOW_POINTER;
+    operation.object_offset_ = object_offset;
+    operation.stream_offset_ = plan_.serialized_size_;
+    operation.size_ = sub_plan->serialized_size_;
+    operation.sub_plan_index_ = plan_.sub_plans_.size();
+    plan_.serialized_size_ += sub_plan->serialized_size_;
+    plan_.sub_plans_.emplace_back(std::move(sub_plan));
+    plan_.operations_.push_back(operation);
+  }
+
+  std::uint64_t AppendLiteralData(const void* data, std::uint64_t size) {
+    const std::uint64_t literal_offset = plan_.literals_.size();
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    plan_.literals_.insert(plan_.literals_.end(), bytes, bytes + size);
+    return literal_offset;
+  }
+
+ private:
+  SerializationPlan& plan_;
+  Layout layout_;
+  // The number of nested value types being appended.
+  std::size_t depth_{0};
+};
+
+std::shared_ptr<const MM::Reflection::SerializationPlan>
+MM::Reflection::SerializationPlan::Compile(const Meta& meta, Layout layout) {
+  auto plan = std::make_shared<SerializationPlan>();
+  plan->layout_ = layout;
+  plan->generation_ = GetCurrentGeneration();
+  plan->object_size_ = meta.GetType().GetSize();
+  plan->type_name_hash_ = Utils::HashString(meta.GetTypeName());
+  if (layout == Layout::SCHEMA && IsRecursionSerializer(meta)) {
+    for (const Property* property : GetPropertiesByOffset(meta)) {
+      plan->schema_properties_.push_back(SchemaPropertyInfo{
+          property, property->GetMeta(),
+          Utils::HashString(property->GetPropertyName()),
+          property->GetType()->IsReference() ||
+              property->GetType()->IsPointer()});
+    }
+  }
+
+  if (std::find(g_compiling_metas.begin(), g_compiling_metas.end(), &meta) !=
+      g_compiling_metas.end()) {
+    return plan;
+  }
+  if (!meta.HaveSerializer() ||
+      (IsRecursionSerializer(meta) && !meta.HaveEmptyObject())) {
+    return plan;
+  }
+
+  g_compiling_metas.push_back(&meta);
+  Builder builder{*plan, layout};
+  plan->is_valid_ = builder.AppendBody(meta, 0);
+  g_compiling_metas.pop_back();
+  if (!plan->is_valid_) {
+    plan->property_locations_.clear();
+  }
+  if (!plan->is_valid_ || !plan->sub_plans_.empty()) {
+    plan->columns_.clear();
+  }
+
+  if (plan->is_valid_ && IsRecursionSerializer(meta)) {
+    const auto* empty_object =
+        static_cast<const std::uint8_t*>(meta.GetEmptyVariable().GetValue());
+    plan->empty_object_.assign(empty_object, empty_object + plan->object_size_);
+  }
+  if (plan->is_valid_ && meta.HaveEmptyObject()) {
+    const void* empty_object = meta.GetEmptyVariable().GetValue();
+    if (!plan->HaveNullPointer(empty_object)) {
+      plan->empty_stream_.resize(plan->serialized_size_);
+      plan->SerializeBody(plan->empty_stream_.data(),
+                          static_cast<const std::uint8_t*>(empty_object));
+    }
+  }
+
+  return plan;
+}
+
+void MM::Reflection::SerializationPlan::InvalidateAll() {
+  g_serialization_plan_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::uint64_t MM::Reflection::SerializationPlan::GetCurrentGeneration() {
+  return g_serialization_plan_generation.load(std::memory_order_acquire);
+}
+
+bool MM::Reflection::SerializationPlan::IsValid() const { return is_valid_; }
+
+MM::Reflection::SerializationPlan::Layout
+MM::Reflection::SerializationPlan::GetLayout() const {
+  return layout_;
+}
+
+std::uint64_t MM::Reflection::SerializationPlan::GetGeneration() const {
+  return generation_;
+}
+
+std::uint64_t MM::Reflection::SerializationPlan::GetSerializedSize() const {
+  return serialized_size_;
+}
+
+MM::Reflection::TypeHashCode
+MM::Reflection::SerializationPlan::GetTypeNameHash() const {
+  return type_name_hash_;
+}
+
+const std::vector<MM::Reflection::SerializationPlan::SchemaPropertyInfo>&
+MM::Reflection::SerializationPlan::GetSchemaProperties() const {
+  return schema_properties_;
+}
+
+const std::vector<MM::Reflection::SerializationPlan::PropertyLocation>&
+MM::Reflection::SerializationPlan::GetPropertyLocations() const {
+  return property_locations_;
+}
+
+const MM::Reflection::SerializationPlan::PropertyLocation*
+MM::Reflection::SerializationPlan::FindPropertyLocation(
+    const std::string& property_name) const {
+  for (const PropertyLocation& property_location : property_locations_) {
+    if (property_location.property_->GetPropertyName() == property_name) {
+      return &property_location;
+    }
+  }
+
+  return nullptr;
+}
+
+const MM::Reflection::SerializationPlan::PropertyLocation*
+MM::Reflection::SerializationPlan::FindPropertyLocation(
+    const Property& property) const {
+  for (const PropertyLocation& property_location : property_locations_) {
+    if (property_location.property_ == &property) {
+      return &property_location;
+    }
+  }
+
+  return nullptr;
+}
+
+const std::vector<MM::Reflection::SerializationPlan::Column>&
+MM::Reflection::SerializationPlan::GetColumns() const {
+  return columns_;
+}
+
+const std::vector<std::uint8_t>&
+MM::Reflection::SerializationPlan::GetEmptyStream() const {
+  return empty_stream_;
+}
+
+bool MM::Reflection::SerializationPlan::HaveNullPointer(
+    const void* object) const {
+  const auto* bytes = static_cast<const std::uint8_t*>(object);
+  for (const Operation& operation : operations_) {
+    if (operation.type_ != OperationType::FOLLOW_POINTER) {
+      continue;
+    }
+    const std::uint8_t* pointee = nullptr;
+    std::memcpy(&pointee, bytes + operation.object_offset_, sizeof(void*));
+    if (pointee == nullptr ||
+        sub_plans_[operation.sub_plan_index_]->HaveNullPointer(pointee)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::size_t MM::Reflection::SerializationPlan::GetOperationNumber() const {
+  return operations_.size();
+}
+
+void MM::Reflection::SerializationPlan::Serialize(DataBuffer& data_buffer,
+                                                  const void* object) const {
+  assert(IsValid() && object != nullptr);
+  if (serialized_size_ == 0) {
+    return;
+  }
+
+  auto* stream = static_cast<std::uint8_t*>(data_buffer.AddEmptyData(serialized_size_));
+  SerializeBody(stream, static_cast<const std::uint8_t*>(object));
+}
+
+bool MM::Reflection::SerializationPlan::Deserialize(
+    const DataBuffer& data_buffer, void* object) const {
+  assert(IsValid() && object != nullptr);
+  if (serialized_size_ == 0) {
+    return true;
+  }
+
+  // Objects split between the segments of a segmented buffer are read by the
+  // caller.
+  const auto* stream = static_cast<const std::uint8_t*>(
+      data_buffer.PeekDataInPlace(serialized_size_));
+  if (stream == nullptr || !Validate(stream)) {
+    return false;
+  }
+
+  DeserializeBody(stream, static_cast<std::uint8_t*>(object));
+  data_buffer.ReadDataInPlace(serialized_size_);
+
+  return true;
+}
+
+bool MM::Reflection::SerializationPlan::Validate(const void* data) const {
+  const auto* stream = static_cast<const std::uint8_t*>(data);
+  for (const DescriptorCheck& check : descriptor_checks_) {
+    SerializerDescriptor descriptor{};
+    TypeHashCode type_name_hash{0};
+    std::memcpy(&descriptor, stream + check.stream_offset_,
+                sizeof(SerializerDescriptor));
+    std::memcpy(&type_name_hash,
+                stream + check.stream_offset_ + sizeof(SerializerDescriptor),
+                sizeof(TypeHashCode));
+    if (descriptor.version_ != check.version_ ||
+        descriptor.c_style_type_name_size_ != 0 ||
+        descriptor.custom_data_size_ != 0 ||
+        descriptor.is_refrence_ != check.is_refrence_ ||
+        type_name_hash != check.type_name_hash_) {
+      return false;
+    }
+  }
+
+  for (const Operation& operation : operations_) {
+    if (operation.type_ == OperationType::FOLLOW_POINTER &&
+        !sub_plans_[operation.sub_plan_index_]->Validate(
+            stream + operation.stream_offset_)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::uint8_t* MM::Reflection::SerializationPlan::SerializeBody(
+    std::uint8_t* stream, const std::uint8_t* object) const {
+  for (const Operation& operation : operations_) {
+    switch (operation.type_) {
+      case OperationType::LITERAL:
+        std::memcpy(stream, literals_.data() + operation.literal_offset_,
+                    operation.size_);
+        stream += operation.size_;
+        break;
+      case OperationType::COPY:
+        std::memcpy(stream, object + operation.object_offset_, operation.size_);
+        stream += operation.size_;
+        break;
+      case OperationType::FILL_EMPTY:
+        break;
+      case OperationType::FOLLOW_POINTER: {
+        const std::uint8_t* pointee = nullptr;
+        std::memcpy(&pointee, object + operation.object_offset_, sizeof(void*));
+        assert(pointee != nullptr);
+        stream = sub_plans_[operation.sub_plan_index_]->SerializeBody(stream,
+                                                                      pointee);
+        break;
+      }
+    }
+  }
+
+  return stream;
+}
+
+const std::uint8_t* MM::Reflection::SerializationPlan::DeserializeBody(
+    const std::uint8_t* stream, std::uint8_t* object) const {
+  // Nested objects are reset before any of their bytes are read.
+  for (const Operation& operation : fill_operations_) {
+    std::memcpy(object + operation.object_offset_,
+                empty_objects_.data() + operation.literal_offset_,
+                operation.size_);
+  }
+
+  for (const Operation& operation : operations_) {
+    switch (operation.type_) {
+      case OperationType::LITERAL:
+        stream += operation.size_;
+        break;
+      case OperationType::COPY:
+        std::memcpy(object + operation.object_offset_, stream, operation.size_);
+        stream += operation.size_;
+        break;
+      case OperationType::FILL_EMPTY:
+        break;
+      case OperationType::FOLLOW_POINTER: {
+        const SerializationPlan& sub_plan = *sub_plans_[operation.sub_plan_index_];
+        auto* pointee = static_cast<std::uint8_t*>(
+            SerializerBase::AllocateRefrenceObject(sub_plan.object_size_));
+        std::memcpy(object + operation.object_offset_, &pointee, sizeof(void*));
+        if (!sub_plan.empty_object_.empty()) {
+          std::memcpy(pointee, sub_plan.empty_object_.data(),
+                      sub_plan.empty_object_.size());
+        }
+        stream = sub_plan.DeserializeBody(stream, pointee);
+        break;
+      }
+    }
+  }
+
+  return stream;
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "data_buffer.h"
+#include "database.h"
+
+namespace MM {
+namespace Reflection {
+class Meta;
+class Property;
+
+/**
+ * \brief A flat list of operations that serializes the properties of one type.
+ * \remark A plan is compiled once per \ref Meta (see
+ * \ref Meta::GetSerializationPlan) by walking the properties of the type and of
+ * all nested types. Nested values are inlined, adjacent bytes are merged, and
+ * pointer or refrence properties run the plan of the pointed-to type. The
+ * plan writes exactly the bytes the \ref TrivialSerializer and
+ * \ref UnsefeRecursionSerializer write for the properties (everything after
+ * the descriptor of the object), so data written either way can be read
+ * either way.
+ * \remark With \ref Layout::SCHEMA the plan writes only the data of the
+ * properties, ordered by offset, for the records of \ref SchemaWriter. Without
+ * the descriptors in between, the bytes of neighbouring properties are copied
+ * at once.
+ * \remark Types whose properties use other serializers get an invalid plan,
+ * and the serializers fall back to visiting each property.
+ */
+class SerializationPlan {
+ public:
+  struct SchemaPropertyInfo {
+    const Property* property_{nullptr};
+    const Meta* meta_{nullptr};
+    TypeHashCode name_hash_{0};
+    bool is_refrence_{false};
+  };
+
+  /**
+   * \brief Where the data of a property of the type is in the stream written
+   * by \ref Serialize.
+   * \remark For a pointer or refrence property, the data is the data of the
+   * object it points to.
+   */
+  struct PropertyLocation {
+    const Property* property_{nullptr};
+    // The meta of the property type. nullptr if it is not registered.
+    const Meta* meta_{nullptr};
+    std::uint64_t stream_offset_{0};
+    std::uint64_t size_{0};
+  };
+
+  /**
+   * \brief A value that the plan copies from the object.
+   */
+  struct Column {
+    std::uint64_t object_offset_{0};
+    std::uint64_t size_{0};
+  };
+
+  enum class Layout : std::uint8_t {
+    // A descriptor and a type name hash before each property.
+    DESCRIPTOR,
+    // Only the data of the properties, see \ref SchemaWriter.
+    SCHEMA
+  };
+
+ public:
+  SerializationPlan() = default;
+  ~SerializationPlan() = default;
+  SerializationPlan(const SerializationPlan& other) = delete;
+  SerializationPlan(SerializationPlan&& other) noexcept = default;
+  SerializationPlan& operator=(const SerializationPlan& other) = delete;
+  SerializationPlan& operator=(SerializationPlan&& other) noexcept = default;
+
+ public:
+  /**
+   * \brief Compile the plan of \ref meta.
+   * \return The plan. It is never nullptr, but may be invalid.
+   * \remark Use \ref Meta::GetSerializationPlan, which caches the result.
+   */
+  static std::shared_ptr<const SerializationPlan> Compile(
+      const Meta& meta, Layout layout = Layout::DESCRIPTOR);
+
+  /**
+   * \brief Make all compiled plans out of date.
+   * \remark It is called whenever a \ref Meta changes its properties, methods
+   * or serializer.
+   */
+  static void InvalidateAll();
+
+  /**
+   * \brief Get the current generation of plans.
+   */
+  static std::uint64_t GetCurrentGeneration();
+
+  bool IsValid() const;
+
+  Layout GetLayout() const;
+
+  /**
+   * \brief Get the generation in which this plan was compiled.
+   */
+  std::uint64_t GetGeneration() const;
+
+  /**
+   * \brief Get the number of bytes written by \ref Serialize.
+   */
+  std::uint64_t GetSerializedSize() const;
+
+  /**
+   * \brief Get the hash of the registered name of the type.
+   */
+  TypeHashCode GetTypeNameHash() const;
+
+  /**
+   * \brief Get the non-static properties in the order that \ref Layout::SCHEMA
+   * writes them.
+   * \remark It is empty unless the layout is \ref Layout::SCHEMA and the type
+   * uses the \ref UnsefeRecursionSerializer. It is set even if the plan is
+   * invalid.
+   */
+  const std::vector<SchemaPropertyInfo>& GetSchemaProperties() const;
+
+  /**
+   * \brief Get the location of each non-static property of the type.
+   * \remark It is empty if the plan is invalid.
+   */
+  const std::vector<PropertyLocation>& GetPropertyLocations() const;
+
+  /**
+   * \return Returns nullptr if the type has no such non-static property or the
+   * plan is invalid.
+   */
+  const PropertyLocation* FindPropertyLocation(
+      const std::string& property_name) const;
+
+  const PropertyLocation* FindPropertyLocation(const Property& property) const;
+
+  /**
+   * \brief Check that \ref stream holds data written by this plan, with the
+   * expected descriptors and type name hashes.
+   * \param stream At least \ref GetSerializedSize bytes.
+   */
+  bool Validate(const void* stream) const;
+
+  /**
+   * \brief Check if \ref object or an object it points to has a nullptr
+   * pointer that the plan follows.
+   */
+  bool HaveNullPointer(const void* object) const;
+
+  /**
+   * \brief Get each value of a trivially serialized type that the plan copies,
+   * in the order they are written, before adjacent values are merged.
+   * \remark It is empty if the plan is invalid or follows pointers or
+   * refrences, because the data of the object is then not all in the object.
+   */
+  const std::vector<Column>& GetColumns() const;
+
+  /**
+   * \brief Get the bytes that \ref Serialize writes for the empty object of
+   * the type.
+   * \remark It is empty if the plan is invalid, the type has no empty object or
+   * a pointer in the empty object is nullptr.
+   */
+  const std::vector<std::uint8_t>& GetEmptyStream() const;
+
+  /**
+   * \brief Get the number of operations after merging.
+   */
+  std::size_t GetOperationNumber() const;
+
+  /**
+   * \brief Write the properties of \ref object to \ref data_buffer.
+   * \param object The address of an object of the type of the plan.
+   */
+  void Serialize(DataBuffer& data_buffer, const void* object) const;
+
+  /**
+   * \brief Read the properties of \ref object from \ref data_buffer.
+   * \param object The address of an object of the type of the plan. It must
+   * already hold the empty object of the type.
+   * \return Returns true if the data is read. Returns false without reading
+   * anything if the data does not match this plan (for example, it was written
+   * with type names or custom data).
+   */
+  bool Deserialize(const DataBuffer& data_buffer, void* object) const;
+
+ private:
+  enum class OperationType : std::uint8_t {
+    // Write bytes stored in the plan (descriptors and type name hashes).
+    // literal_offset_ is the offset in literals_.
+    LITERAL,
+    // Copy bytes between the object and the stream.
+    COPY,
+    // Deserialize only. Copy the empty object of a nested type to the object.
+    // literal_offset_ is the offset in empty_objects_. They are kept in
+    // fill_operations_ and run before all other operations.
+    FILL_EMPTY,
+    // Run a sub plan on the object pointed to by a pointer or refrence.
+    FOLLOW_POINTER
+  };
+
+  struct Operation {
+    OperationType type_{OperationType::LITERAL};
+    std::uint64_t object_offset_{0};
+    std::uint64_t stream_offset_{0};
+    std::uint64_t literal_offset_{0};
+    std::uint64_t size_{0};
+    std::size_t sub_plan_index_{0};
+  };
+
+  struct DescriptorCheck {
+    std::uint64_t stream_offset_{0};
+    std::uint32_t version_{0};
+    bool is_refrence_{false};
+    TypeHashCode type_name_hash_{0};
+  };
+
+  class Builder;
+
+ private:
+  std::uint8_t* SerializeBody(std::uint8_t* stream,
+                              const std::uint8_t* object) const;
+
+  const std::uint8_t* DeserializeBody(const std::uint8_t* stream,
+                                      std::uint8_t* object) const;
+
+ private:
+  std::vector<Operation> operations_{};
+  std::vector<Operation> fill_operations_{};
+  std::vector<DescriptorCheck> descriptor_checks_{};
+  std::vector<std::uint8_t> literals_{};
+  // The empty objects of nested types, used by FILL_EMPTY.
+  std::vector<std::uint8_t> empty_objects_{};
+  std::vector<std::shared_ptr<const SerializationPlan>> sub_plans_{};
+  std::vector<SchemaPropertyInfo> schema_properties_{};
+  std::vector<PropertyLocation> property_locations_{};
+  std::vector<Column> columns_{};
+  // The empty object, copied to a newly allocated object before a pointer or
+  // refrence to it is deserialized.
+  std::vector<std::uint8_t> empty_object_{};
+  std::vector<std::uint8_t> empty_stream_{};
+  std::uint64_t object_size_{0};
+  TypeHashCode type_name_hash_{0};
+  std::uint64_t serialized_size_{0};
+  std::uint64_t generation_{0};
+  Layout layout_{Layout::DESCRIPTOR};
+  bool is_valid_{false};
+};
+}  // namespace Reflection
+}  // namespace MM
@@ -0,0 +1,172 @@
+#include "serialized_view.h"
+
+#include "database.h"
+#include "meta.h"
+#include "serializer.h"
+
+namespace {
+// The type of the last viewed record. Scans mostly view records of one type,
+// so they skip the lookups of the type, the serializer and the plan.
+struct ViewedType {
+  MM::Reflection::TypeHashCode type_name_hash_{0};
+  std::uint32_t version_{0};
+  const MM::Reflection::Meta* meta_{nullptr};
+  std::shared_ptr<const MM::Reflection::SerializationPlan> plan_{};
+};
+
+thread_local ViewedType g_last_viewed_type{};
+
+bool FindViewedType(MM::Reflection::TypeHashCode type_name_hash,
+                    std::uint32_t version, ViewedType& viewed_type) {
+  if (g_last_viewed_type.plan_ != nullptr &&
+      g_last_viewed_type.type_name_hash_ == type_name_hash &&
+      g_last_viewed_type.version_ == version &&
+      g_last_viewed_type.plan_->GetGeneration() ==
+          MM::Reflection::SerializationPlan::GetCurrentGeneration()) {
+    viewed_type = g_last_viewed_type;
+    return true;
+  }
+
+  const MM::Reflection::TypeHashCode* type_hash_code =
+      MM::Reflection::FindTypeHashCodeByNameHash(type_name_hash);
+  if (type_hash_code == nullptr) {
+    return false;
+  }
+  const MM::Reflection::Meta* meta = MM::Reflection::FindMeta(*type_hash_code);
+  if (meta == nullptr || !meta->HaveSerializer()) {
+    return false;
+  }
+  const MM::Reflection::SerializerBase* serializer =
+      MM::Reflection::FindSerializer(meta->GetSerializerName());
+  if (serializer == nullptr || serializer->GetVersion() != version) {
+    return false;
+  }
+  std::shared_ptr<const MM::Reflection::SerializationPlan> plan =
+      meta->GetSerializationPlan();
+  if (!plan->IsValid()) {
+    return false;
+  }
+
+  viewed_type = ViewedType{type_name_hash, version, meta, std::move(plan)};
+  g_last_viewed_type = viewed_type;
+  return true;
+}
+}  // namespace
+
+MM::Reflection::SerializedView::SerializedView(const DataBuffer& data_buffer) {
+  constexpr std::uint64_t header_size =
+      sizeof(SerializerDescriptor) + sizeof(TypeHashCode);
+  const auto* header =
+      static_cast<const std::uint8_t*>(data_buffer.PeekDataInPlace(header_size));
+  if (header == nullptr) {
+    return;
+  }
+  SerializerDescriptor descriptor{};
+  TypeHashCode type_name_hash{0};
+  std::memcpy(&descriptor, header, sizeof(SerializerDescriptor));
+  std::memcpy(&type_name_hash, header + sizeof(SerializerDescriptor),
+              sizeof(TypeHashCode));
+  // Records with type names or custom data are not written by the plans.
+  if (descriptor.c_style_type_name_size_ != 0 ||
+      descriptor.custom_data_size_ != 0) {
+    return;
+  }
+
+  ViewedType viewed_type{};
+  if (!FindViewedType(type_name_hash, descriptor.version_, viewed_type)) {
+    return;
+  }
+  const SerializationPlan& plan = *viewed_type.plan_;
+
+  const auto* record = static_cast<const std::uint8_t*>(
+      data_buffer.PeekDataInPlace(header_size + plan.GetSerializedSize()));
+  if (record == nullptr || !plan.Validate(record + header_size)) {
+    return;
+  }
+  data_buffer.ReadDataInPlace(header_size + plan.GetSerializedSize());
+
+  meta_ = viewed_type.meta_;
+  plan_ = std::move(viewed_type.plan_);
+  data_ = record + header_size;
+}
+
+MM::Reflection::SerializedView::SerializedView(DataBufferReader& reader)
+    : SerializedView(reader.ReadWithDataBuffer(
+          [](const DataBuffer& data_buffer) { return SerializedView{data_buffer}; })) {}
+
+bool MM::Reflection::SerializedView::IsValid() const { return data_ != nullptr; }
+
+const MM::Reflection::Meta* MM::Reflection::SerializedView::GetMeta() const {
+  return meta_;
+}
+
+const void* MM::Reflection::SerializedView::GetPropertyData(
+    const std::string& property_name) const {
+  const PropertyLocation* property_location =
+      FindPropertyLocation(property_name);
+
+  return property_location == nullptr
+             ? nullptr
+             : data_ + property_location->stream_offset_;
+}
+
+const void* MM::Reflection::SerializedView::GetPropertyData(
+    const Property& property) const {
+  const PropertyLocation* property_location = FindPropertyLocation(property);
+
+  return property_location == nullptr
+             ? nullptr
+             : data_ + property_location->stream_offset_;
+}
+
+MM::Reflection::SerializedView MM::Reflection::SerializedView::GetPropertyView(
+    const std::string& property_name) const {
+  return MakePropertyView(FindPropertyLocation(property_name));
+}
+
+MM::Reflection::SerializedView MM::Reflection::SerializedView::GetPropertyView(
+    const Property& property) const {
+  return MakePropertyView(FindPropertyLocation(property));
+}
+
+const MM::Reflection::SerializedView::PropertyLocation*
+MM::Reflection::SerializedView::FindPropertyLocation(
+    const std::string& property_name) const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  return plan_->FindPropertyLocation(property_name);
+}
+
+const MM::Reflection::SerializedView::PropertyLocation*
+MM::Reflection::SerializedView::FindPropertyLocation(
+    const Property& property) const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  return plan_->FindPropertyLocation(property);
+}
+
+MM::Reflection::SerializedView MM::Reflection::SerializedView::MakePropertyView(
+    const PropertyLocation* property_location) const {
+  SerializedView result{};
+  if (property_location == nullptr || property_location->meta_ == nullptr) {
+    return result;
+  }
+  // Nested types are written inline with the same bytes as their own plan, so
+  // the plan of the property type locates its properties.
+  std::shared_ptr<const SerializationPlan> plan =
+      property_location->meta_->GetSerializationPlan();
+  if (!plan->IsValid() ||
+      plan->GetSerializedSize() != property_location->size_) {
+    return result;
+  }
+
+  result.meta_ = property_location->meta_;
+  result.plan_ = std::move(plan);
+  result.data_ = data_ + property_location->stream_offset_;
+
+  return result;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "data_buffer.h"
+#include "property.h"
+#include "serialization_plan.h"
+#include "type_utils.h"
+
+namespace MM {
+namespace Reflection {
+class Meta;
+
+/**
+ * \brief Read the properties of a serialized object in place, without
+ * deserializing it.
+ * \remark The record is checked once when the view is created. Reading a
+ * property then only looks up its offset in the \ref SerializationPlan of the
+ * type, with no allocation and no \ref Variable.
+ * \remark Only records written by \ref Serialize for types that use the
+ * \ref TrivialSerializer or the \ref UnsefeRecursionSerializer (for all nested
+ * types) can be viewed.
+ * \remark The view points into the buffer, so it is valid until the data of
+ * the buffer is changed or released.
+ */
+class SerializedView {
+ public:
+  SerializedView() = default;
+  ~SerializedView() = default;
+  /**
+   * \brief View the record at the read position of \ref data_buffer and skip
+   * it.
+   * \remark The view is invalid if the record cannot be viewed, and then
+   * nothing is read.
+   */
+  explicit SerializedView(const DataBuffer& data_buffer);
+  /**
+   * \brief View the record at the read position of \ref reader and skip it.
+   * \remark The view points into the data of \ref reader.
+   */
+  explicit SerializedView(DataBufferReader& reader);
+  SerializedView(const SerializedView& other) = default;
+  SerializedView(SerializedView&& other) noexcept = default;
+  SerializedView& operator=(const SerializedView& other) = default;
+  SerializedView& operator=(SerializedView&& other) noexcept = default;
+
+ public:
+  bool IsValid() const;
+
+  const Meta* GetMeta() const;
+
+  /**
+   * \brief Get the address of the data of the property.
+   * \return Returns nullptr if the type has no such property.
+   * \remark For a trivial property it is the bytes of the value, which may not
+   * be aligned. Use \ref GetPropertyValue to copy it.
+   */
+  const void* GetPropertyData(const std::string& property_name) const;
+
+  const void* GetPropertyData(const Property& property) const;
+
+  /**
+   * \brief Copy the value of the property to \ref value.
+   * \return Returns false if the type has no such property or its type is not
+   * \ref PropertyType (or the type it points to).
+   */
+  template <typename PropertyType>
+  bool GetPropertyValue(const std::string& property_name,
+                        PropertyType& value) const {
+    return CopyPropertyValue(FindPropertyLocation(property_name), value);
+  }
+
+  template <typename PropertyType>
+  bool GetPropertyValue(const Property& property, PropertyType& value) const {
+    return CopyPropertyValue(FindPropertyLocation(property), value);
+  }
+
+  /**
+   * \brief Get a view of a property whose type is serialized by the
+   * \ref UnsefeRecursionSerializer or the \ref TrivialSerializer.
+   * \return The view. It is invalid if the type has no such property.
+   */
+  SerializedView GetPropertyView(const std::string& property_name) const;
+
+  SerializedView GetPropertyView(const Property& property) const;
+
+ private:
+  using PropertyLocation = SerializationPlan::PropertyLocation;
+
+ private:
+  const PropertyLocation* FindPropertyLocation(
+      const std::string& property_name) const;
+
+  const PropertyLocation* FindPropertyLocation(const Property& property) const;
+
+  SerializedView MakePropertyView(
+      const PropertyLocation* property_location) const;
+
+  template <typename PropertyType>
+  bool CopyPropertyValue(const PropertyLocation* property_location,
+                         PropertyType& value) const {
+    static_assert(std::is_trivially_copyable_v<PropertyType>,
+                  "The value is copied from the serialized bytes.");
+    if (property_location == nullptr ||
+        property_location->size_ != sizeof(PropertyType) ||
+        property_location->property_->GetType()->GetOriginalTypeHashCode() !=
+            Utils::TypeHashCodeV<PropertyType>) {
+      return false;
+    }
+
+    std::memcpy(&value, data_ + property_location->stream_offset_,
+                sizeof(PropertyType));
+    return true;
+  }
+
+ private:
+  const Meta* meta_{nullptr};
+  std::shared_ptr<const SerializationPlan> plan_{};
+  // The data of the properties, after the descriptor of the object.
+  const std::uint8_t* data_{nullptr};
+};
+}  // namespace Reflection
+}  // namespace MM
@@ -2,6 +2,15 @@
 
 #include <cstring>
 #include <iostream>
+#include <new>
+
+#include "batch_serializer.h"
+#include "delta_serializer.h"
+#include "graph_serializer.h"
+#include "parallel_serializer.h"
+#include "record_store.h"
+#include "schema_serializer.h"
+#include "serialization_plan.h"
 
 const std::string& MM::Reflection::SerializerBase::GetSerializerName() const {
   return SerializerBase::GetSerializerNameStatic();
@@ -17,23 +26,36 @@ const std::string& MM::Reflection::SerializerBase::GetSerializerNameStatic() {
 void MM::Reflection::SerializerBase::WriteDescriptor(
     DataBuffer& data_buffer, const Variable& variable, const void* custom_data,
     const std::uint32_t custome_data_size) const {
+  const SerializerDescriptor descriptor =
+      CreateDescriptor(variable, GetVersion(), custome_data_size);
+  const TypeHashCode type_name_hash =
+      Utils::HashString(variable.GetMeta()->GetTypeName());
+  data_buffer.AddData(&descriptor, sizeof(SerializerDescriptor));
+  data_buffer.AddData(&type_name_hash, sizeof(TypeHashCode));
+  if (custom_data != nullptr) {
+    assert(custome_data_size != 0);
+    data_buffer.AddData(custom_data, custome_data_size);
+  }
+}
+
+MM::Reflection::SerializerDescriptor
+MM::Reflection::SerializerBase::CreateDescriptor(
+    const Variable& variable, std::uint32_t version,
+    std::uint32_t custome_data_size) {
   bool is_refrence = variable.IsPropertyVariable()
                          ? (variable.GetPropertyRealType()->IsReference() ||
                             variable.GetPropertyRealType()->IsPointer())
                          : (variable.GetType()->IsReference() ||
                             variable.GetType()->IsPointer());
 
-  const SerializerDescriptor descriptor{
-      GetVersion(),
-      static_cast<std::uint32_t>(variable.GetMeta()->GetTypeName().size() + 1),
-      custome_data_size, is_refrence};
-  data_buffer.AddData(&descriptor, sizeof(SerializerDescriptor));
-  data_buffer.AddData(variable.GetType()->GetOriginalTypeName().c_str(),
-                      descriptor.c_style_type_name_size_);
-  if (custom_data != nullptr) {
-    assert(custome_data_size != 0);
-    data_buffer.AddData(custom_data, custome_data_size);
-  }
+  // Zero the padding, so the same value is always written as the same bytes.
+  SerializerDescriptor descriptor{};
+  memset(static_cast<void*>(&descriptor), 0, sizeof(SerializerDescriptor));
+  descriptor.version_ = version;
+  descriptor.custom_data_size_ = custome_data_size;
+  descriptor.is_refrence_ = is_refrence;
+
+  return descriptor;
 }
 
 void* MM::Reflection::SerializerBase::GetVariableValuePtr(Variable& variable) {
@@ -54,6 +76,14 @@ MM::Reflection::SerializerBase::ReadDescriptor(const DataBuffer& data_buffer) {
   return result;
 }
 
+MM::Reflection::SerializerDescriptor
+MM::Reflection::SerializerBase::ReadDescriptor(DataBufferReader& reader) {
+  SerializerDescriptor result{};
+  reader.ReadData(&result, sizeof(result));
+
+  return result;
+}
+
 std::string MM::Reflection::SerializerBase::ReadTypeName(
     const DataBuffer& data_buffer, std::uint64_t size) {
   std::string result{};
@@ -63,15 +93,50 @@ std::string MM::Reflection::SerializerBase::ReadTypeName(
   return result;
 }
 
+const MM::Reflection::Meta* MM::Reflection::SerializerBase::ReadMeta(
+    const DataBuffer& data_buffer,
+    const SerializerDescriptor& serializer_descriptor) {
+  const TypeHashCode* type_hash_code = nullptr;
+  if (serializer_descriptor.c_style_type_name_size_ == 0) {
+    TypeHashCode type_name_hash{0};
+    data_buffer.ReadData(&type_name_hash, sizeof(TypeHashCode));
+    type_hash_code = FindTypeHashCodeByNameHash(type_name_hash);
+  } else {
+    const std::string type_name = ReadTypeName(
+        data_buffer, serializer_descriptor.c_style_type_name_size_);
+    type_hash_code = FindTypeHashCode(type_name);
+  }
+  if (type_hash_code == nullptr) {
+    return nullptr;
+  }
+
+  return FindMeta(*type_hash_code);
+}
+
 void MM::Reflection::SerializerBase::ReadCustomData(
     const DataBuffer& data_buffer, void* data_to, std::uint64_t size) {
   data_buffer.ReadData(data_to, size);
 }
 
+void* MM::Reflection::SerializerBase::AllocateRefrenceObject(
+    std::uint64_t size) {
+  VariableArena* arena = VariableArena::GetCurrentArena();
+  return arena != nullptr ? arena->Allocate(size, alignof(std::max_align_t))
+                          : malloc(size);
+}
+
+void MM::Reflection::SerializerBase::FreeRefrenceObject(void* object) {
+  if (VariableArena::GetCurrentArena() == nullptr) {
+    free(object);
+  }
+}
+
 void MM::Reflection::SerializerBase::PreProcessDescriptor(
     const Meta& meta, Variable& invalid_variable_refrence,
     const DeserializerInfo& deserializer_info) {
-  assert(meta.HaveSerializer() && meta.HaveEmptyObject());
+  // Only the empty object is used, so DeserializeGraph also calls this for
+  // types without a serializer.
+  assert(meta.HaveEmptyObject());
   assert(!invalid_variable_refrence.IsValid());
 
   Variable& empty_variable = meta.GetEmptyVariable();
@@ -82,7 +147,7 @@ void MM::Reflection::SerializerBase::PreProcessDescriptor(
       empty_refrence_variable.GetWrapperBasePtr());
 
   if (deserializer_info.is_refrence_) {
-    void* refrence_ptr = malloc(meta.GetType().GetSize());
+    void* refrence_ptr = AllocateRefrenceObject(meta.GetType().GetSize());
 
     if (deserializer_info.placement_address_) {
       if (deserializer_info.need_vptr_) {
@@ -137,14 +202,28 @@ void MM::Reflection::SerializerBase::PreProcessDescriptor(
             Variable::VariableType::SMALL_OBJECT;
       }
     } else {
-      // use small object optimize
-      std::uint64_t type_size = meta.GetType().GetSize();
-      if (type_size <= sizeof(void*)) {
-        invalid_variable_refrence.wrapper_.small_wrapper_.ptr1 = empty_object_vptr;
+      // use small object optimize, by the same rule as Variable::IsSmallObject
+      const std::uint64_t wrapper_size =
+          empty_variable.GetWrapperBasePtr()->GetWrapperSize();
+      const std::uint64_t wrapper_alignment =
+          empty_variable.GetWrapperBasePtr()->GetWrapperAlignment();
+      if (wrapper_size <= sizeof(Variable::SmallObject) &&
+          wrapper_alignment <= alignof(Variable::SmallObject)) {
+        invalid_variable_refrence.wrapper_.small_wrapper_.SetPtr1(empty_object_vptr);
         invalid_variable_refrence.variable_type_ = Variable::VariableType::SMALL_OBJECT;
+      } else if (VariableArena* arena = VariableArena::GetCurrentArena()) {
+        VariableWrapperBase* wrapper_ptr = static_cast<VariableWrapperBase*>(
+            arena->Allocate(wrapper_size, wrapper_alignment));
+        *reinterpret_cast<void**>(wrapper_ptr) = empty_object_vptr;
+        invalid_variable_refrence.wrapper_.placement_wrapper_ = wrapper_ptr;
+        invalid_variable_refrence.variable_type_ = Variable::VariableType::PLACMENT_OBJECT;
       } else {
+        // The wrapper is deleted by Variable, which uses the aligned operator
+        // delete for an over-aligned type.
         VariableWrapperBase* wrapper_ptr = static_cast<VariableWrapperBase*>(
-            malloc(GetVariableWrpperSize(type_size)));
+            wrapper_alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+                ? ::operator new(wrapper_size, std::align_val_t{wrapper_alignment})
+                : malloc(wrapper_size));
         *reinterpret_cast<void**>(wrapper_ptr) = empty_object_vptr;
         invalid_variable_refrence.wrapper_.common_wrapper_ = wrapper_ptr;
         invalid_variable_refrence.variable_type_ = Variable::VariableType::COMMON_OBJECT;
@@ -259,7 +338,13 @@ MM::Reflection::DataBuffer& MM::Reflection::UnsefeRecursionSerializer::Serialize
 
   WriteDescriptor(data_buffer, variable, nullptr, 0);
 
-  auto& serializer_database = GetSerializerDatabase();
+  const std::shared_ptr<const SerializationPlan> plan =
+      variable.GetMeta()->GetSerializationPlan();
+  if (plan->IsValid()) {
+    plan->Serialize(data_buffer, GetVariableValuePtr(variable));
+    return data_buffer;
+  }
+
   for (const auto* property : variable.GetMeta()->GetAllProperty()) {
     if (property->IsStatic()) {
       continue;
@@ -267,10 +352,9 @@ MM::Reflection::DataBuffer& MM::Reflection::UnsefeRecursionSerializer::Serialize
     Variable property_variable =
         variable.GetPropertyVariable(property->GetPropertyName());
     assert(property_variable.GetMeta()->HaveSerializer());
-    auto serializer_iter = serializer_database.find(
-        property_variable.GetMeta()->GetSerializerName());
-    assert(serializer_iter != serializer_database.end());
-    const SerializerBase* serializer = serializer_iter->second;
+    const SerializerBase* serializer =
+        FindSerializer(property_variable.GetMeta()->GetSerializerName());
+    assert(serializer != nullptr);
     if (property_variable.GetPropertyRealType()->IsPointer()) {
       Variable new_refrence_variable = property_variable.PointerVariableToRefrenceVariable(true);
       assert(new_refrence_variable.IsValid());
@@ -293,6 +377,12 @@ MM::Reflection::Variable MM::Reflection::UnsefeRecursionSerializer::Deserialize(
 
   memcpy(variable.GetValue(), meta.GetEmptyVariable().GetValue(), meta.GetType().GetSize());
 
+  const std::shared_ptr<const SerializationPlan> plan =
+      meta.GetSerializationPlan();
+  if (plan->IsValid() && plan->Deserialize(data_buffer, variable.GetValue())) {
+    return variable;
+  }
+
   ReadAllPropertyData(data_buffer, meta, variable);
 
   return variable;
@@ -319,18 +409,12 @@ void MM::Reflection::UnsefeRecursionSerializer::ReadAllPropertyData(
 
     const SerializerDescriptor serializer_descriptor =
         ReadDescriptor(data_buffer);
-    const std::string type_name = ReadTypeName(
-        data_buffer, serializer_descriptor.c_style_type_name_size_);
-    auto type_hash_code_iter = GetNameToTypeHashDatabase().find(type_name);
-    assert(type_hash_code_iter != GetNameToTypeHashDatabase().end());
-    auto meta_iter = GetMetaDatabase().find(type_hash_code_iter->second);
-    assert(meta_iter != GetMetaDatabase().end());
-    const Meta* property_meta = meta_iter->second;
+    const Meta* property_meta = ReadMeta(data_buffer, serializer_descriptor);
+    assert(property_meta != nullptr);
     assert(property_meta->HaveSerializer());
-    auto serializer_iter =
-        GetSerializerDatabase().find(property_meta->GetSerializerName());
-    assert(serializer_iter != GetSerializerDatabase().end());
-    const SerializerBase* serializer = serializer_iter->second;
+    const SerializerBase* serializer =
+        FindSerializer(property_meta->GetSerializerName());
+    assert(serializer != nullptr);
 
     assert(serializer_descriptor.is_refrence_ ==
            (property->GetType()->IsReference() || property->GetType()->IsPointer()));
@@ -385,31 +469,64 @@ MM::Reflection::DataBuffer& MM::Reflection::Serialize(DataBuffer& data_buffer,
   assert(meta != nullptr);
   assert(meta->HaveSerializer());
 
-  const auto serializer_iter =
-      GetSerializerDatabase().find(meta->GetSerializerName());
-  assert(serializer_iter != GetSerializerDatabase().end());
-  const SerializerBase* serializer = serializer_iter->second;
+  const SerializerBase* serializer = FindSerializer(meta->GetSerializerName());
+  assert(serializer != nullptr);
   return serializer->Serialize(data_buffer, variable);
 }
 
 MM::Reflection::Variable MM::Reflection::Deserialize(
     const DataBuffer& data_buffer) {
+  std::uint32_t version{0};
+  if (data_buffer.CanReadData(sizeof(std::uint32_t))) {
+    data_buffer.PeekData(&version, sizeof(std::uint32_t));
+  }
+  if (version == BATCH_SERIALIZER_VERSION) {
+    std::cerr << "[Error] [MMReflection] The data is a batch of objects, use "
+                 "DeserializeBatch to read it.\n";
+    return Variable{};
+  }
+  if (version == RECORD_STORE_VERSION) {
+    std::cerr << "[Error] [MMReflection] The data is a record store, use "
+                 "RecordReader to read it.\n";
+    return Variable{};
+  }
+  if (version == PARALLEL_SERIALIZER_VERSION) {
+    std::cerr << "[Error] [MMReflection] The data is written in parallel, use "
+                 "DeserializeParallel to read it.\n";
+    return Variable{};
+  }
+  if (version == DELTA_SERIALIZER_VERSION) {
+    return DeserializeDelta(data_buffer);
+  }
+  if (version == GRAPH_SERIALIZER_VERSION) {
+    return DeserializeGraph(data_buffer);
+  }
+  if (version == SCHEMA_SERIALIZER_VERSION) {
+    SchemaReader schema_reader{data_buffer};
+    if (schema_reader.GetObjectNumber() != 1) {
+      std::cerr << "[Error] [MMReflection] The data holds "
+                << schema_reader.GetObjectNumber()
+                << " objects, use SchemaReader to read them.\n";
+      return Variable{};
+    }
+    return schema_reader.ReadObject();
+  }
+
   const SerializerDescriptor serializer_descriptor =
       SerializerBase::ReadDescriptor(data_buffer);
-  const std::string type_name = SerializerBase::ReadTypeName(
-      data_buffer, serializer_descriptor.c_style_type_name_size_);
-  auto type_hash_code_iter = GetNameToTypeHashDatabase().find(type_name);
-  assert(type_hash_code_iter != GetNameToTypeHashDatabase().end());
-  auto meta_iter = GetMetaDatabase().find(type_hash_code_iter->second);
-  assert(meta_iter != GetMetaDatabase().end());
-  const Meta* meta = meta_iter->second;
+  const Meta* meta =
+      SerializerBase::ReadMeta(data_buffer, serializer_descriptor);
+  assert(meta != nullptr);
   assert(meta->HaveSerializer());
-  auto serializer_iter =
-      GetSerializerDatabase().find(meta->GetSerializerName());
-  assert(serializer_iter != GetSerializerDatabase().end());
-  const SerializerBase* serializer = serializer_iter->second;
+  const SerializerBase* serializer = FindSerializer(meta->GetSerializerName());
+  assert(serializer != nullptr);
 
   DeserializerInfo deserializer_info{nullptr,
                                      serializer_descriptor.is_refrence_, false};
   return serializer->Deserialize(data_buffer, *meta, deserializer_info);
 }
+
+MM::Reflection::Variable MM::Reflection::Deserialize(DataBufferReader& reader) {
+  return reader.ReadWithDataBuffer(
+      [](const DataBuffer& data_buffer) { return Deserialize(data_buffer); });
+}
@@ -5,9 +5,19 @@
 
 namespace MM {
 namespace Reflection {
+/**
+ * \brief Set in the version of the streams that do not start with a
+ * \ref SerializerDescriptor, such as \ref SCHEMA_SERIALIZER_VERSION.
+ * \remark \ref SerializerBase::GetVersion must not return a value with this
+ * bit set, so \ref Deserialize never takes a descriptor for one of these
+ * streams. \ref RegisterSerializer refuses such serializers.
+ */
+constexpr std::uint32_t STREAM_FORMAT_VERSION_FLAG = 0x80000000u;
+
 struct alignas(4) SerializerDescriptor {
  std::uint32_t version_{0};
- // Add 1 to the actual type name size
+ // Add 1 to the actual type name size. If it is 0, the type is identified by
+ // the 8 bytes hash of its registered name instead of the name.
  std::uint32_t c_style_type_name_size_{0};
  std::uint32_t custom_data_size_{0};
  bool is_refrence_{false};
@@ -21,6 +31,15 @@ struct DeserializerInfo {
 
 class SerializerBase {
   friend Variable Deserialize(const DataBuffer& data_buffer);
+  friend class SerializationPlan;
+  friend class SchemaWriter;
+  friend class SchemaReader;
+  friend DataBuffer& SerializeDelta(DataBuffer& data_buffer, Variable& variable);
+  friend Variable DeserializeDelta(const DataBuffer& data_buffer);
+  friend DataBuffer& SerializeGraph(DataBuffer& data_buffer, Variable& variable);
+  friend Variable DeserializeGraph(const DataBuffer& data_buffer);
+  friend class RecordReader;
+  friend class ParallelShardCache;
 
 public:
   SerializerBase() = default;
@@ -50,15 +69,51 @@ protected:
                        const void* custom_data,
                        std::uint32_t custome_data_size) const ;
 
+  /**
+   * \brief Create the descriptor that \ref WriteDescriptor writes for
+   * \ref variable, with the padding zeroed.
+   */
+  static SerializerDescriptor CreateDescriptor(const Variable& variable,
+                                               std::uint32_t version,
+                                               std::uint32_t custome_data_size);
+
   static void* GetVariableValuePtr(Variable& variable);
 
   static SerializerDescriptor ReadDescriptor(const DataBuffer& data_buffer);
 
+  static SerializerDescriptor ReadDescriptor(DataBufferReader& reader);
+
   static std::string ReadTypeName(const DataBuffer& data_buffer, std::uint64_t size);
 
+  /**
+   * \brief Read the type identity that follows \ref serializer_descriptor and
+   * find its metadata.
+   * \return Returns the metadata, or nullptr if the type is not registered.
+   * \remark Both the type name hash and the type name (written by old
+   * versions) are accepted.
+   */
+  static const Meta* ReadMeta(const DataBuffer& data_buffer,
+                              const SerializerDescriptor& serializer_descriptor);
+
   static void ReadCustomData(const DataBuffer& data_buffer, void* data_to,
                              std::uint64_t size);
 
+  /**
+   * \brief Allocate the memory of an object that a deserialized pointer or
+   * refrence points to.
+   * \remark The memory comes from the current \ref VariableArena if there is
+   * one, or from malloc otherwise.
+   */
+  static void* AllocateRefrenceObject(std::uint64_t size);
+
+  /**
+   * \brief Free an object allocated by \ref AllocateRefrenceObject that is
+   * not returned to the caller.
+   * \remark Nothing is done if there is a current \ref VariableArena, which
+   * releases the object when it is reset.
+   */
+  static void FreeRefrenceObject(void* object);
+
   static void PreProcessDescriptor(const Meta& meta,
                                    Variable& invalid_variable_refrence,
                                    const DeserializerInfo& deserializer_info);
@@ -117,6 +172,17 @@ public:
 
 DataBuffer& Serialize(DataBuffer& data_buffer, Variable& variable);
 
+/**
+ * \brief Read an object written by \ref Serialize or by
+ * \ref SerializeWithSchema.
+ */
 Variable Deserialize(const DataBuffer& data_buffer);
+
+/**
+ * \brief Read an object from the read position of \ref reader, and move the
+ * position past it.
+ * \remark Each thread can read the same data with a reader of its own.
+ */
+Variable Deserialize(DataBufferReader& reader);
 }  // namespace Reflection
 }  // namespace MM
@@ -1,5 +1,7 @@
 #include "type.h"
 
+#include <typeinfo>
+
 #include "meta.h"
 
 bool MM::Reflection::TypeWrapper<void>::IsVoid() const { return true; }
@@ -30,7 +32,9 @@ bool MM::Reflection::TypeWrapper<void>::HaveMoveAssign() const { return false; }
 
 std::size_t MM::Reflection::TypeWrapper<void>::GetSize() const { return 0; }
 
-std::size_t MM::Reflection::TypeWrapper<void>::GetTypeHashCode() const { return typeid(void).hash_code(); }
+std::size_t MM::Reflection::TypeWrapper<void>::GetAlignment() const { return 0; }
+
+std::size_t MM::Reflection::TypeWrapper<void>::GetTypeHashCode() const { return Utils::TypeHashCodeV<void>; }
 
 std::size_t MM::Reflection::TypeWrapper<void>::GetOriginalTypeHashCode() const { return GetTypeHashCode(); }
 
@@ -40,17 +44,58 @@ std::string MM::Reflection::TypeWrapper<void>::GetTypeName(const std::string& or
 }
 
 const MM::Reflection::Meta* MM::Reflection::TypeWrapper<void>::GetMeta() const {
-  if (!IsRegistered()) {
-    return nullptr;
-  }
+  return FindMeta(GetOriginalTypeHashCode());
+}
 
-  return GetMetaDatabase().at(GetOriginalTypeHashCode());
+const MM::Reflection::Type* MM::Reflection::TypeWrapper<void>::GetOriginalType() const {
+  return &MM::Reflection::Type::CreateType<void>();
 }
 
 MM::Reflection::Type::Type() : type_wrapper_{nullptr} {}
 
-MM::Reflection::Type::Type(std::unique_ptr<TypeWrapperBase>&& other) noexcept
-    : type_wrapper_(std::move(other)) {}
+MM::Reflection::Type::Type(const TypeWrapperBase* type_wrapper) noexcept
+    : Type(type_wrapper, nullptr) {
+  // The original type is unknown, GetOrignalType asks the wrapper.
+  flags_ &= ~static_cast<std::uint32_t>(IS_ORIGINAL_TYPE);
+}
+
+MM::Reflection::Type::Type(const TypeWrapperBase* type_wrapper,
+                           const Type* original_type) noexcept
+    : type_wrapper_(type_wrapper), original_type_(original_type) {
+  if (type_wrapper_ == nullptr) {
+    original_type_ = nullptr;
+    return;
+  }
+  if (original_type_ == nullptr) {
+    flags_ |= IS_ORIGINAL_TYPE;
+  }
+
+  type_hash_code_ = type_wrapper_->GetTypeHashCode();
+  original_type_hash_code_ = type_wrapper_->GetOriginalTypeHashCode();
+  size_ = type_wrapper_->GetSize();
+  alignment_ = type_wrapper_->GetAlignment();
+  type_id_ = type_wrapper_->GetTypeID();
+
+  const std::pair<bool, TypeFlag> flags[] = {
+      {type_wrapper_->IsVoid(), IS_VOID},
+      {type_wrapper_->IsConst(), IS_CONST},
+      {type_wrapper_->IsReference(), IS_REFERENCE},
+      {type_wrapper_->IsArray(), IS_ARRAY},
+      {type_wrapper_->IsPointer(), IS_POINTER},
+      {type_wrapper_->IsEnum(), IS_ENUM},
+      {type_wrapper_->IsTrivial(), IS_TRIVIAL},
+      {type_wrapper_->HaveDefaultConstructor(), HAVE_DEFAULT_CONSTRUCTOR},
+      {type_wrapper_->HaveDestructor(), HAVE_DESTRUCTOR},
+      {type_wrapper_->HaveCopyConstructor(), HAVE_COPY_CONSTRUCTOR},
+      {type_wrapper_->HaveMoveConstructor(), HAVE_MOVE_CONSTRUCTOR},
+      {type_wrapper_->HaveCopyAssign(), HAVE_COPY_ASSIGN},
+      {type_wrapper_->HaveMoveAssign(), HAVE_MOVE_ASSIGN}};
+  for (const auto& flag : flags) {
+    if (flag.first) {
+      flags_ |= flag.second;
+    }
+  }
+}
 
 bool MM::Reflection::Type::operator==(const Type& other) const { return IsEqual(other); }
 
@@ -64,16 +109,6 @@ bool MM::Reflection::Type::IsRegistered() const {
   return type_wrapper_->IsRegistered();
 }
 
-bool MM::Reflection::Type::IsVoid() const {
-  if (!IsValid()) {
-    return false;
-  }
-
-  return type_wrapper_->IsVoid();
-}
-
-bool MM::Reflection::Type::IsValid() const { return type_wrapper_ != nullptr; }
-
 bool MM::Reflection::Type::IsEqual(const Type& other) const {
   if (IsValid() && other.IsValid()) {
     return GetTypeHashCode() == other.GetTypeHashCode();
@@ -81,84 +116,12 @@ bool MM::Reflection::Type::IsEqual(const Type& other) const {
   return false;
 }
 
-bool MM::Reflection::Type::IsConst() const {
-  if (!IsValid()) {
-    return false;
-  }
-  return type_wrapper_->IsConst();
-}
-
-bool MM::Reflection::Type::IsReference() const {
-  if (!IsValid()) {
-    return false;
-  }
-  return type_wrapper_->IsReference();
-}
-
-bool MM::Reflection::Type::IsArray() const {
-  if (!IsValid()) {
-    return false;
-  }
-  return type_wrapper_->IsArray();
-}
-
-bool MM::Reflection::Type::IsPointer() const {
-  if (!IsValid()) {
-    return false;
-  }
-  return type_wrapper_->IsPointer();
-}
-
-bool MM::Reflection::Type::IsEnum() const { return type_wrapper_->IsEnum(); }
-
-bool MM::Reflection::Type::IsTrivial() const {
-  if (!IsValid()) {
-    return false;
-  }
-
-  return type_wrapper_->IsTrivial();
-}
-
-bool MM::Reflection::Type::HaveDefaultConstructor() const {
-  if (!IsValid()) {
-    return false;
-  }
-  return type_wrapper_->HaveDefaultConstructor();
-}
-
-bool MM::Reflection::Type::HaveDestructor() const {
-  if (!IsValid()) {
-    return false;
-  }
-  return type_wrapper_->HaveDestructor();
-}
-
-bool MM::Reflection::Type::HaveCopyConstructor() const {
-  if (!IsValid()) {
-    return false;
-  }
-  return type_wrapper_->HaveCopyConstructor();
-}
-
-bool MM::Reflection::Type::HaveMoveConstructor() const {
-  if (!IsValid()) {
-    return false;
-  }
-  return type_wrapper_->HaveMoveConstructor();
-}
-
-bool MM::Reflection::Type::HaveCopyAssign() const {
-  if (!IsValid()) {
-    return false;
-  }
-  return type_wrapper_->HaveCopyAssign();
-}
-
-bool MM::Reflection::Type::HaveMoveAssign() const {
-  if (!IsValid()) {
-    return false;
+bool MM::Reflection::Type::IsSameCppType(const Type& other) const {
+  if (IsValid() && other.IsValid()) {
+    // Each type has a wrapper class of its own.
+    return typeid(*type_wrapper_) == typeid(*other.type_wrapper_);
   }
-  return type_wrapper_->HaveMoveAssign();
+  return !IsValid() && !other.IsValid();
 }
 
 auto MM::Reflection::Type::OriginalTypeIsEqual(
@@ -172,30 +135,16 @@ auto MM::Reflection::Type::OriginalTypeIsEqual(
 void MM::Reflection::Type::Swap(MM::Reflection::Type& other) {
   if (this != &other) {
     std::swap(type_wrapper_, other.type_wrapper_);
+    std::swap(original_type_, other.original_type_);
+    std::swap(type_hash_code_, other.type_hash_code_);
+    std::swap(original_type_hash_code_, other.original_type_hash_code_);
+    std::swap(size_, other.size_);
+    std::swap(alignment_, other.alignment_);
+    std::swap(type_id_, other.type_id_);
+    std::swap(flags_, other.flags_);
   }
 }
 
-std::size_t MM::Reflection::Type::GetSize() const {
-  if (!IsValid()) {
-    return 0;
-  }
-  return type_wrapper_->GetSize();
-}
-
-std::size_t MM::Reflection::Type::GetTypeHashCode() const {
-  if (!IsValid()) {
-    return 0;
-  }
-  return type_wrapper_->GetTypeHashCode();
-}
-
-std::size_t MM::Reflection::Type::GetOriginalTypeHashCode() const {
-  if (!IsValid()) {
-    return 0;
-  }
-  return type_wrapper_->GetOriginalTypeHashCode();
-}
-
 std::string MM::Reflection::Type::GetTypeName() const {
   if (!IsValid()) {
     return std::string();
@@ -218,28 +167,11 @@ const MM::Reflection::Meta* MM::Reflection::Type::GetMeta() const {
   return type_wrapper_->GetMeta();
 }
 
-const MM::Reflection::Type& MM::Reflection::Type::GetOrignalType() const {
-  if (GetOriginalTypeHashCode() == GetTypeHashCode()) {
-    return *this;
-  } else {
-    TypeID type_id{GetOriginalTypeHashCode(), false, false};
-    auto& type_database = GetTypeDatabase();
-    std::unordered_map<TypeID, const Type*>::iterator find_result =
-        type_database.find(type_id);
-    if (find_result == type_database.end()) {
-      auto emplace_result = type_database.emplace(
-          std::make_pair(type_id, new Type{type_wrapper_->GetOriginalType()}));
-      assert(emplace_result.second);
-      find_result = emplace_result.first;
-    }
-    return *find_result->second;
-  }
-}
-
-MM::Reflection::TypeID MM::Reflection::Type::GetTypeID() const {
+const MM::Reflection::Type& MM::Reflection::Type::GetOrignalTypeSlow() const {
   if (!IsValid()) {
-    return TypeID{};
+    return *this;
   }
 
-  return type_wrapper_->GetTypeID();
+  return *type_wrapper_->GetOriginalType();
 }
+
@@ -119,6 +119,12 @@ class TypeWrapperBase {
    */
   virtual std::size_t GetSize() const {return 0;}
 
+  /**
+   * \brief Get the alignment of type.
+   * \return The alignment of type.
+   */
+  virtual std::size_t GetAlignment() const {return 0;}
+
   TypeID GetTypeID() const {return TypeID{GetTypeHashCode(), IsConst(), IsReference()};}
 
   /**
@@ -150,7 +156,7 @@ class TypeWrapperBase {
    */
   virtual const Meta* GetMeta() const {return nullptr;}
 
-  virtual std::unique_ptr<TypeWrapperBase> GetOriginalType() const {return nullptr;}
+  virtual const Type* GetOriginalType() const {return nullptr;}
 };
 
 template <typename TypeName>
@@ -175,7 +181,7 @@ class TypeWrapper final : public TypeWrapperBase {
    * false.
    */
   bool IsRegistered() const override {
-    return GetMetaDatabase().find(GetOriginalTypeHashCode()) != GetMetaDatabase().end();
+    return FindMeta(GetOriginalTypeHashCode()) != nullptr;
   }
 
   /**
@@ -307,12 +313,20 @@ class TypeWrapper final : public TypeWrapperBase {
     return sizeof(TypeName);
   }
 
+  /**
+   * \brief Get alignment of \ref TypeName.
+   * \return The alignment of \ref TypeName.
+   */
+  std::size_t GetAlignment() const override {
+    return alignof(TypeName);
+  }
+
   /**
    * \brief Get type hash code.
    * \return The \ref TypeName hash code.
    */
   std::size_t GetTypeHashCode() const override {
-    return typeid(TypeName).hash_code();
+    return Utils::TypeHashCodeV<TypeName>;
   }
 
   /**
@@ -322,7 +336,7 @@ class TypeWrapper final : public TypeWrapperBase {
    * constants. (Example:int*: int, int&: int, const int&: int, etc.)
    */
   std::size_t GetOriginalTypeHashCode() const override {
-    return typeid(OriginalType).hash_code();
+    return Utils::TypeHashCodeV<OriginalType>;
   }
 
   /**
@@ -371,15 +385,10 @@ class TypeWrapper final : public TypeWrapperBase {
    * \remark If the type is not registered, the nullptr will be returned.
    */
   const Meta* GetMeta() const override {
-    if (!IsRegistered()) {
-      return nullptr;
-    }
-    return GetMetaDatabase().at(GetOriginalTypeHashCode());
+    return FindMeta(GetOriginalTypeHashCode());
   }
 
-  std::unique_ptr<TypeWrapperBase> GetOriginalType() const override {
-   return std::make_unique<TypeWrapper<Utils::GetOriginalTypeT<TypeName>>>();
-  }
+  const MM::Reflection::Type* GetOriginalType() const override;
 };
 
 template<>
@@ -488,6 +497,12 @@ public:
    */
   std::size_t GetSize() const override;
 
+  /**
+   * \brief Get alignment of \ref TypeName.
+   * \return The alignment of \ref TypeName.
+   */
+  std::size_t GetAlignment() const override;
+
   /**
    * \brief Get type hash code.
    * \return The \ref TypeName hash code.
@@ -517,32 +532,51 @@ public:
    */
   const Meta* GetMeta() const override;
 
-  std::unique_ptr<TypeWrapperBase> GetOriginalType() const override {
-   return std::make_unique<TypeWrapper<void>>();
-  }
+  const MM::Reflection::Type* GetOriginalType() const override;
 };
 
+template <typename TypeName>
+struct StaticTypeStorage;
+
 class Type {
   template <typename VariableType>
   friend class VariableWrapper;
 
  public:
+  /**
+   * \brief The traits of a type, packed into \ref GetFlags.
+   */
+  enum TypeFlag : std::uint32_t {
+    IS_VOID = 1u << 0,
+    IS_CONST = 1u << 1,
+    IS_REFERENCE = 1u << 2,
+    IS_ARRAY = 1u << 3,
+    IS_POINTER = 1u << 4,
+    IS_ENUM = 1u << 5,
+    IS_TRIVIAL = 1u << 6,
+    HAVE_DEFAULT_CONSTRUCTOR = 1u << 7,
+    HAVE_DESTRUCTOR = 1u << 8,
+    HAVE_COPY_CONSTRUCTOR = 1u << 9,
+    HAVE_MOVE_CONSTRUCTOR = 1u << 10,
+    HAVE_COPY_ASSIGN = 1u << 11,
+    HAVE_MOVE_ASSIGN = 1u << 12,
+    // The type has no pointer, refrence, array or const, so it is its own
+    // original type.
+    IS_ORIGINAL_TYPE = 1u << 13
+  };
+
+ public:
+  /**
+   * \brief Get the type of \ref TypeName.
+   * \return The type of \ref TypeName.
+   * \remark The type and its wrapper live in static storage. Only the first
+   * call of each \ref TypeName accesses the type database, later calls just
+   * load the cached pointer.
+   */
   template <typename TypeName>
   static const Type& CreateType() {
-    constexpr bool is_top_const = std::is_const_v<TypeName>;
-    constexpr bool is_low_const = (std::is_pointer_v<TypeName> ? std::is_const_v<std::remove_pointer_t<TypeName>> : false) ||
-                                  (std::is_reference_v<TypeName> ? std::is_const_v<std::remove_reference_t<TypeName>> : false);
-    constexpr bool is_l_reference = std::is_lvalue_reference_v<TypeName>;
-    constexpr bool is_r_reference = std::is_rvalue_reference_v<TypeName>;
-    TypeID type_id{typeid(TypeName).hash_code(), is_top_const, is_low_const, is_l_reference, is_r_reference};
-    auto& type_database = GetTypeDatabase();
-    std::unordered_map<TypeID, const Type*>::iterator find_result = type_database.find(type_id);
-    if (find_result == type_database.end()) {
-      auto emplace_result = type_database.emplace(std::make_pair(type_id, new Type{std::make_unique<TypeWrapper<TypeName>>()}));
-      assert(emplace_result.second);
-      find_result = emplace_result.first;
-    }
-    return *find_result->second;
+    static const Type* type = GetTypeDatabase().Insert(CreateTypeID<TypeName>(), &StaticTypeStorage<TypeName>::Get());
+    return *type;
   }
 
  public:
@@ -550,7 +584,17 @@ class Type {
   ~Type() = default;
   Type(const Type& other) = delete;
   Type(Type&& other) noexcept = default;
-  explicit Type(std::unique_ptr<TypeWrapperBase>&& other) noexcept;
+  /**
+   * \brief Create a type from \ref type_wrapper.
+   * \remark The traits of \ref type_wrapper are queried once here and cached.
+   */
+  explicit Type(const TypeWrapperBase* type_wrapper) noexcept;
+  /**
+   * \brief Create a type from \ref type_wrapper and cache \ref original_type.
+   * \remark Pass nullptr as \ref original_type if this type is its own
+   * original type.
+   */
+  Type(const TypeWrapperBase* type_wrapper, const Type* original_type) noexcept;
   Type& operator=(const Type& other) = delete;
   Type& operator=(Type&& other) noexcept = default;
 
@@ -571,14 +615,14 @@ class Type {
 
   bool IsRegistered() const;
 
-  bool IsVoid() const;
+  bool IsVoid() const { return (flags_ & IS_VOID) != 0; }
 
   /**
    * \brief Judge whether the object is a valid object.
    * \return Returns true if the object is a valid object, otherwise returns
    * false.
    */
-  bool IsValid() const;
+  bool IsValid() const { return type_wrapper_ != nullptr; }
 
   /**
    * \brief Judge whether the types are equal.
@@ -594,84 +638,90 @@ class Type {
    * \return If the type is "const", it returns true; otherwise, it returns
    * false.
    */
-  bool IsConst() const;
+  bool IsConst() const { return (flags_ & IS_CONST) != 0; }
 
   /**
    * \brief Determine whether type is "reference".
    * \return If the type is "reference", it returns true; otherwise, it returns
    * false.
    */
-  bool IsReference() const;
+  bool IsReference() const { return (flags_ & IS_REFERENCE) != 0; }
 
   /**
    * \brief Determine whether type is "array".
    * \return If the type is "array", it returns true; otherwise, it returns
    * false.
    */
-  bool IsArray() const;
+  bool IsArray() const { return (flags_ & IS_ARRAY) != 0; }
 
   /**
    * \brief Determine whether type is "pointer".
    * \return If the type is "pointer", it returns true; otherwise, it returns
    * false.
    */
-  bool IsPointer() const;
+  bool IsPointer() const { return (flags_ & IS_POINTER) != 0; }
 
   /**
    * \brief Determine whether this property is an enumeration.
    * \return If this property is an enumeration, it returns true, otherwise it
    * returns false.
    */
-  bool IsEnum() const;
+  bool IsEnum() const { return (flags_ & IS_ENUM) != 0; }
 
   /**
    * \brief Determine whether the type is trivial type.
    * \return If the type is trivial type, it returns true,
    * otherwise it returns false.
    */
-  bool IsTrivial() const;
+  bool IsTrivial() const { return (flags_ & IS_TRIVIAL) != 0; }
 
   /**
    * \brief Determine whether the type has a default constructor.
    * \return If the type contains a default constructor, it returns true,
    * otherwise it returns false.
    */
-  bool HaveDefaultConstructor() const;
+  bool HaveDefaultConstructor() const {
+    return (flags_ & HAVE_DEFAULT_CONSTRUCTOR) != 0;
+  }
 
   /**
    * \brief Determine whether the type has a destructor.
    * \return If the type contains a destructor, it returns true,
    * otherwise it returns false.
    */
-  bool HaveDestructor() const;
+  bool HaveDestructor() const { return (flags_ & HAVE_DESTRUCTOR) != 0; }
 
   /**
    * \brief Determine whether the type has a copy constructor.
    * \return If the type contains a copy constructor, it returns true,
    * otherwise it returns false.
    */
-  bool HaveCopyConstructor() const;
+  bool HaveCopyConstructor() const {
+    return (flags_ & HAVE_COPY_CONSTRUCTOR) != 0;
+  }
 
   /**
    * \brief Determine whether the type has a move constructor.
    * \return If the type contains a move constructor, it returns true,
    * otherwise it returns false.
    */
-  bool HaveMoveConstructor() const;
+  bool HaveMoveConstructor() const {
+    return (flags_ & HAVE_MOVE_CONSTRUCTOR) != 0;
+  }
 
   /**
    * \brief Determine whether the type has a copy assign.
    * \return If the type contains a copy assign, it returns true,
    * otherwise it returns false.
    */
-  bool HaveCopyAssign() const;
+  bool HaveCopyAssign() const { return (flags_ & HAVE_COPY_ASSIGN) != 0; }
 
   /**
    * \brief Determine whether the type has a move assign.
    * \return If the type contains a move assign, it returns true,
    * otherwise it returns false.
    */
-  bool HaveMoveAssign() const;
+  bool HaveMoveAssign() const { return (flags_ & HAVE_MOVE_ASSIGN) != 0; }
 
   /**
    * \brief Judge whether the original types are equal.
@@ -682,6 +732,18 @@ class Type {
    */
   bool OriginalTypeIsEqual(const Type& other) const;
 
+  /**
+   * \brief Judge whether the two types were created from the same C++ type.
+   * \param other Object to be judged.
+   * \return Returns true if the two types are the same C++ type, or both are
+   * invalid, otherwise returns false.
+   * \remark Unlike \ref IsEqual, it does not compare the hash codes, which
+   * are the same for different types spelled the same (for example two
+   * lambdas in one function, or types of the same name in anonymous
+   * namespaces of different files).
+   */
+  bool IsSameCppType(const Type& other) const;
+
   /**
    * \brief Swap two object.
    * \param other Objects to be exchanged.
@@ -692,16 +754,28 @@ class Type {
    * \brief Get the size of \ref TypeName
    * \return The size of \ref TypeName.
    */
-  std::size_t GetSize() const;
+  std::size_t GetSize() const { return size_; }
 
-  TypeID GetTypeID() const;
+  /**
+   * \brief Get the alignment of \ref TypeName
+   * \return The alignment of \ref TypeName.
+   */
+  std::size_t GetAlignment() const { return alignment_; }
+
+  /**
+   * \brief Get all traits of the type.
+   * \return The bitwise or of \ref TypeFlag.
+   */
+  std::uint32_t GetFlags() const { return flags_; }
+
+  TypeID GetTypeID() const { return type_id_; }
 
   /**
    * \brief Get type hash code.
    * \return The type hash code.
    * \remark If object is not valid, it will return 0.
    */
-  TypeHashCode GetTypeHashCode() const;
+  TypeHashCode GetTypeHashCode() const { return type_hash_code_; }
 
   /**
    * \brief Get original type hash code.
@@ -710,7 +784,9 @@ class Type {
    * constants. (Example:int*: int, int&: int, const int&: int, etc.)
    * \remark If object is not valid, it will return 0.
    */
-  TypeHashCode GetOriginalTypeHashCode() const;
+  TypeHashCode GetOriginalTypeHashCode() const {
+    return original_type_hash_code_;
+  }
 
   /**
    * \brief Get type Name.
@@ -738,11 +814,76 @@ class Type {
    */
   const Meta* GetMeta() const;
 
-  const Type& GetOrignalType() const;
+  const Type& GetOrignalType() const {
+    if ((flags_ & IS_ORIGINAL_TYPE) != 0) {
+      return *this;
+    }
+    if (original_type_ != nullptr) {
+      return *original_type_;
+    }
+    return GetOrignalTypeSlow();
+  }
+
+ private:
+  template <typename TypeName>
+  static TypeID CreateTypeID() {
+    constexpr bool is_top_const = std::is_const_v<TypeName>;
+    constexpr bool is_low_const = (std::is_pointer_v<TypeName> ? std::is_const_v<std::remove_pointer_t<TypeName>> : false) ||
+                                  (std::is_reference_v<TypeName> ? std::is_const_v<std::remove_reference_t<TypeName>> : false);
+    constexpr bool is_l_reference = std::is_lvalue_reference_v<TypeName>;
+    constexpr bool is_r_reference = std::is_rvalue_reference_v<TypeName>;
+    return TypeID{Utils::TypeHashCodeV<TypeName>, is_top_const, is_low_const, is_l_reference, is_r_reference};
+  }
+
+ private:
+  const Type& GetOrignalTypeSlow() const;
 
  private:
-  std::unique_ptr<TypeWrapperBase> type_wrapper_ = nullptr;
+  const TypeWrapperBase* type_wrapper_ = nullptr;
+  // Cached when the type is created, so queries do not call the wrapper.
+  const Type* original_type_ = nullptr;
+  TypeHashCode type_hash_code_{0};
+  TypeHashCode original_type_hash_code_{0};
+  std::size_t size_{0};
+  std::size_t alignment_{0};
+  TypeID type_id_{};
+  std::uint32_t flags_{0};
+};
+
+/**
+ * \brief Static storage of the type of \ref TypeName.
+ * \remark It is never destroyed, so types stay valid while other static
+ * objects are destroyed.
+ */
+template <typename TypeName>
+struct StaticTypeStorage {
+  StaticTypeStorage() : type_wrapper_(), type_(&type_wrapper_, GetOriginalType()) {}
+  ~StaticTypeStorage() {}
+
+  static const Type* GetOriginalType() {
+    using OriginalType = typename TypeWrapper<TypeName>::OriginalType;
+    if constexpr (std::is_same_v<TypeName, OriginalType>) {
+      return nullptr;
+    } else {
+      return &Type::CreateType<OriginalType>();
+    }
+  }
+
+  static const Type& Get() {
+    static StaticTypeStorage storage{};
+    return storage.type_;
+  }
+
+  union {
+    TypeWrapper<TypeName> type_wrapper_;
+  };
+  Type type_;
 };
+
+template <typename TypeName>
+const Type* TypeWrapper<TypeName>::GetOriginalType() const {
+  return &MM::Reflection::Type::CreateType<OriginalType>();
+}
 }  // namespace Reflection
 }  // namespace MM
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 #include <type_traits>
 
 namespace MM {
@@ -248,6 +249,72 @@ using MakeIndexSequence = MakeIntegerSequence<std::size_t, N>;
 template <class... T>
 using IndexSequenceFor = MakeIndexSequence<sizeof...(T)>;
 
+/**
+ * \brief Hash \ref string with 64-bit FNV-1a.
+ * \return The hash of \ref string.
+ * \remark The result only depends on the characters of \ref string, so it is
+ * stable between runs, compilers and platforms.
+ */
+constexpr std::uint64_t HashString(std::string_view string) {
+  std::uint64_t result = 14695981039346656037ULL;
+  for (const char character : string) {
+    result ^= static_cast<std::uint8_t>(character);
+    result *= 1099511628211ULL;
+  }
+
+  return result;
+}
+
+/**
+ * \brief Get the name of \ref TypeName spelled by the compiler.
+ * \return The name of \ref TypeName.
+ * \remark It is extracted from the signature of this function at compile time
+ * and does not need RTTI.
+ */
+template <typename TypeName>
+constexpr std::string_view GetCompilerTypeName() {
+#if defined(__clang__)
+  constexpr std::string_view function_name = __PRETTY_FUNCTION__;
+  constexpr std::string_view prefix = "[TypeName = ";
+  constexpr std::size_t begin = function_name.find(prefix) + prefix.size();
+  constexpr std::size_t end = function_name.rfind(']');
+#elif defined(__GNUC__)
+  constexpr std::string_view function_name = __PRETTY_FUNCTION__;
+  constexpr std::string_view prefix = "[with TypeName = ";
+  constexpr std::size_t begin = function_name.find(prefix) + prefix.size();
+  constexpr std::size_t end = function_name.find(';', begin) == std::string_view::npos
+                                  ? function_name.rfind(']')
+                                  : function_name.find(';', begin);
+#elif defined(_MSC_VER)
+  constexpr std::string_view function_name = __FUNCSIG__;
+  constexpr std::string_view prefix = "GetCompilerTypeName<";
+  constexpr std::size_t begin = function_name.find(prefix) + prefix.size();
+  constexpr std::size_t end = function_name.rfind(">(void)");
+#else
+#error "Unsupported compiler."
+#endif
+  return function_name.substr(begin, end - begin);
+}
+
+/**
+ * \brief Get the hash code of \ref TypeName.
+ * \return The hash code of \ref TypeName.
+ * \remark Like typeid, references and top level const/volatile are ignored.
+ * (Example: int, const int, int& and const int& have the same hash code.)
+ * \remark The hash code is a constant expression, so it can be used as a
+ * template argument or a case label.
+ * \remark Different types that the compiler spells the same (such as two
+ * lambdas in one function) have the same hash code. Creating the types of
+ * both aborts (see \ref TypeDatabase::Insert).
+ */
+template <typename TypeName>
+constexpr std::uint64_t GetTypeHashCode() {
+  return HashString(GetCompilerTypeName<std::remove_cv_t<std::remove_reference_t<TypeName>>>());
+}
+
+template <typename TypeName>
+constexpr std::uint64_t TypeHashCodeV = GetTypeHashCode<TypeName>();
+
 template <typename FirstType, typename... Types>
 struct AllTypeHashCode {
   static std::size_t HashCode();
@@ -260,13 +327,13 @@ struct AllTypeHashCode<FirstType> {
 
 template <typename FirstType, typename... Types>
 std::size_t AllTypeHashCode<FirstType, Types...>::HashCode() {
-  return typeid(FirstType).hash_code() +
+  return TypeHashCodeV<FirstType> +
          (AllTypeHashCode<Types...>::HashCode() << 1);
 }
 
 template <typename FirstType>
 std::size_t AllTypeHashCode<FirstType>::HashCode() {
-  return typeid(FirstType).hash_code();
+  return TypeHashCodeV<FirstType>;
 }
 
  /**
@@ -21,13 +21,15 @@ MM::Reflection::Variable::Variable(
   assert(wrapper_base_ptr != nullptr);
   if (other.variable_type_ == VariableType::SMALL_OBJECT) {
     variable_type_ = VariableType::SMALL_OBJECT;
+    if (other.is_trivially_relocatable_) {
+      wrapper_.small_wrapper_ = other.wrapper_.small_wrapper_;
+      is_trivially_relocatable_ = true;
+      return;
+    }
     // GetWrapperBasePtr depend on variable_type_
-    VariableWrapperBase* new_ptr = wrapper_base_ptr->CopyToBasePointer(GetWrapperBasePtr());
+    wrapper_base_ptr->CopyToBasePointer(GetWrapperBasePtr());
   } else {
-  VariableWrapperBase* new_ptr = wrapper_base_ptr->CopyToBasePointer(nullptr);
-
-  wrapper_.common_wrapper_ = new_ptr;
-  variable_type_ = VariableType::COMMON_OBJECT;
+    CopyToHeapWrapper(wrapper_base_ptr);
   }
 }
 
@@ -37,21 +39,33 @@ MM::Reflection::Variable::Variable(
     return;
   }
 
+  if (other.variable_type_ == VariableType::COMMON_OBJECT) {
+    // Take over the wrapper instead of moving the value to a new one.
+    wrapper_.common_wrapper_ = other.wrapper_.common_wrapper_;
+    variable_type_ = VariableType::COMMON_OBJECT;
+    other.wrapper_.common_wrapper_ = nullptr;
+    other.variable_type_ = VariableType::INVALID;
+    return;
+  }
+  if (other.variable_type_ == VariableType::PLACMENT_OBJECT) {
+    MoveToHeapWrapper(other.wrapper_.placement_wrapper_);
+    other.Destroy();
+    return;
+  }
+
+  variable_type_ = VariableType::SMALL_OBJECT;
+  if (other.is_trivially_relocatable_) {
+    wrapper_.small_wrapper_ = other.wrapper_.small_wrapper_;
+    is_trivially_relocatable_ = true;
+    return;
+  }
   VariableWrapperBase* wrapper_base_ptr = other.GetWrapperBasePtr();
   assert(wrapper_base_ptr != nullptr);
-  if (other.variable_type_ == VariableType::SMALL_OBJECT) {
-    variable_type_ = VariableType::SMALL_OBJECT;
-    // GetWrapperBasePtr depend on variable_type_
-    if (other.IsRefrenceVariable()) {
-      VariableWrapperBase* new_ptr = wrapper_base_ptr->CopyToBasePointer(GetWrapperBasePtr());
-    } else {
-      VariableWrapperBase* new_ptr = wrapper_base_ptr->MoveToBasePointer(GetWrapperBasePtr());
-    }
+  // GetWrapperBasePtr depend on variable_type_
+  if (wrapper_base_ptr->IsRefrenceVariable()) {
+    wrapper_base_ptr->CopyToBasePointer(GetWrapperBasePtr());
   } else {
-    VariableWrapperBase* new_ptr = wrapper_base_ptr->MoveToBasePointer(nullptr);
-
-    wrapper_.common_wrapper_ = new_ptr;
-    variable_type_ = VariableType::COMMON_OBJECT;
+    wrapper_base_ptr->MoveToBasePointer(GetWrapperBasePtr());
   }
 }
 
@@ -78,10 +92,34 @@ MM::Reflection::Variable& MM::Reflection::Variable::operator=(
     return *this;
   }
   if (!IsValid() && other.IsValid()) {
+    if (other.variable_type_ == VariableType::SMALL_OBJECT &&
+        !other.is_trivially_relocatable_) {
+      // The inline value may point into itself (e.g. std::string), so it
+      // must be moved instead of copied bytewise.
+      variable_type_ = VariableType::SMALL_OBJECT;
+      VariableWrapperBase* other_wrapper_base_ptr = other.GetWrapperBasePtr();
+      if (other.IsRefrenceVariable()) {
+        other_wrapper_base_ptr->CopyToBasePointer(GetWrapperBasePtr());
+      } else {
+        other_wrapper_base_ptr->MoveToBasePointer(GetWrapperBasePtr());
+      }
+      other.Destroy();
+
+      return *this;
+    }
+    if (other.variable_type_ == VariableType::PLACMENT_OBJECT) {
+      MoveToHeapWrapper(other.wrapper_.placement_wrapper_);
+      other.Destroy();
+
+      return *this;
+    }
+
     memcpy(&wrapper_, &other.wrapper_, sizeof(other.wrapper_));
     variable_type_ = other.variable_type_;
+    is_trivially_relocatable_ = other.is_trivially_relocatable_;
 
     other.variable_type_ = VariableType::INVALID;
+    other.is_trivially_relocatable_ = false;
 
     return *this;
   }
@@ -365,6 +403,212 @@ MM::Reflection::Variable MM::Reflection::Variable::Invoke(
   return Variable{};
 }
 
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    const std::string& method_name, Variable* const* args, std::size_t argument_number) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this, args, argument_number);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::GetPropertyVariable(
+    NameId property_name) {
+  const Meta* metadata = GetMeta();
+    if (metadata != nullptr) {
+      const Property* target_property = metadata->GetProperty(property_name);
+      if (target_property != nullptr) {
+        assert(target_property->IsValid());
+        return target_property->GetPropertyVariable(*this);
+      }
+    }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::GetPropertyVariable(
+    NameId property_name) const {
+  const Meta* metadata = GetMeta();
+    if (metadata != nullptr) {
+      const Property* target_property = metadata->GetProperty(property_name);
+      if (target_property != nullptr) {
+        assert(target_property->IsValid());
+        return target_property->GetPropertyVariable(*this);
+      }
+    }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    NameId method_name) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    NameId method_name, Variable& arg1) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this, arg1);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    NameId method_name, Variable& arg1, Variable& arg2) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this, arg1, arg2);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    NameId method_name, Variable& arg1, Variable& arg2,
+    Variable& arg3) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this, arg1, arg2, arg3);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    NameId method_name, Variable& arg1, Variable& arg2,
+    Variable& arg3, Variable& arg4) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this, arg1, arg2, arg3, arg4);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    NameId method_name, Variable& arg1, Variable& arg2,
+    Variable& arg3, Variable& arg4, Variable& arg5) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this, arg1, arg2, arg3, arg4, arg5);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    NameId method_name, Variable& arg1, Variable& arg2,
+    Variable& arg3, Variable& arg4, Variable& arg5, Variable& arg6) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this, arg1, arg2, arg3, arg4, arg5, arg6);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    NameId method_name, std::vector<Variable*>& args) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this, args);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    NameId method_name, std::vector<Variable*>&& args) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this, args);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
+MM::Reflection::Variable MM::Reflection::Variable::Invoke(
+    NameId method_name, Variable* const* args, std::size_t argument_number) {
+  if (IsValid()) {
+      const Meta* metadata = GetMeta();
+      if (metadata != nullptr) {
+        const Method* method{metadata->GetMethod(method_name)};
+        if (method != nullptr) {
+          assert(method->IsValid());
+          return method->Invoke(*this, args, argument_number);
+        }
+        return Variable{};
+      }
+  }
+  return Variable{};
+}
+
 void* MM::Reflection::Variable::ReleaseOwnership() {
   void* result = nullptr;
   switch (variable_type_) {
@@ -383,9 +627,12 @@ void* MM::Reflection::Variable::ReleaseOwnership() {
 void MM::Reflection::Variable::Destroy() {
   switch (variable_type_) {
     case VariableType::SMALL_OBJECT:
-      wrapper_.small_wrapper_.GetWrpperBasePtr()->Destroy();
+      if (!is_trivially_relocatable_) {
+        wrapper_.small_wrapper_.GetWrpperBasePtr()->Destroy();
+      }
       wrapper_.small_wrapper_ = SmallObject{};
       variable_type_ = VariableType::INVALID;
+      is_trivially_relocatable_ = false;
       break;
     case VariableType::COMMON_OBJECT:
       delete wrapper_.common_wrapper_;
@@ -446,9 +693,9 @@ MM::Reflection::Variable::WrapperObject::GetWrpperBasePtr() {
   return reinterpret_cast<VariableWrapperBase*>(this);
 }
 
-void MM::Reflection::Variable::WrapperObject::SetPtr1(void* ptr) { ptr1 = ptr; }
+void MM::Reflection::Variable::WrapperObject::SetPtr1(void* ptr) { ptrs_[0] = ptr; }
 
-void MM::Reflection::Variable::WrapperObject::SetPtr2(void* ptr) { ptr2 = ptr; }
+void MM::Reflection::Variable::WrapperObject::SetPtr2(void* ptr) { ptrs_[1] = ptr; }
 
 const MM::Reflection::VariableWrapperBase*
 MM::Reflection::Variable::GetWrapperBasePtr() const {
@@ -464,6 +711,57 @@ MM::Reflection::Variable::GetWrapperBasePtr() const {
   }
 }
 
+void MM::Reflection::Variable::CopyToHeapWrapper(
+    const VariableWrapperBase* other_wrapper_base_ptr) {
+  VariableArena* arena = VariableArena::GetCurrentArena();
+  if (arena != nullptr) {
+    void* address =
+        arena->Allocate(other_wrapper_base_ptr->GetWrapperSize(),
+                        other_wrapper_base_ptr->GetWrapperAlignment());
+    wrapper_.placement_wrapper_ =
+        other_wrapper_base_ptr->CopyToBasePointer(address);
+    variable_type_ = VariableType::PLACMENT_OBJECT;
+    return;
+  }
+
+  wrapper_.common_wrapper_ = other_wrapper_base_ptr->CopyToBasePointer(nullptr);
+  variable_type_ = VariableType::COMMON_OBJECT;
+}
+
+void MM::Reflection::Variable::MoveToHeapWrapper(
+    VariableWrapperBase* other_wrapper_base_ptr) {
+  // Refrences and types that cannot be moved are copied.
+  if (other_wrapper_base_ptr->IsRefrenceVariable()) {
+    CopyToHeapWrapper(other_wrapper_base_ptr);
+    return;
+  }
+
+  VariableArena* arena = VariableArena::GetCurrentArena();
+  if (arena != nullptr) {
+    void* address =
+        arena->Allocate(other_wrapper_base_ptr->GetWrapperSize(),
+                        other_wrapper_base_ptr->GetWrapperAlignment());
+    wrapper_.placement_wrapper_ =
+        other_wrapper_base_ptr->MoveToBasePointer(address);
+    if (wrapper_.placement_wrapper_ == nullptr) {
+      wrapper_.placement_wrapper_ =
+          other_wrapper_base_ptr->CopyToBasePointer(address);
+    }
+    variable_type_ = wrapper_.placement_wrapper_ != nullptr
+                         ? VariableType::PLACMENT_OBJECT
+                         : VariableType::INVALID;
+    return;
+  }
+
+  wrapper_.common_wrapper_ = other_wrapper_base_ptr->MoveToBasePointer(nullptr);
+  if (wrapper_.common_wrapper_ == nullptr) {
+    wrapper_.common_wrapper_ = other_wrapper_base_ptr->CopyToBasePointer(nullptr);
+  }
+  variable_type_ = wrapper_.common_wrapper_ != nullptr
+                       ? VariableType::COMMON_OBJECT
+                       : VariableType::INVALID;
+}
+
 MM::Reflection::VariableWrapperBase*
 MM::Reflection::Variable::GetWrapperBasePtr() {
   switch (variable_type_) {
@@ -490,6 +788,10 @@ std::uint64_t MM::Reflection::VariableWrapperBase::GetWrapperSize() const {
   return 0;
 }
 
+std::uint64_t MM::Reflection::VariableWrapperBase::GetWrapperAlignment() const {
+  return alignof(std::max_align_t);
+}
+
 bool MM::Reflection::VariableWrapperBase::IsPropertyVariable() const {
   return false;
 }
@@ -549,6 +851,10 @@ std::uint64_t MM::Reflection::VoidVariable::GetWrapperSize() const {
   return sizeof(VoidVariable);
 }
 
+std::uint64_t MM::Reflection::VoidVariable::GetWrapperAlignment() const {
+  return alignof(VoidVariable);
+}
+
 bool MM::Reflection::VoidVariable::IsVoid() const { return true; }
 
 MM::Reflection::VariableWrapperBase*
@@ -1,12 +1,22 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "name_id.h"
 #include "type.h"
 #include "type_utils.h"
+#include "variable_arena.h"
+
+// The number of bytes of value that \ref MM::Reflection::Variable stores
+// inline before it falls back to the heap. It must be a non-zero multiple of
+// sizeof(void*), and can be set by the CMake cache variable of the same name.
+#ifndef MM_REFLECTION_VARIABLE_INLINE_SIZE
+#define MM_REFLECTION_VARIABLE_INLINE_SIZE 8
+#endif
 
 namespace MM {
 namespace Reflection {
@@ -29,6 +39,8 @@ class VariableWrapperBase {
 
   virtual std::uint64_t GetWrapperSize() const;
 
+  virtual std::uint64_t GetWrapperAlignment() const;
+
   virtual bool IsPropertyVariable() const;
 
   virtual bool IsVoid() const;
@@ -168,6 +180,10 @@ class VariableRefrenceWrapper : public VariableWrapperBase {
     return sizeof(VariableRefrenceWrapper);
   }
 
+  std::uint64_t GetWrapperAlignment() const override {
+    return alignof(VariableRefrenceWrapper);
+  }
+
   bool IsPropertyVariable() const override { return false; }
 
   bool IsRefrenceVariable() const override { return true; }
@@ -386,6 +402,10 @@ class VariableWrapper final : public VariableWrapperBase {
     return sizeof(VariableWrapper);
   }
 
+  std::uint64_t GetWrapperAlignment() const override {
+    return alignof(VariableWrapper);
+  }
+
   bool IsPropertyVariable() const override { return false; }
 
   VariableWrapperBase* CopyToBasePointer(
@@ -611,6 +631,8 @@ class VoidVariable : public VariableWrapperBase {
  public:
   std::uint64_t GetWrapperSize() const override;
 
+  std::uint64_t GetWrapperAlignment() const override;
+
   bool IsVoid() const override;
 
   /**
@@ -723,47 +745,55 @@ public:
    */
   template <typename VariableType>
   static Variable CreateVariable(VariableType&& other, bool is_copy = false) {
+    // Every path returns \ref variable so that it is constructed in place
+    // (NRVO) instead of being moved out of the inline buffer.
+    Variable variable{};
     if (!is_copy && std::is_lvalue_reference_v<VariableType>) {
-      Variable variable{};
       variable.variable_type_ = Variable::VariableType::SMALL_OBJECT;
+      variable.is_trivially_relocatable_ = true;
       void* small_object_address = &variable.wrapper_.small_wrapper_;
       new (small_object_address) VariableRefrenceWrapper<VariableType>{other};
       return variable;
     }
     if constexpr (std::is_rvalue_reference_v<VariableType> && !std::is_move_constructible_v<std::remove_reference_t<VariableType>>) {
-      return Variable{};
+      return variable;
     } else if constexpr (std::is_lvalue_reference_v<VariableType> && !std::is_copy_constructible_v<std::remove_reference_t<VariableType>>) {
-      return Variable{};
+      return variable;
     } else {
-      if constexpr (sizeof(VariableType) <= sizeof(SmallObject) - sizeof(void*)) {
-        Variable variable{};
+      if constexpr (IsSmallObject<std::remove_reference_t<VariableType>>()) {
         variable.variable_type_ = Variable::VariableType::SMALL_OBJECT;
+        variable.is_trivially_relocatable_ =
+            std::is_trivially_copyable_v<std::remove_reference_t<VariableType>>;
         void* small_object_address = &variable.wrapper_.small_wrapper_;
         new (small_object_address)
             VariableWrapper<std::remove_reference_t<VariableType>>{
                 std::forward<VariableType>(other)};
-        return variable;
+      } else {
+        variable.CreateHeapWrapper<
+            VariableWrapper<std::remove_reference_t<VariableType>>>(
+            std::forward<VariableType>(other));
       }
-
-      return Variable{new VariableWrapper<std::remove_reference_t<VariableType>>{
-          std::forward<VariableType>(other)}};
+      return variable;
     }
   }
 
   template <typename VariableType, typename... Args>
   static Variable EmplaceVariable(Args&&... args) {
-    if constexpr (sizeof(VariableType) <= sizeof(SmallObject) - sizeof(void*)) {
-      Variable variable{};
+    Variable variable{};
+    if constexpr (IsSmallObject<std::remove_reference_t<VariableType>>()) {
       variable.variable_type_ = Variable::VariableType::SMALL_OBJECT;
+      variable.is_trivially_relocatable_ =
+          std::is_trivially_copyable_v<std::remove_reference_t<VariableType>>;
       void* small_object_address = &variable.wrapper_.small_wrapper_;
       new (small_object_address)
           VariableWrapper<std::remove_reference_t<VariableType>>{
               std::forward<Args>(args)...};
-      return variable;
+    } else {
+      variable.CreateHeapWrapper<
+          VariableWrapper<std::remove_reference_t<VariableType>>>(
+          std::forward<Args>(args)...);
     }
-
-    return Variable{new VariableWrapper<std::remove_reference_t<VariableType>>{
-        std::forward<Args>(args)...}};
+    return variable;
   }
 
   /**
@@ -805,6 +835,19 @@ public:
 
   static Variable CreateVoidVariable();
 
+  /**
+   * \brief Judge whether a value of \ref VariableType is stored inline.
+   * \tparam VariableType The type of the value.
+   * \return Returns true if the wrapper of \ref VariableType fits in
+   * \ref SmallObject, otherwise returns false.
+   * \remark The inline capacity is \ref MM_REFLECTION_VARIABLE_INLINE_SIZE.
+   */
+  template <typename VariableType>
+  static constexpr bool IsSmallObject() {
+    return sizeof(VariableWrapper<VariableType>) <= sizeof(SmallObject) &&
+           alignof(VariableWrapper<VariableType>) <= alignof(SmallObject);
+  }
+
   /**
    * \brief Copy constructor.
    * \param other Other objects will be copied to this object.
@@ -820,6 +863,10 @@ public:
    * \remark If the value held by this object has no move constructor,
    * this function will do nothing. \remark If \ref other is an invalid
    * object, this object will also change to an invalid object.
+   * \remark A value allocated with operator new is not moved, this object
+   * takes over its storage and \ref other becomes an invalid object. A value
+   * in a \ref VariableArena or a caller buffer is moved to new storage (see
+   * \ref CreateHeapWrapper), because that storage may be reused first.
    */
   Variable(Variable&& other) noexcept;
 
@@ -1089,6 +1136,219 @@ public:
   Variable Invoke(const std::string& method_name,
                   std::vector<Variable*>&& args);
 
+  /**
+   * \brief Invoke the function with any number of arguments.
+   * \param method_name The name of a method that you want call.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function. \remark If the number or type of incoming
+   * argument is different from the argument required by the function
+   * held by this object or the target method not exist, the function
+   * held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(const std::string& method_name, Variable* const* args,
+                  std::size_t argument_number);
+
+  /**
+   * \brief Invoke the function with any number of arguments.
+   * \param method_name The name of a method that you want call.
+   * \param args Arguments.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function.
+   * \remark The arguments are passed on the stack, no memory is allocated.
+   */
+  template <typename... Args, typename = std::enable_if_t<(std::is_same_v<Args, Variable> && ...)>>
+  Variable Invoke(const std::string& method_name, Args&... args) {
+    std::array<Variable*, sizeof...(Args)> arg_array{&args...};
+    return Invoke(method_name, arg_array.data(), sizeof...(Args));
+  }
+
+  /**
+   * \brief Gets the properties of the object held by this object.
+   * \param property_name The interned name of property.
+   * \return A MM::Reflection::Variable that holds the specific
+   * property.
+   */
+  Variable GetPropertyVariable(NameId property_name);
+
+  /**
+   * \brief Gets the properties of the object held by this object.
+   * \param property_name The interned name of property.
+   * \return A MM::Reflection::Variable that holds the specific
+   * property.
+   */
+  Variable GetPropertyVariable(NameId property_name) const;
+
+  /**
+   * \brief Invoke the function with 0 arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function. \remark If the number or type of incoming
+   * argument is different from the argument required by the function
+   * held by this object or the target method not exist, the function
+   * held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(NameId method_name);
+
+  /**
+   * \brief Invoke the function with 0 arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \param arg1 1st argument.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function. \remark If the number or type of incoming
+   * argument is different from the argument required by the function
+   * held by this object or the target method not exist, the function
+   * held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(NameId method_name, Variable& arg1);
+
+  /**
+   * \brief Invoke the function with 0 arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \param arg1 1st argument.
+   * \param arg2 2ed argument.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function. \remark If the number or type of incoming
+   * argument is different from the argument required by the function
+   * held by this object or the target method not exist, the function
+   * held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(NameId method_name, Variable& arg1,
+                  Variable& arg2);
+
+  /**
+   * \brief Invoke the function with 0 arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \param arg1 1st argument.
+   * \param arg2 2ed argument.
+   * \param arg3 3rd argument.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function. \remark If the number or type of incoming
+   * argument is different from the argument required by the function
+   * held by this object or the target method not exist, the function
+   * held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(NameId method_name, Variable& arg1,
+                  Variable& arg2, Variable& arg3);
+
+  /**
+   * \brief Invoke the function with 0 arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \param arg1 1st argument.
+   * \param arg2 2ed argument.
+   * \param arg3 3rd argument.
+   * \param arg4 4th argument.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function. \remark If the number or type of incoming
+   * argument is different from the argument required by the function
+   * held by this object or the target method not exist, the function
+   * held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(NameId method_name, Variable& arg1,
+                  Variable& arg2, Variable& arg3, Variable& arg4);
+
+  /**
+   * \brief Invoke the function with 0 arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \param arg1 1st argument.
+   * \param arg2 2ed argument.
+   * \param arg3 3rd argument.
+   * \param arg4 4th argument.
+   * \param arg5 5th argument.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function. \remark If the number or type of incoming
+   * argument is different from the argument required by the function
+   * held by this object or the target method not exist, the function
+   * held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(NameId method_name, Variable& arg1,
+                  Variable& arg2, Variable& arg3, Variable& arg4,
+                  Variable& arg5);
+
+  /**
+   * \brief Invoke the function with 0 arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \param arg1 1st argument.
+   * \param arg2 2ed argument.
+   * \param arg3 3rd argument.
+   * \param arg4 4th argument.
+   * \param arg5 5th argument.
+   * \param arg6 6th argument.
+   * \return \ref MM::Refl::Variable containing the return value of this
+   * function.
+   * \remark If the number or type of incoming argument is different
+   * from the argument required by the function held by this object or
+   * the target method not exist, the function held by this object will
+   * not be called and return an empty \ref MM::Reflection::Variable.
+   */
+  Variable Invoke(NameId method_name, Variable& arg1,
+                  Variable& arg2, Variable& arg3, Variable& arg4,
+                  Variable& arg5, Variable& arg6);
+
+  /**
+   * \brief Invoke the function with 0 arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \param args Arguments.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function. \remark If the number or type of incoming
+   * argument is different from the argument required by the function
+   * held by this object or the target method not exist, the function
+   * held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(NameId method_name, std::vector<Variable*>& args);
+
+  /**
+   * \brief Invoke the function with 0 arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \param args Arguments.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function. \remark If the number or type of incoming
+   * argument is different from the argument required by the function
+   * held by this object or the target method not exist, the function
+   * held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(NameId method_name,
+                  std::vector<Variable*>&& args);
+
+  /**
+   * \brief Invoke the function with any number of arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \param args The address of the arguments.
+   * \param argument_number The number of arguments.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function. \remark If the number or type of incoming
+   * argument is different from the argument required by the function
+   * held by this object or the target method not exist, the function
+   * held by this object will not be called and return an empty \ref
+   * MM::Reflection::Variable.
+   */
+  Variable Invoke(NameId method_name, Variable* const* args,
+                  std::size_t argument_number);
+
+  /**
+   * \brief Invoke the function with any number of arguments.
+   * \param method_name The interned name of a method that you want call.
+   * \param args Arguments.
+   * \return \ref MM::Reflection::Variable containing the return value
+   * of this function.
+   * \remark The arguments are passed on the stack, no memory is allocated.
+   */
+  template <typename... Args, typename = std::enable_if_t<(std::is_same_v<Args, Variable> && ...)>>
+  Variable Invoke(NameId method_name, Args&... args) {
+    std::array<Variable*, sizeof...(Args)> arg_array{&args...};
+    return Invoke(method_name, arg_array.data(), sizeof...(Args));
+  }
+
   /**
    * \brief Returns a pointer to the managed object and releases the
    * ownership. \return The pointer to the managed object.
@@ -1108,12 +1368,16 @@ public:
       bool compatible_pointer_refrence) const;
 
  public:
-  // The wrapper object is an object of 8 bytes or less, plus a virtual
-  // function table pointer, resulting in a size of 16 bytes. To erase
-  // type information, use this structure instead.
+  // The wrapper object is an object of MM_REFLECTION_VARIABLE_INLINE_SIZE
+  // bytes or less, plus a virtual function table pointer (16 bytes by
+  // default). To erase type information, use this structure instead.
   struct WrapperObject {
-    void* ptr1{nullptr};
-    void* ptr2{nullptr};
+    static_assert(MM_REFLECTION_VARIABLE_INLINE_SIZE > 0 &&
+                      MM_REFLECTION_VARIABLE_INLINE_SIZE % sizeof(void*) == 0,
+                  "MM_REFLECTION_VARIABLE_INLINE_SIZE must be a non-zero "
+                  "multiple of sizeof(void*).");
+
+    void* ptrs_[1 + MM_REFLECTION_VARIABLE_INLINE_SIZE / sizeof(void*)]{};
 
     const VariableWrapperBase* GetWrpperBasePtr() const;
 
@@ -1136,6 +1400,44 @@ public:
 
   VariableWrapperBase* GetWrapperBasePtr();
 
+  /**
+   * \brief Construct a \ref WrapperType that does not fit in the inline
+   * buffer.
+   * \remark The memory comes from the \ref VariableArena of the current
+   * thread if there is one, otherwise from operator new.
+   */
+  template <typename WrapperType, typename... Args>
+  void CreateHeapWrapper(Args&&... args) {
+    VariableArena* arena = VariableArena::GetCurrentArena();
+    if (arena != nullptr) {
+      void* address = arena->Allocate(sizeof(WrapperType), alignof(WrapperType));
+      wrapper_.placement_wrapper_ =
+          new (address) WrapperType{std::forward<Args>(args)...};
+      variable_type_ = VariableType::PLACMENT_OBJECT;
+      return;
+    }
+
+    wrapper_.common_wrapper_ = new WrapperType{std::forward<Args>(args)...};
+    variable_type_ = VariableType::COMMON_OBJECT;
+  }
+
+  /**
+   * \brief Copy the value held by \ref other_wrapper_base_ptr to a wrapper
+   * that does not fit in the inline buffer.
+   * \remark Like \ref CreateHeapWrapper, it uses the \ref VariableArena of the
+   * current thread if there is one.
+   */
+  void CopyToHeapWrapper(const VariableWrapperBase* other_wrapper_base_ptr);
+
+  /**
+   * \brief Move the value held by \ref other_wrapper_base_ptr to a wrapper
+   * that does not fit in the inline buffer, like \ref CopyToHeapWrapper.
+   * \remark It is used to move a \ref VariableType::PLACMENT_OBJECT, whose
+   * wrapper lives in storage (a \ref VariableArena or a caller buffer) that
+   * may be reused before the moved-to variable is destroyed.
+   */
+  void MoveToHeapWrapper(VariableWrapperBase* other_wrapper_base_ptr);
+
  private:
   static Type EmptyType;
 
@@ -1145,6 +1447,9 @@ public:
     VariableWrapperBase* placement_wrapper_;
   } wrapper_{};
   VariableType variable_type_{VariableType::INVALID};
+  // The inline wrapper can be copied, moved and destroyed bytewise (the value
+  // is trivially copyable or a refrence). It is always false for other kinds.
+  bool is_trivially_relocatable_{false};
 };
 
 // The size of the variable wrapper is the size of the original type
@@ -0,0 +1,103 @@
+#include "variable_arena.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+thread_local MM::Reflection::VariableArena* g_current_arena = nullptr;
+
+std::uintptr_t AlignUp(std::uintptr_t address, std::size_t alignment) {
+  return (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+}
+}  // namespace
+
+MM::Reflection::VariableArena::VariableArena(std::size_t block_size)
+    : block_size_(block_size == 0 ? DEFAULT_BLOCK_SIZE : block_size) {}
+
+MM::Reflection::VariableArena::~VariableArena() {
+  assert(g_current_arena != this);
+}
+
+MM::Reflection::VariableArena* MM::Reflection::VariableArena::GetCurrentArena() {
+  return g_current_arena;
+}
+
+void* MM::Reflection::VariableArena::Allocate(std::size_t size,
+                                              std::size_t alignment) {
+  assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+  const std::uintptr_t address = AlignUp(current_, alignment);
+  if (current_ != 0 && address + size <= end_) {
+    current_ = address + size;
+    used_size_ += size;
+    return reinterpret_cast<void*>(address);
+  }
+
+  return AllocateFromNewBlock(size, alignment);
+}
+
+void MM::Reflection::VariableArena::Reset() {
+  current_block_index_ = 0;
+  used_size_ = 0;
+  if (blocks_.empty()) {
+    current_ = 0;
+    end_ = 0;
+    return;
+  }
+
+  current_ = reinterpret_cast<std::uintptr_t>(blocks_[0].data_.get());
+  end_ = current_ + blocks_[0].size_;
+}
+
+std::size_t MM::Reflection::VariableArena::GetUsedSize() const {
+  return used_size_;
+}
+
+std::size_t MM::Reflection::VariableArena::GetCapacity() const {
+  std::size_t capacity = 0;
+  for (const Block& block : blocks_) {
+    capacity += block.size_;
+  }
+
+  return capacity;
+}
+
+void* MM::Reflection::VariableArena::AllocateFromNewBlock(
+    std::size_t size, std::size_t alignment) {
+  const std::size_t required_size = size + alignment - 1;
+
+  // Reuse the blocks kept by Reset first.
+  std::size_t block_index = blocks_.empty() ? 0 : current_block_index_ + 1;
+  while (block_index < blocks_.size() &&
+         blocks_[block_index].size_ < required_size) {
+    ++block_index;
+  }
+  if (block_index == blocks_.size()) {
+    Block block{};
+    block.size_ = std::max(block_size_, required_size);
+    block.data_.reset(new std::byte[block.size_]);
+    blocks_.emplace_back(std::move(block));
+  }
+
+  current_block_index_ = block_index;
+  current_ = reinterpret_cast<std::uintptr_t>(blocks_[block_index].data_.get());
+  end_ = current_ + blocks_[block_index].size_;
+
+  const std::uintptr_t address = AlignUp(current_, alignment);
+  current_ = address + size;
+  used_size_ += size;
+  return reinterpret_cast<void*>(address);
+}
+
+MM::Reflection::VariableArenaScope::VariableArenaScope()
+    : previous_arena_(g_current_arena) {
+  g_current_arena = nullptr;
+}
+
+MM::Reflection::VariableArenaScope::VariableArenaScope(VariableArena& arena)
+    : previous_arena_(g_current_arena) {
+  g_current_arena = &arena;
+}
+
+MM::Reflection::VariableArenaScope::~VariableArenaScope() {
+  g_current_arena = previous_arena_;
+}
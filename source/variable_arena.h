@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace MM {
+namespace Reflection {
+/**
+ * \brief A bump allocator that backs the heap storage of
+ * \ref MM::Reflection::Variable.
+ * \remark While a \ref VariableArenaScope of this arena is alive on a thread,
+ * every \ref MM::Reflection::Variable created on that thread whose value does
+ * not fit in the inline buffer takes its memory from this arena instead of the
+ * global operator new. Destroying such a \ref MM::Reflection::Variable only
+ * runs the destructor of the value, and the memory is returned all at once by
+ * \ref Reset or by the destructor of the arena.
+ * \remark Every \ref MM::Reflection::Variable that uses the memory of the arena
+ * must be destroyed before the arena is reset or destroyed.
+ * \remark It is not thread-safe. Use one arena per thread.
+ */
+class VariableArena {
+ public:
+  static constexpr std::size_t DEFAULT_BLOCK_SIZE = 4096;
+
+ public:
+  /**
+   * \param block_size The size of each block. Allocations larger than it get
+   * a block of their own.
+   */
+  explicit VariableArena(std::size_t block_size = DEFAULT_BLOCK_SIZE);
+  ~VariableArena();
+  VariableArena(const VariableArena& other) = delete;
+  VariableArena(VariableArena&& other) = delete;
+  VariableArena& operator=(const VariableArena& other) = delete;
+  VariableArena& operator=(VariableArena&& other) = delete;
+
+ public:
+  /**
+   * \brief Get the arena that the current thread allocates from.
+   * \return Returns nullptr if no \ref VariableArenaScope is alive on the
+   * current thread.
+   */
+  static VariableArena* GetCurrentArena();
+
+  /**
+   * \brief Allocate \ref size bytes aligned to \ref alignment.
+   * \param alignment It must be a power of two.
+   * \return The address of the memory. It is never nullptr.
+   */
+  void* Allocate(std::size_t size, std::size_t alignment);
+
+  /**
+   * \brief Release all memory allocated from this arena in one shot.
+   * \remark The blocks are kept and reused by later allocations.
+   */
+  void Reset();
+
+  /**
+   * \brief Get the number of bytes handed out since the last \ref Reset.
+   */
+  std::size_t GetUsedSize() const;
+
+  /**
+   * \brief Get the total size of all blocks owned by this arena.
+   */
+  std::size_t GetCapacity() const;
+
+ private:
+  struct Block {
+    std::unique_ptr<std::byte[]> data_{};
+    std::size_t size_{0};
+  };
+
+ private:
+  void* AllocateFromNewBlock(std::size_t size, std::size_t alignment);
+
+ private:
+  std::size_t block_size_;
+  std::vector<Block> blocks_{};
+  std::size_t current_block_index_{0};
+  std::uintptr_t current_{0};
+  std::uintptr_t end_{0};
+  std::size_t used_size_{0};
+};
+
+/**
+ * \brief Make \ref VariableArena the arena of the current thread until this
+ * object is destroyed.
+ * \remark Scopes can be nested, the previous arena is restored on destruction.
+ */
+class VariableArenaScope {
+ public:
+  /**
+   * \brief Make the current thread use no arena until this object is
+   * destroyed.
+   */
+  VariableArenaScope();
+  explicit VariableArenaScope(VariableArena& arena);
+  ~VariableArenaScope();
+  VariableArenaScope(const VariableArenaScope& other) = delete;
+  VariableArenaScope(VariableArenaScope&& other) = delete;
+  VariableArenaScope& operator=(const VariableArenaScope& other) = delete;
+  VariableArenaScope& operator=(VariableArenaScope&& other) = delete;
+
+ private:
+  VariableArena* previous_arena_;
+};
+}  // namespace Reflection
+}  // namespace MM
@@ -187,11 +187,11 @@ TEST(reflection, constructor) {
   EXPECT_EQ(default_constructor->IsValid(), true);
   Variable default_variable = default_constructor->Invoke();
   EXPECT_EQ(default_variable.IsValid(), true);
-  EXPECT_EQ(default_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+  EXPECT_EQ(default_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
   EXPECT_EQ(default_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
   {
     Variable placement_default_variable = default_constructor->Invoke(placement_address0);
-    EXPECT_EQ(placement_default_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+    EXPECT_EQ(placement_default_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
     EXPECT_EQ(placement_default_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
     EXPECT_EQ(placement_default_variable.GetValue(), reinterpret_cast<void*>(reinterpret_cast<std::uint64_t>(placement_address0) + sizeof(void*)));
   }
@@ -202,12 +202,12 @@ TEST(reflection, constructor) {
   EXPECT_EQ(init1_constructor->IsValid(), true);
   Variable init1_variable = init1_constructor->Invoke(arg1);
   EXPECT_EQ(init1_variable.IsValid(), true);
-  EXPECT_EQ(init1_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+  EXPECT_EQ(init1_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
   EXPECT_EQ(init1_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
   {
     Variable placement_init1_variable = init1_constructor->Invoke(placement_address1, arg1);
     EXPECT_EQ(placement_init1_variable.IsValid(), true);
-    EXPECT_EQ(placement_init1_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+    EXPECT_EQ(placement_init1_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
     EXPECT_EQ(placement_init1_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
     EXPECT_EQ(placement_init1_variable.GetValue(), reinterpret_cast<void*>(reinterpret_cast<std::uint64_t>(placement_address1) + sizeof(void*)));
   }
@@ -218,12 +218,12 @@ TEST(reflection, constructor) {
   EXPECT_EQ(init2_constructor->IsValid(), true);
   Variable init2_variable = init2_constructor->Invoke(arg1, arg2);
   EXPECT_EQ(init2_variable.IsValid(), true);
-  EXPECT_EQ(init2_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+  EXPECT_EQ(init2_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
   EXPECT_EQ(init2_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
   {
     Variable placement_init2_variable = init2_constructor->Invoke(placement_address2, arg1, arg2);
     EXPECT_EQ(placement_init2_variable.IsValid(), true);
-    EXPECT_EQ(placement_init2_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+    EXPECT_EQ(placement_init2_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
     EXPECT_EQ(placement_init2_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
     EXPECT_EQ(placement_init2_variable.GetValue(), reinterpret_cast<void*>(reinterpret_cast<std::uint64_t>(placement_address2) + sizeof(void*)));
   }
@@ -234,12 +234,12 @@ TEST(reflection, constructor) {
   EXPECT_EQ(init3_constructor->IsValid(), true);
   Variable init3_variable = init3_constructor->Invoke(arg1, arg2, arg3);
   EXPECT_EQ(init3_variable.IsValid(), true);
-  EXPECT_EQ(init3_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+  EXPECT_EQ(init3_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
   EXPECT_EQ(init3_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
   {
     Variable placement_init3_variable = init3_constructor->Invoke(placement_address3, arg1, arg2, arg3);
     EXPECT_EQ(placement_init3_variable.IsValid(), true);
-    EXPECT_EQ(placement_init3_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+    EXPECT_EQ(placement_init3_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
     EXPECT_EQ(placement_init3_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
     EXPECT_EQ(placement_init3_variable.GetValue(), reinterpret_cast<void*>(reinterpret_cast<std::uint64_t>(placement_address3) + sizeof(void*)));
   }
@@ -250,12 +250,12 @@ TEST(reflection, constructor) {
   EXPECT_EQ(init4_constructor->IsValid(), true);
   Variable init4_variable = init4_constructor->Invoke(arg1, arg2, arg3, arg4);
   EXPECT_EQ(init4_variable.IsValid(), true);
-  EXPECT_EQ(init4_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+  EXPECT_EQ(init4_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
   EXPECT_EQ(init4_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
   {
     Variable placement_init4_variable = init4_constructor->Invoke(placement_address4, arg1, arg2, arg3, arg4);
     EXPECT_EQ(placement_init4_variable.IsValid(), true);
-    EXPECT_EQ(placement_init4_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+    EXPECT_EQ(placement_init4_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
     EXPECT_EQ(placement_init4_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
     EXPECT_EQ(placement_init4_variable.GetValue(), reinterpret_cast<void*>(reinterpret_cast<std::uint64_t>(placement_address4) + sizeof(void*)));
   }
@@ -266,12 +266,12 @@ TEST(reflection, constructor) {
   EXPECT_EQ(init5_constructor->IsValid(), true);
   Variable init5_variable = init5_constructor->Invoke(arg1, arg2, arg3, arg4, arg5);
   EXPECT_EQ(init5_variable.IsValid(), true);
-  EXPECT_EQ(init5_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+  EXPECT_EQ(init5_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
   EXPECT_EQ(init5_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
   {
     Variable placement_init5_variable = init5_constructor->Invoke(placement_address5, arg1, arg2, arg3, arg4, arg5);
     EXPECT_EQ(placement_init5_variable.IsValid(), true);
-    EXPECT_EQ(placement_init5_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+    EXPECT_EQ(placement_init5_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
     EXPECT_EQ(placement_init5_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
     EXPECT_EQ(placement_init5_variable.GetValue(), reinterpret_cast<void*>(reinterpret_cast<std::uint64_t>(placement_address5) + sizeof(void*)));
   }
@@ -282,12 +282,12 @@ TEST(reflection, constructor) {
   EXPECT_EQ(init6_constructor->IsValid(), true);
   Variable init6_variable = init6_constructor->Invoke(arg1, arg2, arg3, arg4, arg5, arg6);
   EXPECT_EQ(init6_variable.IsValid(), true);
-  EXPECT_EQ(init6_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+  EXPECT_EQ(init6_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
   EXPECT_EQ(init6_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
   {
     Variable placement_init6_variable = init6_constructor->Invoke(placement_address6, arg1, arg2, arg3, arg4, arg5, arg6);
     EXPECT_EQ(placement_init6_variable.IsValid(), true);
-    EXPECT_EQ(placement_init6_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+    EXPECT_EQ(placement_init6_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
     EXPECT_EQ(placement_init6_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
     EXPECT_EQ(placement_init6_variable.GetValue(), reinterpret_cast<void*>(reinterpret_cast<std::uint64_t>(placement_address6) + sizeof(void*)));
   }
@@ -299,12 +299,12 @@ TEST(reflection, constructor) {
   std::vector<Variable*> args{&arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7};
   Variable init7_variable = init7_constructor->Invoke(args);
   EXPECT_EQ(init7_variable.IsValid(), true);
-  EXPECT_EQ(init7_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+  EXPECT_EQ(init7_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
   EXPECT_EQ(init7_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
   {
     Variable placement_init7_variable = init7_constructor->Invoke(placement_address7, args);
     EXPECT_EQ(placement_init7_variable.IsValid(), true);
-    EXPECT_EQ(placement_init7_variable.GetType()->GetTypeHashCode(), typeid(ConstructorTestClass).hash_code());
+    EXPECT_EQ(placement_init7_variable.GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<ConstructorTestClass>());
     EXPECT_EQ(placement_init7_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
     EXPECT_EQ(placement_init7_variable.GetValue(), reinterpret_cast<void*>(reinterpret_cast<std::uint64_t>(placement_address7) + sizeof(void*)));
   }
@@ -318,3 +318,50 @@ TEST(reflection, constructor) {
   free(placement_address6);
   free(placement_address7);
 }
+
+TEST(reflection, constructor_variadic) {
+  const Meta* meta_data = Type::CreateType<ConstructorTestClass>().GetMeta();
+  EXPECT_NE(meta_data, nullptr);
+
+  Variable arg1 = Variable::CreateVariable(10),
+           arg2 = Variable::CreateVariable(11.0f),
+           arg3 = Variable::CreateVariable(12.0),
+           arg4 = Variable::CreateVariable(13),
+           arg5 = Variable::CreateVariable(14.0f),
+           arg6 = Variable::CreateVariable(15.0),
+           arg7 = Variable::EmplaceVariable<TestProperty>(16, 17.0f, 18.0);
+  Variable* args[] = {&arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7};
+  const Constructor* init7_constructor = meta_data->GetConstructor("Init7");
+  EXPECT_NE(init7_constructor, nullptr);
+  const ConstructorTestClass equal_variable = init7_constructor->Invoke(std::vector<Variable*>{args, args + 7}).GetValueCast<ConstructorTestClass>();
+  EXPECT_EQ(equal_variable.property1_, 10);
+  EXPECT_EQ(equal_variable.property6_, 15.0);
+
+  Variable variadic_variable = init7_constructor->Invoke(arg1, arg2, arg3, arg4, arg5, arg6, arg7);
+  EXPECT_EQ(variadic_variable.IsValid(), true);
+  EXPECT_EQ(variadic_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
+  Variable span_variable = init7_constructor->Invoke(args, 7);
+  EXPECT_EQ(span_variable.IsValid(), true);
+  EXPECT_EQ(span_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
+  EXPECT_EQ(init7_constructor->Invoke(args, 6).IsValid(), false);
+  EXPECT_EQ(init7_constructor->Invoke(arg1, arg2, arg3, arg4, arg5, arg6, arg6).IsValid(), false);
+
+  EXPECT_EQ(meta_data->CreateInstance("Init7", arg1, arg2, arg3, arg4, arg5, arg6, arg7).GetValueCast<ConstructorTestClass>(), equal_variable);
+  EXPECT_EQ(meta_data->CreateInstance("Init7", args, 7).GetValueCast<ConstructorTestClass>(), equal_variable);
+  EXPECT_EQ(meta_data->CreateInstance("InvalidConstructor", args, 7).IsValid(), false);
+
+  void *placement_address0 = malloc(GetVariableWrpperSize(sizeof(ConstructorTestClass))),
+       *placement_address1 = malloc(GetVariableWrpperSize(sizeof(ConstructorTestClass)));
+  {
+    Variable placement_variadic_variable = init7_constructor->Invoke(placement_address0, arg1, arg2, arg3, arg4, arg5, arg6, arg7);
+    EXPECT_EQ(placement_variadic_variable.IsValid(), true);
+    EXPECT_EQ(placement_variadic_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
+    EXPECT_EQ(placement_variadic_variable.GetValue(), reinterpret_cast<void*>(reinterpret_cast<std::uint64_t>(placement_address0) + sizeof(void*)));
+    Variable placement_span_variable = init7_constructor->Invoke(placement_address1, args, 7);
+    EXPECT_EQ(placement_span_variable.IsValid(), true);
+    EXPECT_EQ(placement_span_variable.GetValueCast<ConstructorTestClass>(), equal_variable);
+    EXPECT_EQ(placement_span_variable.GetValue(), reinterpret_cast<void*>(reinterpret_cast<std::uint64_t>(placement_address1) + sizeof(void*)));
+  }
+  free(placement_address0);
+  free(placement_address1);
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "reflection.h"
+
+using namespace MM::Reflection;
+
+struct DatabaseTestClass {
+  int property1_{10};
+  float property2_{20.0f};
+};
+
+struct DatabaseLateTestClass {
+  int property1_{30};
+};
+
+MM_REGISTER {
+  Class<DatabaseTestClass>{"DatabaseTestClass"}
+    .Property("property1_", &DatabaseTestClass::property1_)
+    .Property("property2_", &DatabaseTestClass::property2_);
+}
+
+// Unfreezes the registry at the end of a test, so that other tests do not
+// depend on the order they run in.
+struct FrozenRegistryScope {
+  FrozenRegistryScope() { FreezeRegistry(); }
+  ~FrozenRegistryScope() { UnfreezeRegistry(); }
+};
+
+TEST(reflection, database) {
+  const Type& int_type = Type::CreateType<int>();
+  EXPECT_EQ(IsRegistryFrozen(), false);
+  const FrozenRegistryScope frozen_registry_scope{};
+  EXPECT_EQ(IsRegistryFrozen(), true);
+
+  for (const auto& element : GetMetaDatabase()) {
+    EXPECT_EQ(FindMeta(element.first), element.second);
+  }
+  for (const auto& element : GetNameToTypeHashDatabase()) {
+    const TypeHashCode* type_hash_code = FindTypeHashCode(element.first);
+    EXPECT_NE(type_hash_code, nullptr);
+    EXPECT_EQ(*type_hash_code, element.second);
+  }
+  for (const auto& element : GetSerializerDatabase()) {
+    EXPECT_EQ(FindSerializer(element.first), element.second);
+  }
+  for (const auto& element : GetTypeDatabase().GetAllType()) {
+    EXPECT_EQ(FindType(element.first), element.second);
+  }
+
+  const TypeHashCode* database_test_hash_code = FindTypeHashCode("DatabaseTestClass");
+  EXPECT_NE(database_test_hash_code, nullptr);
+  EXPECT_EQ(*database_test_hash_code, MM::Utils::GetTypeHashCode<DatabaseTestClass>());
+  const Meta* database_test_meta = FindMeta(*database_test_hash_code);
+  EXPECT_NE(database_test_meta, nullptr);
+  EXPECT_EQ(database_test_meta, Type::CreateType<DatabaseTestClass>().GetMeta());
+  EXPECT_EQ(database_test_meta->HaveProperty("property2_"), true);
+  EXPECT_EQ(&Type::CreateType<int>(), &int_type);
+  EXPECT_EQ(FindType(int_type.GetTypeID()), &int_type);
+
+  EXPECT_EQ(FindTypeHashCode("DatabaseInvalidClass"), nullptr);
+  EXPECT_EQ(FindMeta(0), nullptr);
+  EXPECT_EQ(FindSerializer("InvalidSerializer"), nullptr);
+
+  // Registration after freezing is still visible.
+  EXPECT_EQ(Type::CreateType<DatabaseLateTestClass>().IsRegistered(), false);
+  Class<DatabaseLateTestClass>{"DatabaseLateTestClass"}
+    .Property("property1_", &DatabaseLateTestClass::property1_);
+  const TypeHashCode* late_hash_code = FindTypeHashCode("DatabaseLateTestClass");
+  EXPECT_NE(late_hash_code, nullptr);
+  EXPECT_EQ(*late_hash_code, MM::Utils::GetTypeHashCode<DatabaseLateTestClass>());
+  EXPECT_EQ(Type::CreateType<DatabaseLateTestClass>().IsRegistered(), true);
+  EXPECT_NE(Type::CreateType<DatabaseLateTestClass>().GetMeta(), nullptr);
+  EXPECT_EQ(Type::CreateType<DatabaseLateTestClass>().GetMeta()->HaveProperty("property1_"), true);
+}
+
+TEST(reflection, database_frozen_concurrent) {
+  // Lookups keep finding the registered types while late registrations
+  // replace the frozen tables.
+  const FrozenRegistryScope frozen_registry_scope{};
+  const TypeHashCode database_test_hash_code = MM::Utils::GetTypeHashCode<DatabaseTestClass>();
+  std::atomic<bool> is_done{false};
+  std::atomic<bool> is_found{true};
+  std::thread reader{[&is_done, &is_found, database_test_hash_code]() {
+    while (!is_done) {
+      const TypeHashCode* type_hash_code = FindTypeHashCode("DatabaseTestClass");
+      if (FindMeta(database_test_hash_code) == nullptr || type_hash_code == nullptr ||
+          *type_hash_code != database_test_hash_code) {
+        is_found = false;
+      }
+    }
+  }};
+  for (std::size_t index = 0; index != 100; ++index) {
+    FreezeRegistry();
+  }
+  is_done = true;
+  reader.join();
+  EXPECT_EQ(is_found, true);
+}
+
+template<std::size_t Index>
+struct ConcurrentTypeTestClass {
+  int property1_{static_cast<int>(Index)};
+};
+
+template<std::size_t ...Indexes>
+std::vector<const Type*> CreateConcurrentTypes(std::index_sequence<Indexes...>) {
+  return std::vector<const Type*>{&Type::CreateType<ConcurrentTypeTestClass<Indexes>>()...,
+                                  &Type::CreateType<const ConcurrentTypeTestClass<Indexes>&>()...};
+}
+
+TEST(reflection, type_database_concurrent) {
+  constexpr std::size_t thread_number = 8;
+  std::vector<std::vector<const Type*>> thread_types(thread_number);
+  std::vector<std::thread> threads{};
+  for (std::size_t thread_index = 0; thread_index != thread_number; ++thread_index) {
+    threads.emplace_back([&thread_types, thread_index]() {
+      thread_types[thread_index] = CreateConcurrentTypes(std::make_index_sequence<200>{});
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const std::vector<const Type*> types = CreateConcurrentTypes(std::make_index_sequence<200>{});
+  for (const auto& thread_type : thread_types) {
+    EXPECT_EQ(thread_type, types);
+  }
+  for (std::size_t index = 0; index != 200; ++index) {
+    EXPECT_NE(types[index], types[index + 200]);
+    EXPECT_EQ(types[index]->GetTypeHashCode(), types[index + 200]->GetTypeHashCode());
+    EXPECT_EQ(types[index + 200]->IsReference(), true);
+    EXPECT_EQ(&types[index + 200]->GetOrignalType(), types[index]);
+  }
+
+  // Insert overlapping ids from every thread and force the table to grow many
+  // times while other threads are reading.
+  TypeDatabase type_database{};
+  constexpr std::size_t type_number = 20000;
+  std::vector<std::vector<Type>> thread_storages(thread_number);
+  std::vector<std::vector<const Type*>> inserted_types(thread_number, std::vector<const Type*>(type_number));
+  threads.clear();
+  for (std::size_t thread_index = 0; thread_index != thread_number; ++thread_index) {
+    thread_storages[thread_index].resize(type_number);
+    threads.emplace_back([&type_database, &thread_storages, &inserted_types, thread_index]() {
+      for (std::size_t index = 0; index != type_number; ++index) {
+        const std::size_t type_index = (index + thread_index * 997) % type_number;
+        const TypeID type_id{type_index + 1, false, false, (type_index & 1) != 0, false};
+        const Type* type = type_database.Find(type_id);
+        if (type == nullptr) {
+          type = type_database.Insert(type_id, &thread_storages[thread_index][type_index]);
+        }
+        inserted_types[thread_index][type_index] = type;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(type_database.GetSize(), type_number);
+  for (std::size_t index = 0; index != type_number; ++index) {
+    const TypeID type_id{index + 1, false, false, (index & 1) != 0, false};
+    EXPECT_EQ(type_database.Find(type_id), inserted_types[0][index]);
+    for (std::size_t thread_index = 1; thread_index != thread_number; ++thread_index) {
+      EXPECT_EQ(inserted_types[thread_index][index], inserted_types[0][index]);
+    }
+  }
+}
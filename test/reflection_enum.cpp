@@ -14,7 +14,7 @@ MM_REGISTER {
 }
 
 TEST(reflection, enum_test) {
-  const Meta* enum_meta = GetMetaDatabase().at(typeid(TestEnum).hash_code());
+  const Meta* enum_meta = GetMetaDatabase().at(MM::Utils::GetTypeHashCode<TestEnum>());
 
   EXPECT_EQ(enum_meta->GetAllConstructor().size(), 1);
   EXPECT_EQ(enum_meta->GetAllMethod().size(), 1);
@@ -11,7 +11,7 @@ TEST(reflection, meta) {
 
   EXPECT_NE(name_to_ID_database.find("void"), name_to_ID_database.end());
   const TypeHashCode void_hash_code = name_to_ID_database.at("void");
-  EXPECT_EQ(void_hash_code, typeid(void).hash_code());
+  EXPECT_EQ(void_hash_code, MM::Utils::GetTypeHashCode<void>());
   EXPECT_NE(meta_database.find(void_hash_code), meta_database.end());
   Meta* void_meta = meta_database.at(void_hash_code);
   EXPECT_EQ(void_meta->GetEmptyVariable().IsValid(), false);
@@ -20,7 +20,7 @@ TEST(reflection, meta) {
 
   EXPECT_NE(name_to_ID_database.find("char"), name_to_ID_database.end());
   const TypeHashCode char_hash_code = name_to_ID_database.at("char");
-  EXPECT_EQ(char_hash_code, typeid(char).hash_code());
+  EXPECT_EQ(char_hash_code, MM::Utils::GetTypeHashCode<char>());
   EXPECT_NE(meta_database.find(char_hash_code), meta_database.end());
   Meta* char_meta = meta_database.at(char_hash_code);
   const Constructor* char_empty_constructor = char_meta->GetConstructor("Empty");
@@ -53,7 +53,7 @@ TEST(reflection, meta) {
 
   EXPECT_NE(name_to_ID_database.find("std::uint16_t"), name_to_ID_database.end());
   const TypeHashCode uint16_t_hash_code = name_to_ID_database.at("std::uint16_t");
-  EXPECT_EQ(uint16_t_hash_code, typeid(std::uint16_t).hash_code());
+  EXPECT_EQ(uint16_t_hash_code, MM::Utils::GetTypeHashCode<std::uint16_t>());
   EXPECT_NE(meta_database.find(uint16_t_hash_code), meta_database.end());
   Meta* uint16_t_meta = meta_database.at(uint16_t_hash_code);
   const Constructor* uint16_t_empty_constructor = uint16_t_meta->GetConstructor("Empty");
@@ -86,7 +86,7 @@ TEST(reflection, meta) {
 
   EXPECT_NE(name_to_ID_database.find("std::uint32_t"), name_to_ID_database.end());
   const TypeHashCode uint32_t_hash_code = name_to_ID_database.at("std::uint32_t");
-  EXPECT_EQ(uint32_t_hash_code, typeid(std::uint32_t).hash_code());
+  EXPECT_EQ(uint32_t_hash_code, MM::Utils::GetTypeHashCode<std::uint32_t>());
   EXPECT_NE(meta_database.find(uint32_t_hash_code), meta_database.end());
   Meta* uint32_t_meta = meta_database.at(uint32_t_hash_code);
   const Constructor* uint32_t_empty_constructor = uint32_t_meta->GetConstructor("Empty");
@@ -119,7 +119,7 @@ TEST(reflection, meta) {
 
   EXPECT_NE(name_to_ID_database.find("std::uint64_t"), name_to_ID_database.end());
   const TypeHashCode uint64_t_hash_code = name_to_ID_database.at("std::uint64_t");
-  EXPECT_EQ(uint64_t_hash_code, typeid(std::uint64_t).hash_code());
+  EXPECT_EQ(uint64_t_hash_code, MM::Utils::GetTypeHashCode<std::uint64_t>());
   EXPECT_NE(meta_database.find(uint64_t_hash_code), meta_database.end());
   Meta* uint64_t_meta = meta_database.at(uint64_t_hash_code);
   const Constructor* uint64_t_empty_constructor = uint64_t_meta->GetConstructor("Empty");
@@ -152,7 +152,7 @@ TEST(reflection, meta) {
 
   EXPECT_NE(name_to_ID_database.find("std::int8_t"), name_to_ID_database.end());
   const TypeHashCode int8_t_hash_code = name_to_ID_database.at("std::int8_t");
-  EXPECT_EQ(int8_t_hash_code, typeid(std::int8_t).hash_code());
+  EXPECT_EQ(int8_t_hash_code, MM::Utils::GetTypeHashCode<std::int8_t>());
   EXPECT_NE(meta_database.find(int8_t_hash_code), meta_database.end());
   Meta* int8_t_meta = meta_database.at(int8_t_hash_code);
   const Constructor* int8_t_empty_constructor = int8_t_meta->GetConstructor("Empty");
@@ -185,7 +185,7 @@ TEST(reflection, meta) {
 
   EXPECT_NE(name_to_ID_database.find("std::int16_t"), name_to_ID_database.end());
   const TypeHashCode int16_t_hash_code = name_to_ID_database.at("std::int16_t");
-  EXPECT_EQ(int16_t_hash_code, typeid(std::int16_t).hash_code());
+  EXPECT_EQ(int16_t_hash_code, MM::Utils::GetTypeHashCode<std::int16_t>());
   EXPECT_NE(meta_database.find(int16_t_hash_code), meta_database.end());
   Meta* int16_t_meta = meta_database.at(int16_t_hash_code);
   const Constructor* int16_t_empty_constructor = int16_t_meta->GetConstructor("Empty");
@@ -218,7 +218,7 @@ TEST(reflection, meta) {
 
   EXPECT_NE(name_to_ID_database.find("std::int32_t"), name_to_ID_database.end());
   const TypeHashCode int32_t_hash_code = name_to_ID_database.at("std::int32_t");
-  EXPECT_EQ(int32_t_hash_code, typeid(std::int32_t).hash_code());
+  EXPECT_EQ(int32_t_hash_code, MM::Utils::GetTypeHashCode<std::int32_t>());
   EXPECT_NE(meta_database.find(int32_t_hash_code), meta_database.end());
   Meta* int32_t_meta = meta_database.at(int32_t_hash_code);
   const Constructor* int32_t_empty_constructor = int32_t_meta->GetConstructor("Empty");
@@ -251,7 +251,7 @@ TEST(reflection, meta) {
 
   EXPECT_NE(name_to_ID_database.find("std::int64_t"), name_to_ID_database.end());
   const TypeHashCode int64_t_hash_code = name_to_ID_database.at("std::int64_t");
-  EXPECT_EQ(int64_t_hash_code, typeid(std::int64_t).hash_code());
+  EXPECT_EQ(int64_t_hash_code, MM::Utils::GetTypeHashCode<std::int64_t>());
   EXPECT_NE(meta_database.find(int64_t_hash_code), meta_database.end());
   Meta* int64_t_meta = meta_database.at(int64_t_hash_code);
   const Constructor* int64_t_empty_constructor = int64_t_meta->GetConstructor("Empty");
@@ -282,7 +282,7 @@ TEST(reflection, meta) {
   EXPECT_EQ(int64_t_registered_empty_variable_const_refrence.GetType()->IsConst(), true);
   EXPECT_EQ(int64_t_registered_empty_variable_const_refrence.GetType()->IsReference(), true);
 
-  EXPECT_NE(GetMetaDatabase().find(typeid(float).hash_code()), GetMetaDatabase().end());
-  EXPECT_NE(GetMetaDatabase().find(typeid(double).hash_code()), GetMetaDatabase().end());
-  EXPECT_NE(GetMetaDatabase().find(typeid(std::string).hash_code()), GetMetaDatabase().end());
+  EXPECT_NE(GetMetaDatabase().find(MM::Utils::GetTypeHashCode<float>()), GetMetaDatabase().end());
+  EXPECT_NE(GetMetaDatabase().find(MM::Utils::GetTypeHashCode<double>()), GetMetaDatabase().end());
+  EXPECT_NE(GetMetaDatabase().find(MM::Utils::GetTypeHashCode<std::string>()), GetMetaDatabase().end());
 }
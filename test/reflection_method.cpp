@@ -349,7 +349,15 @@ private:
   std::string string_data{"data"};
 };
 
+struct MethodHolderTestClass {
+  int& GetValue() { return value_; }
+
+  int value_{0};
+};
+
 MM_REGISTER {
+  Class<MethodHolderTestClass>("MethodHolderTestClass")
+    .Method("GetValue", &MethodHolderTestClass::GetValue);
   Class<MethodTestClass>("MethodTestClass")
     .Method("Function0", &MethodTestClass::Function0)
     .Method("CFunction0", &MethodTestClass::CFunction0)
@@ -409,7 +417,7 @@ TEST(reflection, method) {
   Variable variable10{Variable::EmplaceVariable<std::string>("11")};
 
 
-  const Meta* method_test_meta = GetMetaDatabase().at(typeid(MethodTestClass).hash_code());
+  const Meta* method_test_meta = GetMetaDatabase().at(MM::Utils::GetTypeHashCode<MethodTestClass>());
   EXPECT_EQ(method_test_meta->HaveMethod("FunTest1"), false);
   EXPECT_EQ(method_test_meta->GetMethod("FunTest2"), nullptr);
   EXPECT_EQ(method_test_meta->HaveMethod("Function0"), true);
@@ -592,3 +600,179 @@ TEST(reflection, method) {
   EXPECT_EQ(string_refrence.GetValue(), &(static_cast<MethodTestClass*>(method_variable.GetValue())->GetStringData()));
 }
 
+
+TEST(reflection, method_handle) {
+  Variable empty_variable{};
+  Variable method_variable{Variable::EmplaceVariable<MethodTestClass>()};
+
+  std::uint64_t static_variable3 = 4;
+  std::int8_t static_variable4 = 5;
+  std::int16_t static_variable5 = 6;
+  std::int32_t static_variable6 = 7;
+  Variable variable0{Variable::EmplaceVariable<char>(1)};
+  Variable variable1{Variable::EmplaceVariable<std::uint16_t>(2)};
+  Variable variable2{Variable::EmplaceVariable<std::uint32_t>(3)};
+  Variable variable3{Variable::EmplaceVariable<const std::uint64_t* const>(&static_variable3)};
+  Variable variable4{Variable::EmplaceVariable<const std::int8_t*>(&static_variable4)};
+  Variable variable5{Variable::EmplaceVariable<std::int16_t* const>(&static_variable5)};
+  Variable variable6{Variable::EmplaceVariable<std::int32_t*>(&static_variable6)};
+  Variable variable7{Variable::EmplaceVariable<std::int64_t>(8)};
+  Variable variable8{Variable::EmplaceVariable<float>(9.0f)};
+  Variable variable9{Variable::EmplaceVariable<double>(10.0)};
+  Variable variable10{Variable::EmplaceVariable<std::string>("11")};
+
+  const Meta* method_test_meta = Type::CreateType<MethodTestClass>().GetMeta();
+  EXPECT_NE(method_test_meta, nullptr);
+  EXPECT_EQ(Method{}.Bind().IsValid(), false);
+  EXPECT_EQ(MethodHandle{}.Invoke(method_variable).IsValid(), false);
+
+  MethodHandle function1 = method_test_meta->GetMethod("Function1")->Bind();
+  MethodHandle cfunction1 = method_test_meta->GetMethod("CFunction1")->Bind();
+  MethodHandle sfunction1 = method_test_meta->GetMethod("SFunction1")->Bind();
+  EXPECT_EQ(function1.IsValid(), true);
+  EXPECT_EQ(function1.IsStatic(), false);
+  EXPECT_EQ(sfunction1.IsStatic(), true);
+  EXPECT_EQ(function1.GetArgumentNumber(), 2);
+  EXPECT_EQ(*static_cast<std::uint16_t*>(function1.Invoke(method_variable, variable0, variable1).GetValue()), static_cast<std::uint16_t>(3.0));
+  EXPECT_EQ(*static_cast<std::uint16_t*>(cfunction1.Invoke(method_variable, variable0, variable1).GetValue()), static_cast<std::uint16_t>(4.0));
+  EXPECT_EQ(*static_cast<std::uint16_t*>(sfunction1.Invoke(empty_variable, variable0, variable1).GetValue()), static_cast<std::uint16_t>(5.0));
+  EXPECT_EQ(*static_cast<std::uint16_t*>(function1.InvokeUnchecked(method_variable, variable0, variable1).GetValue()), static_cast<std::uint16_t>(3.0));
+
+  // Wrong argument number, argument type or instance.
+  EXPECT_EQ(function1.Invoke(method_variable, variable0).IsValid(), false);
+  EXPECT_EQ(function1.Invoke(method_variable, variable1, variable0).IsValid(), false);
+  EXPECT_EQ(function1.Invoke(method_variable, variable0, empty_variable).IsValid(), false);
+  EXPECT_EQ(function1.Invoke(variable0, variable0, variable1).IsValid(), false);
+  EXPECT_EQ(function1.CheckArguments(empty_variable, nullptr, 2), false);
+
+  MethodHandle function10 = method_test_meta->GetMethod("Function10")->Bind();
+  Variable* args[] = {&variable0, &variable1, &variable2, &variable3, &variable4, &variable5, &variable6, &variable7, &variable8, &variable9, &variable10};
+  EXPECT_EQ(function10.CheckArguments(method_variable, args, 11), true);
+  Variable result_variable = function10.Invoke(method_variable, args, 11);
+  EXPECT_EQ(result_variable.IsValid(), true);
+  EXPECT_EQ(*static_cast<std::string*>(result_variable.GetValue()), std::string("30.0"));
+  EXPECT_EQ(*static_cast<std::string*>(function10.InvokeUnchecked(method_variable, args).GetValue()), std::string("30.0"));
+
+  EXPECT_EQ(method_test_meta->GetMethod("VoidFunction")->Bind().Invoke(method_variable).IsVoid(), true);
+}
+
+TEST(reflection, method_variadic) {
+  Variable empty_variable{};
+  Variable method_variable{Variable::EmplaceVariable<MethodTestClass>()};
+
+  std::uint64_t static_variable3 = 4;
+  std::int8_t static_variable4 = 5;
+  std::int16_t static_variable5 = 6;
+  std::int32_t static_variable6 = 7;
+  Variable variable0{Variable::EmplaceVariable<char>(1)};
+  Variable variable1{Variable::EmplaceVariable<std::uint16_t>(2)};
+  Variable variable2{Variable::EmplaceVariable<std::uint32_t>(3)};
+  Variable variable3{Variable::EmplaceVariable<const std::uint64_t* const>(&static_variable3)};
+  Variable variable4{Variable::EmplaceVariable<const std::int8_t*>(&static_variable4)};
+  Variable variable5{Variable::EmplaceVariable<std::int16_t* const>(&static_variable5)};
+  Variable variable6{Variable::EmplaceVariable<std::int32_t*>(&static_variable6)};
+  Variable variable7{Variable::EmplaceVariable<std::int64_t>(8)};
+  Variable variable8{Variable::EmplaceVariable<float>(9.0f)};
+  Variable variable9{Variable::EmplaceVariable<double>(10.0)};
+  Variable variable10{Variable::EmplaceVariable<std::string>("11")};
+  Variable* args[] = {&variable0, &variable1, &variable2, &variable3, &variable4, &variable5, &variable6, &variable7, &variable8, &variable9, &variable10};
+
+  const Meta* method_test_meta = Type::CreateType<MethodTestClass>().GetMeta();
+  const Method* function6 = method_test_meta->GetMethod("Function6");
+  const Method* sfunction8 = method_test_meta->GetMethod("SFunction8");
+  const Method* cfunction10 = method_test_meta->GetMethod("CFunction10");
+  EXPECT_EQ(*static_cast<std::int32_t*>(function6->Invoke(method_variable, variable0, variable1, variable2, variable3, variable4, variable5, variable6).GetValue()), static_cast<std::int32_t>(18.0));
+  EXPECT_EQ(*static_cast<float*>(sfunction8->Invoke(empty_variable, variable0, variable1, variable2, variable3, variable4, variable5, variable6, variable7, variable8).GetValue()), static_cast<float>(26.0));
+  EXPECT_EQ(*static_cast<std::string*>(cfunction10->Invoke(method_variable, variable0, variable1, variable2, variable3, variable4, variable5, variable6, variable7, variable8, variable9, variable10).GetValue()), std::string("31.0"));
+  EXPECT_EQ(*static_cast<std::int32_t*>(function6->Invoke(method_variable, args, 7).GetValue()), static_cast<std::int32_t>(18.0));
+  EXPECT_EQ(*static_cast<float*>(sfunction8->Invoke(empty_variable, args, 9).GetValue()), static_cast<float>(26.0));
+  EXPECT_EQ(*static_cast<std::string*>(cfunction10->Invoke(method_variable, args, 11).GetValue()), std::string("31.0"));
+  EXPECT_EQ(function6->Invoke(method_variable, args, 6).IsValid(), false);
+  EXPECT_EQ(function6->Invoke(method_variable, args + 1, 7).IsValid(), false);
+  EXPECT_EQ(function6->Invoke(empty_variable, args, 7).IsValid(), false);
+  EXPECT_EQ(method_test_meta->GetMethod("VoidFunction")->Invoke(method_variable, nullptr, 0).IsVoid(), true);
+
+  EXPECT_EQ(*static_cast<std::int32_t*>(method_variable.Invoke("Function6", variable0, variable1, variable2, variable3, variable4, variable5, variable6).GetValue()), static_cast<std::int32_t>(18.0));
+  EXPECT_EQ(*static_cast<std::string*>(method_variable.Invoke("Function10", args, 11).GetValue()), std::string("30.0"));
+  const NameId function10_name{"Function10"};
+  EXPECT_EQ(*static_cast<std::string*>(method_variable.Invoke(function10_name, variable0, variable1, variable2, variable3, variable4, variable5, variable6, variable7, variable8, variable9, variable10).GetValue()), std::string("30.0"));
+  EXPECT_EQ(*static_cast<std::string*>(method_variable.Invoke(function10_name, args, 11).GetValue()), std::string("30.0"));
+  EXPECT_EQ(method_variable.Invoke("InvalidFunction", args, 11).IsValid(), false);
+}
+
+TEST(reflection, method_invoke_into) {
+  Variable empty_variable{};
+  Variable method_variable{Variable::EmplaceVariable<MethodTestClass>()};
+  Variable variable0{Variable::EmplaceVariable<char>(1)};
+  Variable variable1{Variable::EmplaceVariable<std::uint16_t>(2)};
+
+  const Meta* method_test_meta = Type::CreateType<MethodTestClass>().GetMeta();
+  const Method* function1 = method_test_meta->GetMethod("Function1");
+  const Method* sfunction1 = method_test_meta->GetMethod("SFunction1");
+  const Method* get_string_data = method_test_meta->GetMethod("GetStringData");
+  const Method* void_function = method_test_meta->GetMethod("VoidFunction");
+
+  // An invalid output variable is replaced by the result.
+  Variable result{};
+  EXPECT_EQ(function1->InvokeInto(result, method_variable, variable0, variable1), true);
+  EXPECT_EQ(result.GetValueCast<std::uint16_t>(), static_cast<std::uint16_t>(3.0));
+  // A valid output variable of the same type is reused.
+  result.GetValueCast<std::uint16_t>() = 0;
+  const void* result_address = result.GetValue();
+  EXPECT_EQ(sfunction1->InvokeInto(result, empty_variable, variable0, variable1), true);
+  EXPECT_EQ(result.GetValue(), result_address);
+  EXPECT_EQ(result.GetValueCast<std::uint16_t>(), static_cast<std::uint16_t>(5.0));
+  // Wrong output type, wrong argument or wrong instance.
+  Variable float_result = Variable::CreateVariable(1.0f);
+  EXPECT_EQ(function1->InvokeInto(float_result, method_variable, variable0, variable1), false);
+  EXPECT_EQ(float_result.GetValueCast<float>(), 1.0f);
+  EXPECT_EQ(function1->InvokeInto(result, method_variable, variable1, variable0), false);
+  EXPECT_EQ(function1->InvokeInto(result, empty_variable, variable0, variable1), false);
+
+  Variable string_result = Variable::CreateVariable(std::string("old string"));
+  const void* string_result_address = string_result.GetValue();
+  EXPECT_EQ(get_string_data->InvokeInto(string_result, method_variable), true);
+  EXPECT_EQ(string_result.GetValue(), string_result_address);
+  EXPECT_EQ(string_result.GetValueCast<std::string>(), static_cast<MethodTestClass*>(method_variable.GetValue())->GetStringData());
+
+  Variable void_result{};
+  EXPECT_EQ(void_function->InvokeInto(void_result, method_variable), true);
+  EXPECT_EQ(void_result.IsVoid(), true);
+
+  // Construct the result in caller provided storage.
+  alignas(std::max_align_t) char storage[64];
+  EXPECT_EQ(function1->GetReturnWrapperSize(), GetVariableWrpperSize(sizeof(std::uint64_t)));
+  EXPECT_LE(get_string_data->GetReturnWrapperSize(), sizeof(storage));
+  EXPECT_EQ(void_function->GetReturnWrapperSize(), 0);
+  EXPECT_EQ(Method{}.GetReturnWrapperSize(), 0);
+  {
+    Variable placement_result = function1->InvokeInto(static_cast<void*>(storage), method_variable, variable0, variable1);
+    EXPECT_EQ(placement_result.IsValid(), true);
+    EXPECT_EQ(placement_result.GetValueCast<std::uint16_t>(), static_cast<std::uint16_t>(3.0));
+    EXPECT_EQ(placement_result.GetValue(), static_cast<void*>(storage + sizeof(void*)));
+  }
+  {
+    Variable placement_result = get_string_data->InvokeInto(static_cast<void*>(storage), method_variable);
+    EXPECT_EQ(placement_result.IsRefrenceVariable(), true);
+    EXPECT_EQ(placement_result.GetValue(), &(static_cast<MethodTestClass*>(method_variable.GetValue())->GetStringData()));
+  }
+  EXPECT_EQ(function1->InvokeInto(static_cast<void*>(storage), method_variable, variable0).IsValid(), false);
+
+  // A reference result is rebound, the object it referred to is not changed.
+  MethodHolderTestClass holder1{1}, holder2{2};
+  Variable holder1_variable = Variable::CreateVariable(holder1);
+  Variable holder2_variable = Variable::CreateVariable(holder2);
+  const Method* get_value = Type::CreateType<MethodHolderTestClass>().GetMeta()->GetMethod("GetValue");
+  Variable value_result{};
+  EXPECT_EQ(get_value->InvokeInto(value_result, holder1_variable), true);
+  EXPECT_EQ(value_result.GetValue(), &holder1.value_);
+  EXPECT_EQ(get_value->InvokeInto(value_result, holder2_variable), true);
+  EXPECT_EQ(value_result.GetValue(), &holder2.value_);
+  EXPECT_EQ(holder1.value_, 1);
+  EXPECT_EQ(holder2.value_, 2);
+  // An owned result still receives a copy of the value.
+  Variable owned_value_result = Variable::CreateVariable(5);
+  EXPECT_EQ(get_value->InvokeInto(owned_value_result, holder2_variable), true);
+  EXPECT_NE(owned_value_result.GetValue(), &holder2.value_);
+  EXPECT_EQ(owned_value_result.GetValueCast<int>(), 2);
+}
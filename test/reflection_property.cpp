@@ -23,7 +23,7 @@ MM_REGISTER {
 }
 
 TEST(reflection, property) {
-  const Meta* property_test_meta = GetMetaDatabase().at(typeid(PropertyTestClass).hash_code());
+  const Meta* property_test_meta = GetMetaDatabase().at(MM::Utils::GetTypeHashCode<PropertyTestClass>());
   EXPECT_NE(property_test_meta, nullptr);
   EXPECT_EQ(property_test_meta->GetAllProperty().size(), 3);
   EXPECT_EQ(property_test_meta->HaveProperty("falid_property"), false);
@@ -45,9 +45,9 @@ TEST(reflection, property) {
   EXPECT_EQ(property1->GetClassMeta(), property_test_meta);
   EXPECT_EQ(property2->GetClassMeta(), property_test_meta);
   EXPECT_EQ(property3->GetClassMeta(), property_test_meta);
-  EXPECT_EQ(property1->GetType()->GetTypeHashCode(), typeid(int).hash_code());
-  EXPECT_EQ(property2->GetType()->GetTypeHashCode(), typeid(float).hash_code());
-  EXPECT_EQ(property3->GetType()->GetTypeHashCode(), typeid(std::string).hash_code());
+  EXPECT_EQ(property1->GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<int>());
+  EXPECT_EQ(property2->GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<float>());
+  EXPECT_EQ(property3->GetType()->GetTypeHashCode(), MM::Utils::GetTypeHashCode<std::string>());
   EXPECT_EQ(property1->GetStaticPropertyAddress(), nullptr);
   EXPECT_EQ(property2->GetStaticPropertyAddress(), nullptr);
   EXPECT_EQ(property3->GetStaticPropertyAddress(), &PropertyTestClass::property3_);
@@ -62,3 +62,44 @@ TEST(reflection, property) {
   EXPECT_EQ(property3->GetPropertySize(), sizeof(std::string));
 }
 
+
+TEST(reflection, property_accessor) {
+  const Meta* property_test_meta = Type::CreateType<PropertyTestClass>().GetMeta();
+  EXPECT_NE(property_test_meta, nullptr);
+  const Property* property1 = property_test_meta->GetProperty("property1_");
+  const Property* property2 = property_test_meta->GetProperty("property2_");
+  const Property* property3 = property_test_meta->GetProperty("property3_");
+
+  PropertyAccessor<int> property1_accessor = property1->MakeAccessor<int>();
+  PropertyAccessor<float> property2_accessor = property2->MakeAccessor<float>();
+  PropertyAccessor<std::string> property3_accessor = property3->MakeAccessor<std::string>();
+  PropertyAccessor<const int> const_property1_accessor = property1->MakeAccessor<const int>();
+  EXPECT_EQ(property1_accessor.IsValid(), true);
+  EXPECT_EQ(property2_accessor.IsValid(), true);
+  EXPECT_EQ(property3_accessor.IsValid(), true);
+  EXPECT_EQ(const_property1_accessor.IsValid(), true);
+  EXPECT_EQ(property1->MakeAccessor<float>().IsValid(), false);
+  EXPECT_EQ(property2->MakeAccessor<int>().IsValid(), false);
+  EXPECT_EQ(Property{}.MakeAccessor<int>().IsValid(), false);
+  EXPECT_EQ(PropertyAccessor<int>{}.IsValid(), false);
+
+  PropertyTestClass property_test_object{};
+  const PropertyTestClass& const_property_test_object = property_test_object;
+  EXPECT_EQ(property1_accessor.Get(&property_test_object), 10);
+  EXPECT_EQ(property2_accessor.Get(&const_property_test_object), 20.0f);
+  EXPECT_EQ(&property1_accessor.Get(&property_test_object), &property_test_object.property1_);
+  EXPECT_EQ(&property3_accessor.Get(&property_test_object), &PropertyTestClass::property3_);
+  property1_accessor.Set(&property_test_object, 30);
+  property2_accessor.Set(&property_test_object, 40.0f);
+  EXPECT_EQ(property_test_object.property1_, 30);
+  EXPECT_EQ(property_test_object.property2_, 40.0f);
+  EXPECT_EQ(const_property1_accessor.Get(&property_test_object), 30);
+
+  Variable property_test_variable = Variable::CreateVariable(PropertyTestClass{});
+  property1_accessor.Set(property_test_variable, 50);
+  property3_accessor.Set(property_test_variable, std::string("new string"));
+  EXPECT_EQ(property1_accessor.Get(property_test_variable), 50);
+  EXPECT_EQ(property_test_variable.GetPropertyVariable("property1_").GetValue(), &property1_accessor.Get(property_test_variable));
+  EXPECT_EQ(PropertyTestClass::property3_, std::string("new string"));
+  PropertyTestClass::property3_ = "string";
+}
@@ -14,7 +14,7 @@ MM_REGISTER {
 }
 
 TEST (reflection, readme) {
-  const Meta* meta_data = GetMetaDatabase().at(typeid(MyStruct).hash_code());
+  const Meta* meta_data = GetMetaDatabase().at(MM::Utils::GetTypeHashCode<MyStruct>());
   for (const Property* prop : meta_data->GetAllProperty()) {
       std::cout << "name: " << prop->GetPropertyName();
   }
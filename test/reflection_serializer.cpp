@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <iterator>
+#include <sstream>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include "reflection.h"
 
@@ -105,6 +111,41 @@ struct TrivialStruct {
   }
 };
 
+struct FlatStruct {
+  std::int8_t flag_;
+  int id_;
+  double value_;
+  float scale_;
+
+  friend bool operator==(const FlatStruct& lhs, const FlatStruct& rhs) {
+    return lhs.flag_ == rhs.flag_ && lhs.id_ == rhs.id_ &&
+           lhs.value_ == rhs.value_ && lhs.scale_ == rhs.scale_;
+  }
+};
+
+// The wrapper of OverAlignedStruct<16> fits in the inline buffer of a
+// Variable by size when MM_REFLECTION_VARIABLE_INLINE_SIZE is 24 or more, but
+// not by alignment.
+template <std::size_t Alignment>
+struct alignas(Alignment) OverAlignedStruct {
+  float values_[4];
+
+  friend bool operator==(const OverAlignedStruct& lhs, const OverAlignedStruct& rhs) {
+    return std::equal(std::begin(lhs.values_), std::end(lhs.values_), std::begin(rhs.values_));
+  }
+};
+
+struct GraphNode {
+  GraphNode* next_;
+  int value_;
+};
+
+struct GraphPair {
+  FlatStruct* first_;
+  FlatStruct* second_;
+  GraphNode* node_;
+};
+
 float g_float = 0.0;
 double g_double = 0.0;
 std::unordered_set<void*> g_deleted_refrence_set{};
@@ -436,6 +477,28 @@ MM_REGISTER {
   Class<TrivialSubStruct5>{"TrivialSubStruct5"}.Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<TrivialSubStruct5>).SetSerializerName(TrivialSerializer::GetSerializerNameStatic());
   Class<TrivialStruct>{"TrivialStruct"}.Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<TrivialStruct>).SetSerializerName(TrivialSerializer::GetSerializerNameStatic());
 
+  Class<OverAlignedStruct<16>>{"OverAlignedStruct16"}.Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<OverAlignedStruct<16>>).SetSerializerName(TrivialSerializer::GetSerializerNameStatic());
+  Class<OverAlignedStruct<64>>{"OverAlignedStruct64"}.Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<OverAlignedStruct<64>>).SetSerializerName(TrivialSerializer::GetSerializerNameStatic());
+
+  Class<FlatStruct>{"FlatStruct"}
+      .Property("flag_", &FlatStruct::flag_)
+      .Property("id_", &FlatStruct::id_)
+      .Property("value_", &FlatStruct::value_)
+      .Property("scale_", &FlatStruct::scale_)
+      .Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<FlatStruct>)
+      .SetSerializerName(UnsefeRecursionSerializer::GetSerializerNameStatic());
+  // GraphNode points to itself, so it has no serializer and only
+  // SerializeGraph writes it.
+  Class<GraphNode>{"GraphNode"}
+      .Property("next_", &GraphNode::next_)
+      .Property("value_", &GraphNode::value_)
+      .Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<GraphNode>);
+  Class<GraphPair>{"GraphPair"}
+      .Property("first_", &GraphPair::first_)
+      .Property("second_", &GraphPair::second_)
+      .Property("node_", &GraphPair::node_)
+      .Method(Meta::GetEmptyObjectMethodName(), &GetEmptyObject<GraphPair>);
+
   Class<RecursionSubClass1>{"RecursionSubClass1"}
       .Property("property1_", &RecursionSubClass1::property1_)
       .Property("property2_", &RecursionSubClass1::property2_)
@@ -503,7 +566,7 @@ TEST(reflection, serialize) {
     Variable trivial_variable_refrence_deserialize = Deserialize(data_buffer_trivial);
     ASSERT_EQ(trivial_variable_refrence_deserialize.IsValid(), true);
     ASSERT_EQ(trivial_variable_refrence_deserialize.IsRefrenceVariable(), true);
-    ASSERT_EQ(trivial_variable_refrence_deserialize.GetType()->GetOriginalTypeHashCode(), typeid(TrivialStruct).hash_code());
+    ASSERT_EQ(trivial_variable_refrence_deserialize.GetType()->GetOriginalTypeHashCode(), MM::Utils::GetTypeHashCode<TrivialStruct>());
     ASSERT_EQ(*static_cast<TrivialStruct*>(trivial_variable_refrence.GetValue()), *static_cast<TrivialStruct*>(trivial_variable_refrence_deserialize.GetValue()));
     free(trivial_variable_refrence_deserialize.GetValue());
 
@@ -512,7 +575,7 @@ TEST(reflection, serialize) {
     recursion_class.RandomData();
     Variable recursion_class_refrence = Variable::CreateVariable(recursion_class);
     DataBuffer data_buffer_recursion{};
-    Meta* meta = GetMetaDatabase().at(typeid(RecursionSubClass5).hash_code());
+    Meta* meta = GetMetaDatabase().at(MM::Utils::GetTypeHashCode<RecursionSubClass5>());
     const Property* p = meta->GetProperty("property3_");
     bool a = p->GetType()->IsReference();
     Serialize(data_buffer_recursion, recursion_class_refrence);
@@ -522,8 +585,877 @@ TEST(reflection, serialize) {
     Variable recursion_class_refrence_deserialize = Deserialize(data_buffer_recursion);
     ASSERT_EQ(recursion_class_refrence_deserialize.IsValid(), true);
     ASSERT_EQ(recursion_class_refrence_deserialize.IsRefrenceVariable(), true);
-    ASSERT_EQ(recursion_class_refrence_deserialize.GetType()->GetOriginalTypeHashCode(), typeid(RecursionClass).hash_code());
+    ASSERT_EQ(recursion_class_refrence_deserialize.GetType()->GetOriginalTypeHashCode(), MM::Utils::GetTypeHashCode<RecursionClass>());
     ASSERT_EQ(*static_cast<RecursionClass*>(recursion_class_refrence.GetValue()), *static_cast<RecursionClass*>(recursion_class_refrence_deserialize.GetValue()));
     free(recursion_class_refrence_deserialize.GetValue());
   }
 }
+
+TEST(reflection, serialize_type_name_compatibility) {
+  TrivialStruct test_trivial_struct{};
+  RandomBit(reinterpret_cast<char*>(&test_trivial_struct), sizeof(TrivialStruct));
+
+  // Types are written as the 8 bytes hash of their registered name.
+  Variable trivial_variable = Variable::CreateVariable(test_trivial_struct);
+  DataBuffer data_buffer_hash{};
+  Serialize(data_buffer_hash, trivial_variable);
+  ASSERT_EQ(data_buffer_hash.GetAddDataOffset(), sizeof(SerializerDescriptor) + sizeof(TypeHashCode) + sizeof(TrivialStruct));
+  TypeHashCode type_name_hash{0};
+  memcpy(&type_name_hash, static_cast<char*>(data_buffer_hash.GetData()) + sizeof(SerializerDescriptor), sizeof(TypeHashCode));
+  ASSERT_EQ(type_name_hash, MM::Utils::HashString("TrivialStruct"));
+
+  // Data that identify types by name is still readable.
+  const std::string type_name{"TrivialStruct"};
+  const SerializerDescriptor descriptor{1, static_cast<std::uint32_t>(type_name.size() + 1), 0, true};
+  DataBuffer data_buffer_name{};
+  data_buffer_name.AddData(&descriptor, sizeof(SerializerDescriptor));
+  data_buffer_name.AddData(type_name.c_str(), type_name.size() + 1);
+  data_buffer_name.AddData(&test_trivial_struct, sizeof(TrivialStruct));
+  Variable trivial_variable_deserialize = Deserialize(data_buffer_name);
+  ASSERT_EQ(trivial_variable_deserialize.IsValid(), true);
+  ASSERT_EQ(trivial_variable_deserialize.GetType()->GetOriginalTypeHashCode(), MM::Utils::GetTypeHashCode<TrivialStruct>());
+  ASSERT_EQ(test_trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_deserialize.GetValue()));
+  free(trivial_variable_deserialize.GetValue());
+}
+
+class ReservedVersionSerializer final : public SerializerBase {
+public:
+  bool Check(const Meta&) const override { return true; }
+
+  DataBuffer& Serialize(DataBuffer& data_buffer, Variable&) const override {
+    return data_buffer;
+  }
+
+  Variable Deserialize(const DataBuffer&, const Meta&,
+                       const DeserializerInfo&) const override {
+    return Variable{};
+  }
+
+  const std::string& GetSerializerName() const override {
+    static const std::string serializer_name{"ReservedVersionSerializer"};
+    return serializer_name;
+  }
+
+  std::uint32_t GetVersion() const override { return SCHEMA_SERIALIZER_VERSION; }
+};
+
+TEST(reflection, serialize_reserved_version) {
+  // A descriptor with the version of a stream format would be read as that
+  // stream, so such serializers are refused.
+  RegisterSerializer<ReservedVersionSerializer>();
+  EXPECT_EQ(FindSerializer("ReservedVersionSerializer"), nullptr);
+  EXPECT_EQ(FindSerializer(TrivialSerializer::GetSerializerNameStatic())->GetVersion() &
+                STREAM_FORMAT_VERSION_FLAG,
+            0);
+}
+
+TEST(reflection, serialize_arena) {
+  TrivialStruct test_trivial_struct{};
+  RandomBit(reinterpret_cast<char*>(&test_trivial_struct), sizeof(TrivialStruct));
+
+  Variable trivial_variable_refrence = Variable::CreateVariable(test_trivial_struct);
+  DataBuffer data_buffer_refrence{};
+  Serialize(data_buffer_refrence, trivial_variable_refrence);
+  Variable trivial_variable = Variable::CreateVariable(test_trivial_struct, true);
+  DataBuffer data_buffer_value{};
+  Serialize(data_buffer_value, trivial_variable);
+
+  VariableArena arena{};
+  {
+    VariableArenaScope arena_scope{arena};
+
+    // The refrence and the value are both placed in the arena, so nothing
+    // needs to be freed.
+    Variable refrence_deserialize = Deserialize(data_buffer_refrence);
+    ASSERT_EQ(refrence_deserialize.IsValid(), true);
+    ASSERT_EQ(refrence_deserialize.IsRefrenceVariable(), true);
+    ASSERT_EQ(test_trivial_struct, *static_cast<TrivialStruct*>(refrence_deserialize.GetValue()));
+    const std::size_t used_size = arena.GetUsedSize();
+    EXPECT_GE(used_size, sizeof(TrivialStruct));
+
+    Variable value_deserialize = Deserialize(data_buffer_value);
+    ASSERT_EQ(value_deserialize.IsValid(), true);
+    ASSERT_EQ(value_deserialize.IsRefrenceVariable(), false);
+    ASSERT_EQ(test_trivial_struct, *static_cast<TrivialStruct*>(value_deserialize.GetValue()));
+    EXPECT_GE(arena.GetUsedSize(), used_size + sizeof(TrivialStruct));
+  }
+  arena.Reset();
+}
+
+template <std::size_t Alignment>
+void CheckOverAlignedDeserialize() {
+  Variable aligned_variable = Variable::CreateVariable(OverAlignedStruct<Alignment>{{1.0f, 2.0f, 3.0f, 4.0f}});
+  ASSERT_EQ(aligned_variable.IsRefrenceVariable(), false);
+  DataBuffer data_buffer{};
+  Serialize(data_buffer, aligned_variable);
+
+  Variable aligned_deserialize = Deserialize(data_buffer);
+  ASSERT_EQ(aligned_deserialize.IsValid(), true);
+  ASSERT_EQ(aligned_deserialize.IsRefrenceVariable(), false);
+  const auto value_address = reinterpret_cast<std::uintptr_t>(aligned_deserialize.GetValue());
+  EXPECT_EQ(value_address % Alignment, 0);
+  // The inline buffer of a Variable is only pointer aligned.
+  const auto variable_address = reinterpret_cast<std::uintptr_t>(&aligned_deserialize);
+  EXPECT_EQ(value_address >= variable_address && value_address < variable_address + sizeof(Variable), false);
+  EXPECT_EQ(aligned_deserialize.GetValueCast<OverAlignedStruct<Alignment>>(), aligned_variable.GetValueCast<OverAlignedStruct<Alignment>>());
+}
+
+TEST(reflection, serialize_over_aligned) {
+  CheckOverAlignedDeserialize<16>();
+  CheckOverAlignedDeserialize<64>();
+}
+
+TEST(reflection, serialization_plan) {
+  const Meta* meta = GetMetaDatabase().at(MM::Utils::GetTypeHashCode<RecursionSubClass2>());
+  std::shared_ptr<const SerializationPlan> plan = meta->GetSerializationPlan();
+  ASSERT_EQ(plan->IsValid(), true);
+  ASSERT_EQ(plan.get(), meta->GetSerializationPlan().get());
+  SerializationPlan::InvalidateAll();
+  ASSERT_NE(plan.get(), meta->GetSerializationPlan().get());
+  plan = meta->GetSerializationPlan();
+
+  RecursionSubClass2 test_object{};
+  test_object.RandomData();
+  Variable test_variable = Variable::CreateVariable(test_object);
+  DataBuffer data_buffer_plan{};
+  Serialize(data_buffer_plan, test_variable);
+  const std::uint64_t header_size = sizeof(SerializerDescriptor) + sizeof(TypeHashCode);
+  ASSERT_EQ(data_buffer_plan.GetAddDataOffset(), header_size + plan->GetSerializedSize());
+
+  // The plan writes the same bytes as serializing each property in turn.
+  DataBuffer data_buffer_property{};
+  for (const Property* property : meta->GetAllProperty()) {
+    Variable property_variable = test_variable.GetPropertyVariable(property->GetPropertyName());
+    const bool is_refrence = property->GetType()->IsReference() || property->GetType()->IsPointer();
+    SerializerDescriptor descriptor{};
+    memset(static_cast<void*>(&descriptor), 0, sizeof(SerializerDescriptor));
+    descriptor.version_ = 1;
+    descriptor.is_refrence_ = is_refrence;
+    const TypeHashCode type_name_hash = MM::Utils::HashString(property->GetMeta()->GetTypeName());
+    data_buffer_property.AddData(&descriptor, sizeof(SerializerDescriptor));
+    data_buffer_property.AddData(&type_name_hash, sizeof(TypeHashCode));
+    const void* value = property->GetType()->IsPointer()
+                            ? property_variable.GetValueCast<void*>()
+                            : property_variable.GetValue();
+    data_buffer_property.AddData(value, property->GetMeta()->GetType().GetSize());
+  }
+  ASSERT_EQ(data_buffer_property.GetAddDataOffset(), plan->GetSerializedSize());
+  ASSERT_EQ(memcmp(static_cast<const char*>(data_buffer_plan.GetData()) + header_size,
+                   data_buffer_property.GetData(), plan->GetSerializedSize()), 0);
+
+  Variable plan_deserialize = Deserialize(data_buffer_plan);
+  ASSERT_EQ(plan_deserialize.IsValid(), true);
+  ASSERT_EQ(data_buffer_plan.GetReadDataOffset(), data_buffer_plan.GetAddDataOffset());
+  ASSERT_EQ(test_object, *static_cast<RecursionSubClass2*>(plan_deserialize.GetValue()));
+  free(plan_deserialize.GetValue());
+
+  // Data that the plan does not describe (here, a property identified by its
+  // type name) is read property by property.
+  DataBuffer data_buffer_name{};
+  data_buffer_name.AddData(data_buffer_plan.GetData(), header_size);
+  bool is_first_property = true;
+  for (const Property* property : meta->GetAllProperty()) {
+    Variable property_variable = test_variable.GetPropertyVariable(property->GetPropertyName());
+    if (!is_first_property) {
+      if (property->GetType()->IsPointer()) {
+        Variable refrence_variable = property_variable.PointerVariableToRefrenceVariable(true);
+        Serialize(data_buffer_name, refrence_variable);
+      } else {
+        Serialize(data_buffer_name, property_variable);
+      }
+      continue;
+    }
+    is_first_property = false;
+    const std::string& type_name = property->GetMeta()->GetTypeName();
+    const bool is_refrence = property->GetType()->IsReference() || property->GetType()->IsPointer();
+    const SerializerDescriptor descriptor{1, static_cast<std::uint32_t>(type_name.size() + 1), 0, is_refrence};
+    data_buffer_name.AddData(&descriptor, sizeof(SerializerDescriptor));
+    data_buffer_name.AddData(type_name.c_str(), type_name.size() + 1);
+    const void* value = property->GetType()->IsPointer()
+                            ? property_variable.GetValueCast<void*>()
+                            : property_variable.GetValue();
+    data_buffer_name.AddData(value, property->GetMeta()->GetType().GetSize());
+  }
+  Variable name_deserialize = Deserialize(data_buffer_name);
+  ASSERT_EQ(name_deserialize.IsValid(), true);
+  ASSERT_EQ(data_buffer_name.GetReadDataOffset(), data_buffer_name.GetAddDataOffset());
+  ASSERT_EQ(test_object, *static_cast<RecursionSubClass2*>(name_deserialize.GetValue()));
+  free(name_deserialize.GetValue());
+}
+
+TEST(reflection, serialization_plan_nested) {
+  const Meta* meta = GetMetaDatabase().at(MM::Utils::GetTypeHashCode<RecursionClass>());
+  std::shared_ptr<const SerializationPlan> plan = meta->GetSerializationPlan();
+  ASSERT_EQ(plan->IsValid(), true);
+
+  RecursionClass recursion_class{};
+  recursion_class.RandomData();
+  Variable recursion_class_refrence = Variable::CreateVariable(recursion_class);
+  DataBuffer data_buffer{};
+  Serialize(data_buffer, recursion_class_refrence);
+  ASSERT_EQ(data_buffer.GetAddDataOffset(), sizeof(SerializerDescriptor) + sizeof(TypeHashCode) + plan->GetSerializedSize());
+
+  Variable recursion_class_deserialize = Deserialize(data_buffer);
+  ASSERT_EQ(recursion_class_deserialize.IsValid(), true);
+  ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_deserialize.GetValue()));
+  free(recursion_class_deserialize.GetValue());
+}
+
+TEST(reflection, serialize_with_schema) {
+  RecursionClass recursion_class{};
+  recursion_class.RandomData();
+  Variable recursion_class_refrence = Variable::CreateVariable(recursion_class);
+
+  DataBuffer data_buffer_descriptor{};
+  Serialize(data_buffer_descriptor, recursion_class_refrence);
+  DataBuffer data_buffer_schema{};
+  SerializeWithSchema(data_buffer_schema, recursion_class_refrence);
+  ASSERT_LT(data_buffer_schema.GetAddDataOffset(), data_buffer_descriptor.GetAddDataOffset());
+
+  Variable recursion_class_deserialize = Deserialize(data_buffer_schema);
+  ASSERT_EQ(recursion_class_deserialize.IsValid(), true);
+  ASSERT_EQ(recursion_class_deserialize.IsRefrenceVariable(), true);
+  ASSERT_EQ(data_buffer_schema.GetReadDataOffset(), data_buffer_schema.GetAddDataOffset());
+  ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_deserialize.GetValue()));
+  free(recursion_class_deserialize.GetValue());
+
+  // Many objects share one schema table.
+  SchemaWriter schema_writer{};
+  std::vector<TrivialStruct> trivial_structs(10);
+  for (TrivialStruct& trivial_struct : trivial_structs) {
+    RandomBit(reinterpret_cast<char*>(&trivial_struct), sizeof(TrivialStruct));
+    Variable trivial_variable = Variable::CreateVariable(trivial_struct);
+    ASSERT_EQ(schema_writer.AddObject(trivial_variable), true);
+  }
+  ASSERT_EQ(schema_writer.AddObject(recursion_class_refrence), true);
+  DataBuffer data_buffer_objects{};
+  schema_writer.Finish(data_buffer_objects);
+  ASSERT_EQ(schema_writer.GetObjectNumber(), 0);
+
+  SchemaReader schema_reader{data_buffer_objects};
+  ASSERT_EQ(schema_reader.IsValid(), true);
+  ASSERT_EQ(schema_reader.GetObjectNumber(), trivial_structs.size() + 1);
+  for (const TrivialStruct& trivial_struct : trivial_structs) {
+    ASSERT_EQ(schema_reader.HaveObject(), true);
+    Variable trivial_variable = schema_reader.ReadObject();
+    ASSERT_EQ(trivial_variable.IsValid(), true);
+    ASSERT_EQ(trivial_struct, *static_cast<TrivialStruct*>(trivial_variable.GetValue()));
+    free(trivial_variable.GetValue());
+  }
+  Variable recursion_class_read = schema_reader.ReadObject();
+  ASSERT_EQ(recursion_class_read.IsValid(), true);
+  ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_read.GetValue()));
+  free(recursion_class_read.GetValue());
+  ASSERT_EQ(schema_reader.HaveObject(), false);
+  ASSERT_EQ(data_buffer_objects.GetReadDataOffset(), data_buffer_objects.GetAddDataOffset());
+}
+
+TEST(reflection, serialize_with_schema_unknown_property) {
+  RecursionSubClass2 test_object{};
+  test_object.RandomData();
+  Variable test_variable = Variable::CreateVariable(test_object);
+  DataBuffer data_buffer{};
+  SerializeWithSchema(data_buffer, test_variable);
+
+  // Rename property1_ in the schema table, as if it was removed from the type.
+  const TypeHashCode property_name_hash = MM::Utils::HashString("property1_");
+  const TypeHashCode unknown_name_hash = MM::Utils::HashString("removed_property_");
+  char* data = static_cast<char*>(data_buffer.GetData());
+  std::uint64_t offset = sizeof(SchemaHeader);
+  for (; offset + sizeof(TypeHashCode) <= data_buffer.GetAddDataOffset(); ++offset) {
+    if (memcmp(data + offset, &property_name_hash, sizeof(TypeHashCode)) == 0) {
+      break;
+    }
+  }
+  ASSERT_LE(offset + sizeof(TypeHashCode), data_buffer.GetAddDataOffset());
+  memcpy(data + offset, &unknown_name_hash, sizeof(TypeHashCode));
+
+  // The data of the unknown property is skipped, and property1_ keeps the
+  // value of the empty object.
+  Variable test_variable_deserialize = Deserialize(data_buffer);
+  ASSERT_EQ(test_variable_deserialize.IsValid(), true);
+  ASSERT_EQ(data_buffer.GetReadDataOffset(), data_buffer.GetAddDataOffset());
+  ASSERT_EQ(test_variable_deserialize.GetPropertyVariable("property1_").GetValueCast<double>(), 0.0);
+  ASSERT_EQ(test_variable_deserialize.GetPropertyVariable("property2_").GetValueCast<double>(),
+            test_variable.GetPropertyVariable("property2_").GetValueCast<double>());
+  ASSERT_EQ(*test_variable_deserialize.GetPropertyVariable("property3_").GetValueCast<float*>(),
+            *test_variable.GetPropertyVariable("property3_").GetValueCast<float*>());
+  free(test_variable_deserialize.GetValue());
+}
+
+TEST(reflection, serialize_mapped_file) {
+  RecursionClass recursion_class{};
+  recursion_class.RandomData();
+  Variable recursion_class_refrence = Variable::CreateVariable(recursion_class);
+  TrivialStruct test_trivial_struct{};
+  RandomBit(reinterpret_cast<char*>(&test_trivial_struct), sizeof(TrivialStruct));
+  Variable trivial_variable_refrence = Variable::CreateVariable(test_trivial_struct);
+
+  DataBuffer data_buffer{};
+  Serialize(data_buffer, trivial_variable_refrence);
+  const std::uint64_t trivial_size = data_buffer.GetAddDataOffset();
+  Serialize(data_buffer, recursion_class_refrence);
+  ASSERT_EQ(data_buffer.WriteToFile("./mapped_file.bin"), true);
+
+  DataBuffer mapped_buffer{};
+  ASSERT_EQ(mapped_buffer.MapFile("./mapped_file.bin"), true);
+  ASSERT_EQ(mapped_buffer.IsMapped(), true);
+  ASSERT_EQ(mapped_buffer.GetAddDataOffset(), data_buffer.GetAddDataOffset());
+  Variable trivial_variable_deserialize = Deserialize(mapped_buffer);
+  ASSERT_EQ(test_trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_deserialize.GetValue()));
+  free(trivial_variable_deserialize.GetValue());
+  Variable recursion_class_deserialize = Deserialize(mapped_buffer);
+  ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_deserialize.GetValue()));
+  free(recursion_class_deserialize.GetValue());
+
+  // A mapping can start anywhere in the file.
+  DataBuffer mapped_part_buffer{};
+  ASSERT_EQ(mapped_part_buffer.MapFile("./mapped_file.bin", trivial_size), true);
+  ASSERT_EQ(mapped_part_buffer.GetAddDataOffset(), data_buffer.GetAddDataOffset() - trivial_size);
+  recursion_class_deserialize = Deserialize(mapped_part_buffer);
+  ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_deserialize.GetValue()));
+  free(recursion_class_deserialize.GetValue());
+
+  // Adding data copies the mapping into the buffer.
+  Serialize(mapped_part_buffer, trivial_variable_refrence);
+  ASSERT_EQ(mapped_part_buffer.IsMapped(), false);
+  trivial_variable_deserialize = Deserialize(mapped_part_buffer);
+  ASSERT_EQ(test_trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_deserialize.GetValue()));
+  free(trivial_variable_deserialize.GetValue());
+
+  ASSERT_EQ(mapped_buffer.MapFile("./not_exist_file.bin"), false);
+}
+
+TEST(reflection, serialize_segmented) {
+  RecursionClass recursion_class{};
+  recursion_class.RandomData();
+  Variable recursion_class_refrence = Variable::CreateVariable(recursion_class);
+  TrivialStruct test_trivial_struct{};
+  RandomBit(reinterpret_cast<char*>(&test_trivial_struct), sizeof(TrivialStruct));
+  Variable trivial_variable_refrence = Variable::CreateVariable(test_trivial_struct);
+
+  // Segments smaller than the objects, so that the objects are split.
+  DataBuffer segmented_buffer = DataBuffer::CreateSegmented(64);
+  DataBuffer data_buffer{};
+  for (int i = 0; i != 3; ++i) {
+    Serialize(segmented_buffer, trivial_variable_refrence);
+    Serialize(segmented_buffer, recursion_class_refrence);
+    Serialize(data_buffer, trivial_variable_refrence);
+    Serialize(data_buffer, recursion_class_refrence);
+  }
+  ASSERT_EQ(segmented_buffer.IsSegmented(), true);
+  ASSERT_EQ(segmented_buffer.GetAddDataOffset(), data_buffer.GetAddDataOffset());
+  ASSERT_GT(segmented_buffer.GetSegments().size(), 1);
+  ASSERT_EQ(data_buffer.GetSegments().size(), 1);
+
+  std::string segmented_data{};
+  for (const DataSegment& segment : segmented_buffer.GetSegments()) {
+    segmented_data.append(static_cast<const char*>(segment.data_), segment.size_);
+  }
+  ASSERT_EQ(segmented_data, std::string(static_cast<const char*>(data_buffer.GetData()), data_buffer.GetAddDataOffset()));
+
+  for (int i = 0; i != 3; ++i) {
+    Variable trivial_variable_deserialize = Deserialize(segmented_buffer);
+    ASSERT_EQ(test_trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_deserialize.GetValue()));
+    free(trivial_variable_deserialize.GetValue());
+    Variable recursion_class_deserialize = Deserialize(segmented_buffer);
+    ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_deserialize.GetValue()));
+    free(recursion_class_deserialize.GetValue());
+  }
+  ASSERT_EQ(segmented_buffer.GetReadDataOffset(), segmented_buffer.GetAddDataOffset());
+
+  // All segments are written to one file.
+  ASSERT_EQ(segmented_buffer.WriteToFile("./segmented_file.bin"), true);
+  DataBuffer loaded_buffer{};
+  ASSERT_EQ(loaded_buffer.LoadFromFile("./segmented_file.bin"), true);
+  ASSERT_EQ(std::string(static_cast<const char*>(loaded_buffer.GetData()), loaded_buffer.GetAddDataOffset()), segmented_data);
+
+  // Segments are reused after Clear.
+  const std::uint64_t capacity = segmented_buffer.GetCapacity();
+  segmented_buffer.Clear();
+  Serialize(segmented_buffer, recursion_class_refrence);
+  ASSERT_EQ(segmented_buffer.GetCapacity(), capacity);
+  Variable recursion_class_deserialize = Deserialize(segmented_buffer);
+  ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_deserialize.GetValue()));
+  free(recursion_class_deserialize.GetValue());
+}
+
+TEST(reflection, serialized_view) {
+  RecursionClass recursion_class{};
+  recursion_class.RandomData();
+  Variable recursion_class_refrence = Variable::CreateVariable(recursion_class);
+  TrivialStruct test_trivial_struct{};
+  RandomBit(reinterpret_cast<char*>(&test_trivial_struct), sizeof(TrivialStruct));
+  Variable trivial_variable_refrence = Variable::CreateVariable(test_trivial_struct);
+
+  DataBuffer data_buffer{};
+  Serialize(data_buffer, recursion_class_refrence);
+  Serialize(data_buffer, trivial_variable_refrence);
+  Serialize(data_buffer, recursion_class_refrence);
+  SerializeWithSchema(data_buffer, recursion_class_refrence);
+
+  SerializedView recursion_class_view{data_buffer};
+  ASSERT_EQ(recursion_class_view.IsValid(), true);
+  ASSERT_EQ(recursion_class_view.GetMeta(), FindMeta(MM::Utils::GetTypeHashCode<RecursionClass>()));
+  SerializedView sub_class_view = recursion_class_view.GetPropertyView("property1_");
+  ASSERT_EQ(sub_class_view.IsValid(), true);
+  Variable sub_class_variable = recursion_class_refrence.GetPropertyVariable("property1_");
+  const auto* sub_class = static_cast<RecursionSubClass1*>(sub_class_variable.GetValue());
+  int int_value{0};
+  ASSERT_EQ(sub_class_view.GetPropertyValue("property1_", int_value), true);
+  ASSERT_EQ(int_value, sub_class->property1_);
+  double double_value{0.0};
+  ASSERT_EQ(sub_class_view.GetPropertyValue("property2_", double_value), true);
+  ASSERT_EQ(double_value, sub_class->property2_);
+  // Pointer and refrence properties hold the value they point to.
+  ASSERT_EQ(sub_class_view.GetPropertyValue("property4_", double_value), true);
+  ASSERT_EQ(double_value, *sub_class->property4_);
+  float float_value{0.0f};
+  ASSERT_EQ(sub_class_view.GetPropertyValue("property5_", float_value), true);
+  ASSERT_EQ(float_value, sub_class->property5_);
+  ASSERT_EQ(sub_class_view.GetPropertyValue("property1_", double_value), false);
+  ASSERT_EQ(sub_class_view.GetPropertyData("not_exist_property"), nullptr);
+  ASSERT_EQ(recursion_class_view.GetPropertyView("not_exist_property").IsValid(), false);
+
+  // The view skips the record.
+  SerializedView trivial_view{data_buffer};
+  ASSERT_EQ(trivial_view.IsValid(), true);
+  ASSERT_EQ(trivial_view.GetMeta(), FindMeta(MM::Utils::GetTypeHashCode<TrivialStruct>()));
+  Variable recursion_class_deserialize = Deserialize(data_buffer);
+  ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_deserialize.GetValue()));
+  free(recursion_class_deserialize.GetValue());
+
+  // Nothing is read from a record that cannot be viewed.
+  const std::uint64_t read_data_offset = data_buffer.GetReadDataOffset();
+  SerializedView schema_view{data_buffer};
+  ASSERT_EQ(schema_view.IsValid(), false);
+  ASSERT_EQ(data_buffer.GetReadDataOffset(), read_data_offset);
+}
+
+TEST(reflection, serialize_delta) {
+  // Only property1_ differs from the empty object.
+  RecursionSubClass1 sparse_object{};
+  sparse_object.property1_ = 42;
+  Variable sparse_object_refrence = Variable::CreateVariable(sparse_object);
+  DataBuffer data_buffer{};
+  SerializeDelta(data_buffer, sparse_object_refrence);
+  DataBuffer full_data_buffer{};
+  Serialize(full_data_buffer, sparse_object_refrence);
+  ASSERT_EQ(data_buffer.GetAddDataOffset(), sizeof(DeltaHeader) + 1 + sizeof(int));
+  ASSERT_LT(data_buffer.GetAddDataOffset(), full_data_buffer.GetAddDataOffset());
+  Variable sparse_object_deserialize = Deserialize(data_buffer);
+  ASSERT_EQ(sparse_object, *static_cast<RecursionSubClass1*>(sparse_object_deserialize.GetValue()));
+  free(sparse_object_deserialize.GetValue());
+
+  RecursionClass recursion_class{};
+  recursion_class.RandomData();
+  Variable recursion_class_refrence = Variable::CreateVariable(recursion_class);
+  SerializeDelta(data_buffer, recursion_class_refrence);
+  Variable recursion_class_deserialize = Deserialize(data_buffer);
+  ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_deserialize.GetValue()));
+  free(recursion_class_deserialize.GetValue());
+
+  // A trivial type without properties is written by Serialize.
+  TrivialStruct test_trivial_struct{};
+  RandomBit(reinterpret_cast<char*>(&test_trivial_struct), sizeof(TrivialStruct));
+  Variable trivial_variable_refrence = Variable::CreateVariable(test_trivial_struct);
+  SerializeDelta(data_buffer, trivial_variable_refrence);
+  Variable trivial_variable_deserialize = Deserialize(data_buffer);
+  ASSERT_EQ(test_trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_deserialize.GetValue()));
+  free(trivial_variable_deserialize.GetValue());
+
+  // Nothing is read from an incomplete delta.
+  DataBuffer delta_data_buffer{};
+  SerializeDelta(delta_data_buffer, sparse_object_refrence);
+  DataBuffer incomplete_data_buffer{};
+  incomplete_data_buffer.AddData(delta_data_buffer.GetData(), delta_data_buffer.GetAddDataOffset() - 1);
+  ASSERT_EQ(DeserializeDelta(incomplete_data_buffer).IsValid(), false);
+  ASSERT_EQ(incomplete_data_buffer.GetReadDataOffset(), 0);
+}
+
+TEST(reflection, serialize_graph) {
+  // The recursion serializer refuses a type that points to itself.
+  const Meta* graph_node_meta = FindMeta(MM::Utils::GetTypeHashCode<GraphNode>());
+  ASSERT_NE(graph_node_meta, nullptr);
+  ASSERT_FALSE(graph_node_meta->HaveSerializer());
+  ASSERT_FALSE(FindSerializer(UnsefeRecursionSerializer::GetSerializerNameStatic())->Check(*graph_node_meta));
+
+  // Two nodes that point to each other.
+  GraphNode first_node{nullptr, 1};
+  GraphNode second_node{&first_node, 2};
+  first_node.next_ = &second_node;
+  Variable first_node_refrence = Variable::CreateVariable(first_node);
+  DataBuffer data_buffer{};
+  SerializeGraph(data_buffer, first_node_refrence);
+  ASSERT_EQ(data_buffer.GetAddDataOffset(), sizeof(GraphHeader) + sizeof(TypeHashCode) + 2 * sizeof(std::uint32_t) + 2 * (sizeof(std::uint32_t) + sizeof(int)));
+  Variable first_node_deserialize = Deserialize(data_buffer);
+  ASSERT_TRUE(first_node_deserialize.IsValid());
+  auto* first_node_value = static_cast<GraphNode*>(first_node_deserialize.GetValue());
+  ASSERT_EQ(first_node_value->value_, 1);
+  ASSERT_NE(first_node_value->next_, nullptr);
+  ASSERT_EQ(first_node_value->next_->value_, 2);
+  ASSERT_EQ(first_node_value->next_->next_, first_node_value);
+  free(first_node_value->next_);
+  free(first_node_value);
+
+  // A pointer out of the graph is refused.
+  data_buffer.Clear();
+  SerializeGraph(data_buffer, first_node_refrence);
+  const std::uint32_t bad_object_id = 3;
+  memcpy(static_cast<std::uint8_t*>(data_buffer.GetData()) + data_buffer.GetAddDataOffset() - sizeof(std::uint32_t) - sizeof(int), &bad_object_id, sizeof(std::uint32_t));
+  ASSERT_FALSE(Deserialize(data_buffer).IsValid());
+  data_buffer.Clear();
+
+  // Both pointers share one object, and a null pointer stays null.
+  FlatStruct flat_struct{3, 4, 5.0, 6.0f};
+  GraphNode single_node{nullptr, 7};
+  GraphPair graph_pair{&flat_struct, &flat_struct, &single_node};
+  Variable graph_pair_refrence = Variable::CreateVariable(graph_pair);
+  SerializeGraph(data_buffer, graph_pair_refrence);
+  Variable graph_pair_deserialize = Deserialize(data_buffer);
+  ASSERT_TRUE(graph_pair_deserialize.IsValid());
+  auto* graph_pair_value = static_cast<GraphPair*>(graph_pair_deserialize.GetValue());
+  ASSERT_EQ(graph_pair_value->first_, graph_pair_value->second_);
+  ASSERT_EQ(*graph_pair_value->first_, flat_struct);
+  ASSERT_EQ(graph_pair_value->node_->value_, 7);
+  ASSERT_EQ(graph_pair_value->node_->next_, nullptr);
+  free(graph_pair_value->first_);
+  free(graph_pair_value->node_);
+  free(graph_pair_value);
+
+  // Objects that share the global sub objects.
+  RecursionClass recursion_class{};
+  recursion_class.RandomData();
+  Variable recursion_class_refrence = Variable::CreateVariable(recursion_class);
+  SerializeGraph(data_buffer, recursion_class_refrence);
+  Variable recursion_class_deserialize = Deserialize(data_buffer);
+  ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_deserialize.GetValue()));
+  free(recursion_class_deserialize.GetValue());
+
+  // A trivial type is copied as a whole.
+  TrivialStruct test_trivial_struct{};
+  RandomBit(reinterpret_cast<char*>(&test_trivial_struct), sizeof(TrivialStruct));
+  Variable trivial_variable_refrence = Variable::CreateVariable(test_trivial_struct);
+  SerializeGraph(data_buffer, trivial_variable_refrence);
+  Variable trivial_variable_deserialize = Deserialize(data_buffer);
+  ASSERT_EQ(test_trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_deserialize.GetValue()));
+  free(trivial_variable_deserialize.GetValue());
+}
+
+TEST(reflection, serialize_batch) {
+  const Meta* flat_struct_meta = FindMeta(MM::Utils::GetTypeHashCode<FlatStruct>());
+  ASSERT_NE(flat_struct_meta, nullptr);
+  std::vector<FlatStruct> flat_structs(1000);
+  for (std::size_t index = 0; index != flat_structs.size(); ++index) {
+    flat_structs[index] = FlatStruct{static_cast<std::int8_t>(index), static_cast<int>(index) * 3, index * 0.5, index * 0.25f};
+  }
+
+  DataBuffer data_buffer{};
+  ASSERT_EQ(SerializeBatch(data_buffer, *flat_struct_meta, flat_structs.data(), flat_structs.size()), true);
+  // One column per property, without padding.
+  ASSERT_EQ(data_buffer.GetAddDataOffset(), sizeof(BatchHeader) + flat_structs.size() * (1 + 4 + 8 + 4));
+  ASSERT_EQ(GetBatchObjectNumber(data_buffer), flat_structs.size());
+  std::vector<FlatStruct> flat_structs_deserialize(flat_structs.size());
+  ASSERT_EQ(DeserializeBatch(data_buffer, *flat_struct_meta, flat_structs_deserialize.data(), flat_structs_deserialize.size()), flat_structs.size());
+  ASSERT_EQ(flat_structs_deserialize, flat_structs);
+
+  // Columns split between segments.
+  DataBuffer segmented_buffer = DataBuffer::CreateSegmented(100);
+  TrivialStruct trivial_structs[3]{};
+  RandomBit(reinterpret_cast<char*>(trivial_structs), sizeof(trivial_structs));
+  const Meta* trivial_struct_meta = FindMeta(MM::Utils::GetTypeHashCode<TrivialStruct>());
+  ASSERT_EQ(SerializeBatch(segmented_buffer, *flat_struct_meta, flat_structs.data(), flat_structs.size()), true);
+  ASSERT_EQ(SerializeBatch(segmented_buffer, *trivial_struct_meta, trivial_structs, 3), true);
+  std::fill(flat_structs_deserialize.begin(), flat_structs_deserialize.end(), FlatStruct{});
+  ASSERT_EQ(DeserializeBatch(segmented_buffer, *flat_struct_meta, flat_structs_deserialize.data(), flat_structs_deserialize.size()), flat_structs.size());
+  ASSERT_EQ(flat_structs_deserialize, flat_structs);
+  // Nothing is read if the array is too small or the type does not match.
+  ASSERT_EQ(DeserializeBatch(segmented_buffer, *trivial_struct_meta, trivial_structs, 2), 0);
+  ASSERT_EQ(DeserializeBatch(segmented_buffer, *flat_struct_meta, flat_structs_deserialize.data(), flat_structs_deserialize.size()), 0);
+  TrivialStruct trivial_structs_deserialize[3]{};
+  ASSERT_EQ(DeserializeBatch(segmented_buffer, *trivial_struct_meta, trivial_structs_deserialize, 3), 3);
+  for (int index = 0; index != 3; ++index) {
+    ASSERT_EQ(trivial_structs_deserialize[index], trivial_structs[index]);
+  }
+
+  // Types with pointer or refrence properties cannot be written as columns.
+  const Meta* recursion_class_meta = FindMeta(MM::Utils::GetTypeHashCode<RecursionClass>());
+  RecursionClass recursion_class{};
+  DataBuffer recursion_class_buffer{};
+  ASSERT_EQ(SerializeBatch(recursion_class_buffer, *recursion_class_meta, &recursion_class, 1), false);
+  ASSERT_EQ(recursion_class_buffer.GetAddDataOffset(), 0);
+}
+
+TEST(reflection, serialize_parallel) {
+  std::vector<FlatStruct> flat_structs(1001);
+  std::vector<Variable> variables{};
+  for (std::size_t index = 0; index != flat_structs.size(); ++index) {
+    flat_structs[index] = FlatStruct{static_cast<std::int8_t>(index), static_cast<int>(index) * 3, index * 0.5, index * 0.25f};
+    variables.push_back(Variable::CreateVariable(flat_structs[index]));
+  }
+  DataBuffer sequential_buffer{};
+  for (Variable& variable : variables) {
+    Serialize(sequential_buffer, variable);
+  }
+
+  // Uneven shards, into a contiguous and a segmented buffer.
+  const std::uint64_t shard_number = (flat_structs.size() + PARALLEL_SHARD_OBJECT_NUMBER - 1) / PARALLEL_SHARD_OBJECT_NUMBER;
+  DataBuffer data_buffer{};
+  ASSERT_EQ(SerializeParallel(data_buffer, variables.data(), variables.size(), 2), true);
+  ASSERT_EQ(data_buffer.GetAddDataOffset(), sizeof(ParallelHeader) + shard_number * sizeof(ParallelShard) + sequential_buffer.GetAddDataOffset());
+  ASSERT_EQ(GetParallelObjectNumber(data_buffer), flat_structs.size());
+  DataBuffer segmented_buffer = DataBuffer::CreateSegmented(1000);
+  ASSERT_EQ(SerializeParallel(segmented_buffer, variables.data(), variables.size(), 3), true);
+  // The shards do not depend on the number of threads.
+  DataBuffer one_thread_buffer{};
+  ASSERT_EQ(SerializeParallel(one_thread_buffer, variables.data(), variables.size(), 1), true);
+  ASSERT_EQ(one_thread_buffer.GetAddDataOffset(), data_buffer.GetAddDataOffset());
+  ASSERT_EQ(memcmp(one_thread_buffer.GetData(), data_buffer.GetData(), data_buffer.GetAddDataOffset()), 0);
+  ASSERT_EQ(Deserialize(data_buffer).IsValid(), false);
+  ASSERT_EQ(data_buffer.GetReadDataOffset(), 0);
+
+  for (DataBuffer* buffer : {&data_buffer, &segmented_buffer}) {
+    std::vector<Variable> variables_deserialize(flat_structs.size() - 1);
+    ASSERT_EQ(DeserializeParallel(*buffer, variables_deserialize.data(), variables_deserialize.size(), 2), 0);
+    variables_deserialize.resize(flat_structs.size());
+    // The arena of the calling thread is not used by any shard.
+    VariableArena arena{};
+    {
+      VariableArenaScope arena_scope{arena};
+      ASSERT_EQ(DeserializeParallel(*buffer, variables_deserialize.data(), variables_deserialize.size(), 2), flat_structs.size());
+    }
+    ASSERT_EQ(arena.GetUsedSize(), 0);
+    ASSERT_EQ(buffer->GetReadDataOffset(), buffer->GetAddDataOffset());
+    for (std::size_t index = 0; index != flat_structs.size(); ++index) {
+      ASSERT_EQ(flat_structs[index], *static_cast<FlatStruct*>(variables_deserialize[index].GetValue()));
+      free(variables_deserialize[index].GetValue());
+    }
+  }
+
+  // The type of the last object is not registered, so the objects read before
+  // it are released.
+  TypeHashCode unknown_type_name_hash = 0;
+  const std::uint64_t object_size = sequential_buffer.GetAddDataOffset() / flat_structs.size();
+  memcpy(static_cast<std::uint8_t*>(one_thread_buffer.GetData()) + one_thread_buffer.GetAddDataOffset() - object_size + sizeof(SerializerDescriptor), &unknown_type_name_hash, sizeof(TypeHashCode));
+  std::vector<Variable> variables_deserialize(flat_structs.size());
+  ASSERT_EQ(DeserializeParallel(one_thread_buffer, variables_deserialize.data(), variables_deserialize.size(), 1), 0);
+  for (const Variable& variable : variables_deserialize) {
+    ASSERT_FALSE(variable.IsValid());
+  }
+}
+
+TEST(reflection, record_store) {
+  std::vector<FlatStruct> flat_structs(100);
+  DataBuffer data_buffer{};
+  RecordWriter record_writer{data_buffer};
+  for (std::size_t index = 0; index != flat_structs.size(); ++index) {
+    flat_structs[index] = FlatStruct{static_cast<std::int8_t>(index), static_cast<int>(index) * 3, index * 0.5, index * 0.25f};
+    Variable flat_struct_refrence = Variable::CreateVariable(flat_structs[index]);
+    ASSERT_EQ(record_writer.AddRecord(flat_struct_refrence), true);
+  }
+  ASSERT_EQ(record_writer.AddRecordData("raw", 3), true);
+  const std::uint64_t unfinished_size = data_buffer.GetAddDataOffset();
+  record_writer.Finish();
+  ASSERT_EQ(record_writer.AddRecordData("raw", 3), false);
+  ASSERT_EQ(Deserialize(data_buffer).IsValid(), false);
+  ASSERT_EQ(data_buffer.WriteToFile("./record_store.bin"), true);
+
+  RecordReader record_reader{};
+  ASSERT_EQ(record_reader.Open("./record_store.bin"), true);
+  ASSERT_EQ(record_reader.IsRecovered(), false);
+  ASSERT_EQ(record_reader.GetRecordNumber(), flat_structs.size() + 1);
+  // Any order.
+  for (std::size_t index : {57, 3, 99, 0, 57}) {
+    Variable flat_struct_deserialize = record_reader.ReadRecord(index);
+    ASSERT_EQ(flat_structs[index], *static_cast<FlatStruct*>(flat_struct_deserialize.GetValue()));
+    free(flat_struct_deserialize.GetValue());
+  }
+  std::vector<std::uint8_t> record_data{};
+  ASSERT_EQ(record_reader.ReadRecordData(flat_structs.size(), record_data), true);
+  ASSERT_EQ(std::string(record_data.begin(), record_data.end()), "raw");
+  ASSERT_EQ(record_reader.ReadRecord(flat_structs.size() + 1).IsValid(), false);
+  std::size_t next_index = 10;
+  ASSERT_EQ(record_reader.ReadRecords(10, 20, [&flat_structs, &next_index](std::uint64_t index, Variable& variable) {
+    EXPECT_EQ(index, next_index++);
+    EXPECT_EQ(flat_structs[index], *static_cast<FlatStruct*>(variable.GetValue()));
+    free(variable.GetValue());
+    return true;
+  }), 10);
+
+  // A damaged record is refused, the others can still be read.
+  DataBuffer damaged_buffer{};
+  damaged_buffer.AddData(data_buffer.GetData(), data_buffer.GetAddDataOffset());
+  static_cast<std::uint8_t*>(damaged_buffer.GetData())[sizeof(RecordStoreHeader) + sizeof(RecordHeader) + 8] ^= 0xFF;
+  ASSERT_EQ(record_reader.Open(std::move(damaged_buffer)), true);
+  ASSERT_EQ(record_reader.ReadRecord(0).IsValid(), false);
+  Variable flat_struct_deserialize = record_reader.ReadRecord(1);
+  ASSERT_EQ(flat_structs[1], *static_cast<FlatStruct*>(flat_struct_deserialize.GetValue()));
+  free(flat_struct_deserialize.GetValue());
+
+  // An object cut short is not read on into the next record.
+  RecursionSubClass1 sparse_object{};
+  sparse_object.property1_ = 42;
+  Variable sparse_object_refrence = Variable::CreateVariable(sparse_object);
+  DataBuffer cut_object_buffer{};
+  SerializeDelta(cut_object_buffer, sparse_object_refrence);
+  DataBuffer cut_store_buffer{};
+  RecordWriter cut_record_writer{cut_store_buffer};
+  ASSERT_EQ(cut_record_writer.AddRecordData(cut_object_buffer.GetData(), cut_object_buffer.GetAddDataOffset() - 1), true);
+  ASSERT_EQ(cut_record_writer.AddRecord(sparse_object_refrence), true);
+  cut_record_writer.Finish();
+  ASSERT_EQ(record_reader.Open(std::move(cut_store_buffer)), true);
+  ASSERT_EQ(record_reader.ReadRecord(0).IsValid(), false);
+
+  // Without the footer, and with the last record cut, the index is rebuilt
+  // from the length prefixes.
+  DataBuffer unfinished_buffer = DataBuffer::CreateSegmented(64);
+  unfinished_buffer.AddData(data_buffer.GetData(), unfinished_size - 1);
+  ASSERT_EQ(record_reader.Open(std::move(unfinished_buffer)), true);
+  ASSERT_EQ(record_reader.IsRecovered(), true);
+  ASSERT_EQ(record_reader.GetRecordNumber(), flat_structs.size());
+  Variable last_flat_struct_deserialize = record_reader.ReadRecord(flat_structs.size() - 1);
+  ASSERT_EQ(flat_structs.back(), *static_cast<FlatStruct*>(last_flat_struct_deserialize.GetValue()));
+  free(last_flat_struct_deserialize.GetValue());
+}
+
+TEST(reflection, data_buffer_reader) {
+  std::vector<FlatStruct> flat_structs(64);
+  DataBuffer data_buffer{};
+  for (std::size_t index = 0; index != flat_structs.size(); ++index) {
+    flat_structs[index] = FlatStruct{static_cast<std::int8_t>(index), static_cast<int>(index) * 7, index * 1.5, index * 0.5f};
+    Variable flat_variable = Variable::CreateVariable(flat_structs[index]);
+    Serialize(data_buffer, flat_variable);
+  }
+  TrivialStruct trivial_struct{};
+  RandomBit(reinterpret_cast<char*>(&trivial_struct), sizeof(TrivialStruct));
+  Variable trivial_variable = Variable::CreateVariable(trivial_struct);
+  SerializeWithSchema(data_buffer, trivial_variable);
+  RecursionSubClass1 sparse_object{};
+  sparse_object.property1_ = 42;
+  Variable sparse_object_refrence = Variable::CreateVariable(sparse_object);
+  SerializeDelta(data_buffer, sparse_object_refrence);
+  const std::uint64_t schema_offset = data_buffer.GetAddDataOffset();
+  SchemaWriter schema_writer{};
+  ASSERT_EQ(schema_writer.AddObject(trivial_variable), true);
+  ASSERT_EQ(schema_writer.AddObject(trivial_variable), true);
+  schema_writer.Finish(data_buffer);
+
+  // Each thread reads all objects with a reader of its own.
+  std::vector<std::vector<FlatStruct>> thread_results(4);
+  std::vector<std::thread> threads{};
+  for (std::vector<FlatStruct>& thread_result : thread_results) {
+    threads.emplace_back([&data_buffer, &thread_result, count = flat_structs.size()]() {
+      DataBufferReader reader{data_buffer};
+      for (std::size_t index = 0; index != count; ++index) {
+        Variable flat_variable = Deserialize(reader);
+        if (!flat_variable.IsValid()) {
+          return;
+        }
+        thread_result.push_back(*static_cast<FlatStruct*>(flat_variable.GetValue()));
+        free(flat_variable.GetValue());
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (const std::vector<FlatStruct>& thread_result : thread_results) {
+    ASSERT_EQ(thread_result, flat_structs);
+  }
+  ASSERT_EQ(data_buffer.GetReadDataOffset(), 0);
+
+  // A copy of a reader peeks without moving the original.
+  DataBufferReader reader{data_buffer.GetData(), data_buffer.GetAddDataOffset()};
+  DataBufferReader peek_reader{reader};
+  Variable flat_variable_peek = Deserialize(peek_reader);
+  ASSERT_EQ(flat_structs[0], *static_cast<FlatStruct*>(flat_variable_peek.GetValue()));
+  free(flat_variable_peek.GetValue());
+  ASSERT_EQ(reader.GetReadDataOffset(), 0);
+  ASSERT_EQ(reader.SetReadDataOffset(peek_reader.GetReadDataOffset() * flat_structs.size()), true);
+  ASSERT_EQ(reader.SetReadDataOffset(data_buffer.GetAddDataOffset() + 1), false);
+
+  Variable trivial_variable_schema = Deserialize(reader);
+  ASSERT_EQ(trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_schema.GetValue()));
+  free(trivial_variable_schema.GetValue());
+  Variable sparse_object_delta = DeserializeDelta(reader);
+  ASSERT_EQ(sparse_object, *static_cast<RecursionSubClass1*>(sparse_object_delta.GetValue()));
+  free(sparse_object_delta.GetValue());
+  ASSERT_EQ(reader.GetReadDataOffset(), schema_offset);
+
+  // The schema reader moves the reader with each object it reads.
+  SchemaReader schema_reader{reader};
+  ASSERT_EQ(schema_reader.IsValid(), true);
+  ASSERT_EQ(schema_reader.GetObjectNumber(), 2);
+  Variable trivial_variable_read = schema_reader.ReadObject();
+  ASSERT_EQ(trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_read.GetValue()));
+  free(trivial_variable_read.GetValue());
+  ASSERT_LT(reader.GetReadDataOffset(), reader.GetSize());
+  Variable trivial_variable_read_last = schema_reader.ReadObject();
+  ASSERT_EQ(trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_read_last.GetValue()));
+  free(trivial_variable_read_last.GetValue());
+  ASSERT_EQ(reader.GetReadDataOffset(), reader.GetSize());
+  ASSERT_EQ(data_buffer.GetReadDataOffset(), 0);
+
+  // Only contiguous buffers can be read.
+  DataBuffer segmented_buffer = DataBuffer::CreateSegmented();
+  DataBufferReader segmented_reader{segmented_buffer};
+  ASSERT_EQ(segmented_reader.GetSize(), 0);
+}
+
+TEST(reflection, serialize_stream) {
+  RecursionClass recursion_class{};
+  recursion_class.RandomData();
+  Variable recursion_class_refrence = Variable::CreateVariable(recursion_class);
+  TrivialStruct test_trivial_struct{};
+  RandomBit(reinterpret_cast<char*>(&test_trivial_struct), sizeof(TrivialStruct));
+  Variable trivial_variable_refrence = Variable::CreateVariable(test_trivial_struct);
+
+  DataBuffer data_buffer{};
+  std::ostringstream output_stream{};
+  {
+    // A buffer smaller than the objects.
+    DataBuffer write_stream = DataBuffer::CreateWriteStream(std::make_unique<OStreamSink>(output_stream), 64);
+    ASSERT_EQ(write_stream.IsStream(), true);
+    for (int i = 0; i != 3; ++i) {
+      Serialize(write_stream, trivial_variable_refrence);
+      Serialize(write_stream, recursion_class_refrence);
+      Serialize(data_buffer, trivial_variable_refrence);
+      Serialize(data_buffer, recursion_class_refrence);
+    }
+    ASSERT_EQ(write_stream.GetAddDataOffset(), data_buffer.GetAddDataOffset());
+    ASSERT_LE(write_stream.GetCapacity(), data_buffer.GetAddDataOffset() / 3);
+    ASSERT_EQ(write_stream.Flush(), true);
+  }
+  const std::string data{static_cast<const char*>(data_buffer.GetData()), data_buffer.GetAddDataOffset()};
+  ASSERT_EQ(output_stream.str(), data);
+
+  // Feed the data in small parts.
+  std::uint64_t source_offset = 0;
+  DataBuffer read_stream = DataBuffer::CreateReadStream(std::make_unique<CallbackSource>([&data, &source_offset](void* data_to, std::uint64_t size) {
+    const std::uint64_t read_size = std::min<std::uint64_t>({size, 7, data.size() - source_offset});
+    memcpy(data_to, data.data() + source_offset, read_size);
+    source_offset += read_size;
+    return read_size;
+  }), 64);
+  for (int i = 0; i != 3; ++i) {
+    Variable trivial_variable_deserialize = Deserialize(read_stream);
+    ASSERT_EQ(test_trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_deserialize.GetValue()));
+    free(trivial_variable_deserialize.GetValue());
+    Variable recursion_class_deserialize = Deserialize(read_stream);
+    ASSERT_EQ(recursion_class, *static_cast<RecursionClass*>(recursion_class_deserialize.GetValue()));
+    free(recursion_class_deserialize.GetValue());
+  }
+  ASSERT_EQ(read_stream.CanReadData(1), false);
+  ASSERT_EQ(read_stream.GetReadDataOffset(), data.size());
+
+  std::istringstream input_stream{data};
+  DataBuffer istream_stream = DataBuffer::CreateReadStream(std::make_unique<IStreamSource>(input_stream));
+  Variable trivial_variable_deserialize = Deserialize(istream_stream);
+  ASSERT_EQ(test_trivial_struct, *static_cast<TrivialStruct*>(trivial_variable_deserialize.GetValue()));
+  free(trivial_variable_deserialize.GetValue());
+
+  // Write errors are reported by Flush.
+  DataBuffer failed_stream = DataBuffer::CreateWriteStream(std::make_unique<CallbackSink>([](const void*, std::uint64_t) { return false; }));
+  Serialize(failed_stream, trivial_variable_refrence);
+  ASSERT_EQ(failed_stream.Flush(), false);
+}
@@ -45,7 +45,7 @@ TEST(reflection, type) {
   EXPECT_EQ(enum_type1.IsPointer(), false);
   // EXPECT_EQ(enum_type1.GetTypeName(), std::string(""));
   const Meta* enum_meta1 = enum_type1.GetMeta();
-  EXPECT_EQ(enum_meta1, GetMetaDatabase().at(typeid(TypeTestEnum).hash_code()));
+  EXPECT_EQ(enum_meta1, GetMetaDatabase().at(MM::Utils::GetTypeHashCode<TypeTestEnum>()));
 
   const Type& enum_type2 = Type::CreateType<const TypeTestEnum>();
   EXPECT_EQ(enum_type2.IsValid(), true);
@@ -140,3 +140,75 @@ TEST(reflection, type) {
   type_name = &Type::CreateType<const std::uint32_t[3]>();
   EXPECT_EQ(type_name->GetTypeName(), "const std::uint32_t[3]");
 }
+
+TEST(reflection, type_hash_code) {
+  static_assert(MM::Utils::TypeHashCodeV<int> == MM::Utils::GetTypeHashCode<const int&>());
+  static_assert(MM::Utils::TypeHashCodeV<int> != MM::Utils::TypeHashCodeV<int*>);
+  static_assert(MM::Utils::TypeHashCodeV<TypeTestEnum> != MM::Utils::TypeHashCodeV<int>);
+  static_assert(MM::Utils::HashString("TypeTestEnum") == MM::Utils::HashString(std::string_view{"TypeTestEnum"}));
+
+  // Usable as case labels.
+  auto get_type_index = [](TypeHashCode type_hash_code) {
+    switch (type_hash_code) {
+      case MM::Utils::TypeHashCodeV<int>:
+        return 1;
+      case MM::Utils::TypeHashCodeV<TypeTestEnum>:
+        return 2;
+      default:
+        return 0;
+    }
+  };
+  EXPECT_EQ(get_type_index(Type::CreateType<const int&>().GetTypeHashCode()), 1);
+  EXPECT_EQ(get_type_index(Type::CreateType<TypeTestEnum>().GetTypeHashCode()), 2);
+  EXPECT_EQ(get_type_index(Type::CreateType<float>().GetTypeHashCode()), 0);
+
+  EXPECT_EQ(MM::Utils::GetCompilerTypeName<TypeTestEnum>(), "TypeTestEnum");
+  EXPECT_EQ(Type::CreateType<int*>().GetOriginalTypeHashCode(), MM::Utils::TypeHashCodeV<int>);
+
+  const TypeHashCode* type_hash_code = FindTypeHashCodeByNameHash(MM::Utils::HashString("TypeTestEnum"));
+  EXPECT_NE(type_hash_code, nullptr);
+  EXPECT_EQ(*type_hash_code, MM::Utils::TypeHashCodeV<TypeTestEnum>);
+
+  // Two lambdas that are spelled the same do not share one type.
+  auto first_lambda = [](int value) { return value; };
+  auto second_lambda = [](int value) { return value + 1; };
+  const Type& first_lambda_type = Type::CreateType<decltype(first_lambda)>();
+  EXPECT_EQ(first_lambda_type.IsSameCppType(Type::CreateType<decltype(first_lambda)>()), true);
+  if (MM::Utils::TypeHashCodeV<decltype(first_lambda)> == MM::Utils::TypeHashCodeV<decltype(second_lambda)>) {
+    EXPECT_DEATH(Type::CreateType<decltype(second_lambda)>(), "has the same hash code as another type");
+  } else {
+    EXPECT_EQ(first_lambda_type.IsSameCppType(Type::CreateType<decltype(second_lambda)>()), false);
+  }
+}
+
+TEST(reflection, type_flags) {
+  const Type& int_type = Type::CreateType<int>();
+  EXPECT_EQ(int_type.GetFlags() & Type::IS_TRIVIAL, Type::IS_TRIVIAL);
+  EXPECT_EQ(int_type.GetSize(), sizeof(int));
+  EXPECT_EQ(int_type.GetAlignment(), alignof(int));
+  EXPECT_EQ(&int_type.GetOrignalType(), &int_type);
+
+  const Type& const_refrence_type = Type::CreateType<const std::string&>();
+  EXPECT_EQ(const_refrence_type.IsReference(), true);
+  EXPECT_EQ(const_refrence_type.IsConst(), true);
+  EXPECT_EQ(const_refrence_type.IsTrivial(), false);
+  EXPECT_EQ(const_refrence_type.GetAlignment(), alignof(std::string));
+  EXPECT_EQ(&const_refrence_type.GetOrignalType(), &Type::CreateType<std::string>());
+  EXPECT_EQ(&Type::CreateType<int*>().GetOrignalType(), &int_type);
+
+  const Type& enum_type = Type::CreateType<TypeTestEnum>();
+  EXPECT_EQ(enum_type.IsEnum(), true);
+  EXPECT_EQ(enum_type.GetFlags() & Type::IS_POINTER, 0);
+
+  const Type& void_type = Type::CreateType<void>();
+  EXPECT_EQ(void_type.IsVoid(), true);
+  EXPECT_EQ(void_type.GetSize(), 0);
+  EXPECT_EQ(&void_type.GetOrignalType(), &void_type);
+
+  // Queries on an invalid type return the default values.
+  const Type invalid_type{};
+  EXPECT_EQ(invalid_type.GetFlags(), 0);
+  EXPECT_EQ(invalid_type.IsEnum(), false);
+  EXPECT_EQ(invalid_type.GetTypeHashCode(), 0);
+  EXPECT_EQ(&invalid_type.GetOrignalType(), &invalid_type);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <cstring>
+
 #include "reflection.h"
 
 using namespace MM::Reflection;
@@ -60,7 +62,7 @@ MM_REGISTER {
 }
 
 TEST(reflection, variable) {
-  const Meta* variable_test_meta = GetMetaDatabase().at(typeid(VariableTestClass).hash_code());
+  const Meta* variable_test_meta = GetMetaDatabase().at(MM::Utils::GetTypeHashCode<VariableTestClass>());
   EXPECT_NE(variable_test_meta, nullptr);
 
   std::vector<const Constructor*> constructors = variable_test_meta->GetAllConstructor();
@@ -126,6 +128,8 @@ TEST(reflection, variable) {
   EXPECT_EQ(property3_variable.GetValueCast<std::string>(), std::string{"string"});
   EXPECT_EQ(property4_variable.GetValueCast<float>(), 40.0f);
   EXPECT_EQ(property5_variable.GetValueCast<float>(), 50.0f);
+  EXPECT_EQ(&variable_test_meta->GetProperty("property4_")->MakeAccessor<float>().Get(new_variable), &g_property4_refrence);
+  EXPECT_EQ(&variable_test_meta->GetProperty("property5_")->MakeAccessor<float&>().Get(new_variable), &g_property5_refrence);
   property1_variable = Variable::CreateVariable<int>(20);
   property2_variable = Variable::CreateVariable<float>(10.0f);
   property3_variable = Variable::CreateVariable<std::string>(std::string{"string2"});
@@ -150,3 +154,224 @@ TEST(reflection, variable) {
   EXPECT_EQ(property5_variable.GetValue(), &g_property5_refrence);
 }
 
+
+TEST(reflection, variable_name_id) {
+  const NameId init_name{"Init"};
+  const NameId property1_name{"property1_"};
+  const NameId property5_name{"property5_"};
+  const NameId get_property1_name{"GetProperty1"};
+  const NameId set_property2_name{"SetProperty2"};
+  const NameId invalid_name{"invalid_name"};
+
+  EXPECT_EQ(property1_name, NameId{std::string{"property1_"}});
+  EXPECT_NE(property1_name, property5_name);
+  EXPECT_EQ(property1_name.GetName(), "property1_");
+  EXPECT_EQ(NameId{}.IsValid(), false);
+  EXPECT_EQ(NameId{}.GetName(), "");
+  EXPECT_EQ(NameId::Find("property1_"), property1_name);
+  EXPECT_EQ(NameId::Find("never_interned_name").IsValid(), false);
+
+  const Meta* variable_test_meta = Type::CreateType<VariableTestClass>().GetMeta();
+  ASSERT_NE(variable_test_meta, nullptr);
+  EXPECT_EQ(variable_test_meta->GetConstructor(init_name), variable_test_meta->GetConstructor("Init"));
+  EXPECT_EQ(variable_test_meta->GetProperty(property1_name), variable_test_meta->GetProperty("property1_"));
+  EXPECT_EQ(variable_test_meta->GetMethod(get_property1_name), variable_test_meta->GetMethod("GetProperty1"));
+  EXPECT_EQ(variable_test_meta->GetConstructor(invalid_name), nullptr);
+  EXPECT_EQ(variable_test_meta->GetProperty(invalid_name), nullptr);
+  EXPECT_EQ(variable_test_meta->GetMethod(invalid_name), nullptr);
+
+  Variable constructor_arg1 = Variable::EmplaceVariable<int>(20), constructor_arg2 = Variable::EmplaceVariable<float>(10.0f);
+  Variable new_variable = variable_test_meta->GetConstructor(init_name)->Invoke(constructor_arg1, constructor_arg2);
+  ASSERT_EQ(new_variable.IsValid(), true);
+
+  EXPECT_EQ(new_variable.GetPropertyVariable(property1_name).GetValueCast<int>(), 20);
+  // property5_ refers to a global that other tests change.
+  EXPECT_EQ(new_variable.GetPropertyVariable(property5_name).GetValue(), &g_property5_refrence);
+  EXPECT_EQ(new_variable.GetPropertyVariable(invalid_name).IsValid(), false);
+  EXPECT_EQ(new_variable.Invoke(get_property1_name).GetValueCast<int>(), 20);
+  Variable new_float_variable = Variable::EmplaceVariable<float>(30.0f);
+  EXPECT_EQ(new_variable.Invoke(set_property2_name, new_float_variable).IsVoid(), true);
+  EXPECT_EQ(static_cast<VariableTestClass*>(new_variable.GetValue())->property2_, 30.0f);
+  EXPECT_EQ(new_variable.Invoke(invalid_name).IsValid(), false);
+
+  // Members registered later are indexed as well.
+  Class<VariableTestClass>{"VariableTestClass"}
+    .Method("GetProperty2Late", &VariableTestClass::GetProperty2);
+  EXPECT_EQ(new_variable.Invoke(NameId{"GetProperty2Late"}).GetValueCast<float>(), 30.0f);
+}
+
+struct VariableArenaTestClass {
+  static int destroy_count_;
+
+  VariableArenaTestClass() = default;
+  explicit VariableArenaTestClass(std::uint64_t value) { values_.fill(value); }
+  VariableArenaTestClass(const VariableArenaTestClass& other) = default;
+  VariableArenaTestClass(VariableArenaTestClass&& other) noexcept = default;
+  ~VariableArenaTestClass() { ++destroy_count_; }
+
+  std::array<std::uint64_t, 16> values_{};
+};
+
+int VariableArenaTestClass::destroy_count_{0};
+
+TEST(reflection, variable_arena) {
+  EXPECT_EQ(VariableArena::GetCurrentArena(), nullptr);
+
+  VariableArena arena{256};
+  for (std::uint64_t align : {1, 2, 8, 16, 64}) {
+    void* address = arena.Allocate(3, align);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(address) % align, 0);
+  }
+  void* large_address = arena.Allocate(1024, 8);
+  EXPECT_NE(large_address, nullptr);
+  EXPECT_GE(arena.GetCapacity(), 1024 + 256);
+  arena.Reset();
+  EXPECT_EQ(arena.GetUsedSize(), 0);
+  const std::size_t capacity = arena.GetCapacity();
+
+  VariableArenaTestClass::destroy_count_ = 0;
+  {
+    VariableArenaScope arena_scope{arena};
+    EXPECT_EQ(VariableArena::GetCurrentArena(), &arena);
+
+    Variable variable = Variable::EmplaceVariable<VariableArenaTestClass>(std::uint64_t{7});
+    const std::size_t used_size = arena.GetUsedSize();
+    EXPECT_GE(used_size, sizeof(VariableArenaTestClass));
+    EXPECT_EQ(variable.GetValueCast<VariableArenaTestClass>().values_[15], 7);
+
+    Variable copy_variable{variable};
+    EXPECT_GT(arena.GetUsedSize(), used_size);
+    EXPECT_EQ(copy_variable.GetValueCast<VariableArenaTestClass>().values_[0], 7);
+    Variable move_variable{std::move(copy_variable)};
+    EXPECT_EQ(move_variable.GetValueCast<VariableArenaTestClass>().values_[0], 7);
+
+    VariableArena nested_arena{};
+    {
+      VariableArenaScope nested_scope{nested_arena};
+      Variable nested_variable = Variable::CreateVariable(VariableArenaTestClass{3});
+      EXPECT_GT(nested_arena.GetUsedSize(), 0);
+    }
+    EXPECT_EQ(VariableArena::GetCurrentArena(), &arena);
+
+    // Small values never touch the arena.
+    const std::size_t before_int = arena.GetUsedSize();
+    Variable int_variable = Variable::CreateVariable(10);
+    EXPECT_EQ(arena.GetUsedSize(), before_int);
+  }
+  EXPECT_EQ(VariableArena::GetCurrentArena(), nullptr);
+  // Destructors still run for values held in the arena.
+  EXPECT_GE(VariableArenaTestClass::destroy_count_, 4);
+
+  const std::size_t used_size = arena.GetUsedSize();
+  Variable heap_variable = Variable::EmplaceVariable<VariableArenaTestClass>();
+  EXPECT_EQ(arena.GetUsedSize(), used_size);
+
+  arena.Reset();
+  EXPECT_EQ(arena.GetUsedSize(), 0);
+  EXPECT_EQ(arena.GetCapacity(), capacity);
+}
+
+struct VariableMoveTestClass {
+  static int copy_count_;
+  static int move_count_;
+
+  VariableMoveTestClass() = default;
+  VariableMoveTestClass(const VariableMoveTestClass& other) : values_(other.values_) { ++copy_count_; }
+  VariableMoveTestClass(VariableMoveTestClass&& other) noexcept : values_(other.values_) { ++move_count_; }
+  ~VariableMoveTestClass() = default;
+
+  std::array<std::uint64_t, 16> values_{};
+};
+
+int VariableMoveTestClass::copy_count_{0};
+int VariableMoveTestClass::move_count_{0};
+
+TEST(reflection, variable_move) {
+  // Every wrapper that a Variable allocates comes from the current arena, so
+  // the used size of the arena counts the allocations.
+  VariableArena counting_arena{};
+
+  // Heap values are moved by taking over the wrapper.
+  Variable heap_variable = Variable::EmplaceVariable<VariableMoveTestClass>();
+  static_cast<VariableMoveTestClass*>(heap_variable.GetValue())->values_[3] = 3;
+  const void* heap_value = heap_variable.GetValue();
+  Variable second_heap_variable = Variable::EmplaceVariable<VariableMoveTestClass>();
+  VariableMoveTestClass::copy_count_ = 0;
+  VariableMoveTestClass::move_count_ = 0;
+  std::vector<Variable> variables{};
+  variables.reserve(4);
+  {
+    VariableArenaScope counting_scope{counting_arena};
+    Variable moved_heap_variable{std::move(heap_variable)};
+    EXPECT_EQ(heap_variable.IsValid(), false);
+    EXPECT_EQ(moved_heap_variable.GetValue(), heap_value);
+    EXPECT_EQ(moved_heap_variable.GetValueCast<VariableMoveTestClass>().values_[3], 3);
+
+    variables.emplace_back(std::move(moved_heap_variable));
+    variables.emplace_back(std::move(second_heap_variable));
+    Variable assigned_variable{};
+    assigned_variable = std::move(variables[0]);
+    EXPECT_EQ(assigned_variable.GetValue(), heap_value);
+    EXPECT_EQ(counting_arena.GetUsedSize(), 0);
+    EXPECT_EQ(VariableMoveTestClass::copy_count_, 0);
+    EXPECT_EQ(VariableMoveTestClass::move_count_, 0);
+
+    // Copying allocates exactly one wrapper.
+    Variable copy_heap_variable{assigned_variable};
+    EXPECT_NE(counting_arena.GetUsedSize(), 0);
+    EXPECT_EQ(VariableMoveTestClass::copy_count_, 1);
+  }
+  VariableMoveTestClass::copy_count_ = 0;
+  VariableMoveTestClass::move_count_ = 0;
+
+  // Values in an arena are moved to new storage, so they outlive the arena.
+  VariableArena arena{};
+  Variable moved_arena_variable{};
+  {
+    VariableArenaScope arena_scope{arena};
+    Variable arena_variable = Variable::EmplaceVariable<VariableMoveTestClass>();
+    static_cast<VariableMoveTestClass*>(arena_variable.GetValue())->values_[5] = 5;
+    const std::size_t used_size = arena.GetUsedSize();
+    Variable copy_arena_variable{arena_variable};
+    EXPECT_EQ(arena.GetUsedSize(), used_size * 2);
+    EXPECT_EQ(VariableMoveTestClass::copy_count_, 1);
+
+    const void* arena_value = arena_variable.GetValue();
+    Variable assigned_arena_variable{};
+    assigned_arena_variable = std::move(arena_variable);
+    EXPECT_EQ(arena_variable.IsValid(), false);
+    EXPECT_NE(assigned_arena_variable.GetValue(), arena_value);
+    EXPECT_EQ(arena.GetUsedSize(), used_size * 3);
+    EXPECT_NE(VariableMoveTestClass::move_count_, 0);
+    EXPECT_EQ(VariableMoveTestClass::copy_count_, 1);
+
+    // Without a current arena the value moves to the heap.
+    VariableArenaScope no_arena_scope{};
+    moved_arena_variable = std::move(assigned_arena_variable);
+    EXPECT_EQ(arena.GetUsedSize(), used_size * 3);
+    EXPECT_EQ(VariableMoveTestClass::copy_count_, 1);
+  }
+  arena.Reset();
+  std::memset(arena.Allocate(sizeof(VariableMoveTestClass) * 4, alignof(VariableMoveTestClass)), 0xFF,
+              sizeof(VariableMoveTestClass) * 4);
+  EXPECT_EQ(moved_arena_variable.GetValueCast<VariableMoveTestClass>().values_[5], 5);
+
+  // Trivially copyable inline values are copied bytewise.
+  Variable int_variable = Variable::CreateVariable(std::uint64_t{42});
+  Variable moved_int_variable{std::move(int_variable)};
+  EXPECT_EQ(moved_int_variable.GetValueCast<std::uint64_t>(), 42);
+  Variable copy_int_variable{moved_int_variable};
+  EXPECT_EQ(copy_int_variable.GetValueCast<std::uint64_t>(), 42);
+  EXPECT_NE(copy_int_variable.GetValue(), moved_int_variable.GetValue());
+
+  std::uint64_t refrence_value{7};
+  Variable refrence_variable = Variable::CreateVariable(refrence_value);
+  Variable moved_refrence_variable{std::move(refrence_variable)};
+  EXPECT_EQ(moved_refrence_variable.IsRefrenceVariable(), true);
+  EXPECT_EQ(moved_refrence_variable.GetValue(), &refrence_value);
+
+  // Other inline values still use their move constructor.
+  Variable unique_variable = Variable::EmplaceVariable<std::unique_ptr<int>>(new int{5});
+  Variable moved_unique_variable{std::move(unique_variable)};
+  EXPECT_EQ(*moved_unique_variable.GetValueCast<std::unique_ptr<int>>(), 5);
+}